@@ -191,6 +191,9 @@ namespace PHEMlightdllV5 {
         _FleetMix.insert(std::make_pair(Constants::strDiesel, 0));
         _FleetMix.insert(std::make_pair(Constants::strCNG, 0));
         _FleetMix.insert(std::make_pair(Constants::strLPG, 0));
+
+        _powerPatternFCvaluesIndex.build(_powerPatternFCvalues);
+        _powerPatternPollutantsIndex.build(_powerPatternPollutants);
     }
 
     const bool& CEP::getHeavyVehicle() const {
@@ -295,61 +298,72 @@ namespace PHEMlightdllV5 {
 
     double CEP::GetEmission(const std::string& pollutant, double power, double speed, Helpers* VehicleClass) {
         //Declaration
-        std::vector<double> emissionCurve;
-        std::vector<double> powerPattern;
+        const std::vector<double>* emissionCurve = nullptr;
+        const std::vector<double>* powerPattern = nullptr;
+        const PHEMPatternIndex* patternIndex = nullptr;
 
         // bisection search to find correct position in power pattern	
         int upperIndex;
         int lowerIndex;
 
-        if (std::abs(speed) <= Constants::ZERO_SPEED_ACCURACY) {
-            if (_cepCurvePollutants.find(pollutant) == _cepCurvePollutants.end() && _cepCurveFCvalues.find(pollutant) == _cepCurveFCvalues.end()) {
-                VehicleClass->setErrMsg(std::string("Emission pollutant or fuel value ") + pollutant + std::string(" not found!"));
-                return 0;
-            }
+        std::map<std::string, std::vector<double> >::const_iterator fcIt = _cepCurveFCvalues.find(pollutant);
+        std::map<std::string, std::vector<double> >::const_iterator pollutantIt = _cepCurvePollutants.find(pollutant);
+        if (pollutantIt == _cepCurvePollutants.end() && fcIt == _cepCurveFCvalues.end()) {
+            VehicleClass->setErrMsg(std::string("Emission pollutant or fuel value ") + pollutant + std::string(" not found!"));
+            return 0;
+        }
 
-            if (_cepCurveFCvalues.find(pollutant) != _cepCurveFCvalues.end()) {
+        if (std::abs(speed) <= Constants::ZERO_SPEED_ACCURACY) {
+            if (fcIt != _cepCurveFCvalues.end()) {
                 return _idlingValueFCvalues[pollutant];
             }
-            else if (_cepCurvePollutants.find(pollutant) != _cepCurvePollutants.end()) {
+            else {
                 return _idlingValuesPollutants[pollutant];
             }
         }
 
-        if (_cepCurvePollutants.find(pollutant) == _cepCurvePollutants.end() && _cepCurveFCvalues.find(pollutant) == _cepCurveFCvalues.end()) {
-            VehicleClass->setErrMsg(std::string("Emission pollutant or fuel value ") + pollutant + std::string(" not found!"));
-            return 0;
+        if (fcIt != _cepCurveFCvalues.end()) {
+            emissionCurve = &fcIt->second;
+            powerPattern = &_powerPatternFCvalues;
+            patternIndex = &_powerPatternFCvaluesIndex;
         }
-
-        if (_cepCurveFCvalues.find(pollutant) != _cepCurveFCvalues.end()) {
-            emissionCurve = _cepCurveFCvalues[pollutant];
-            powerPattern = _powerPatternFCvalues;
-        }
-        else if (_cepCurvePollutants.find(pollutant) != _cepCurvePollutants.end()) {
-            emissionCurve = _cepCurvePollutants[pollutant];
-            powerPattern = _powerPatternPollutants;
+        else {
+            emissionCurve = &pollutantIt->second;
+            powerPattern = &_powerPatternPollutants;
+            patternIndex = &_powerPatternPollutantsIndex;
         }
 
-        if (emissionCurve.empty()) {
+        if (emissionCurve->empty()) {
             VehicleClass->setErrMsg(std::string("Empty emission curve for ") + pollutant + std::string(" found!"));
             return 0;
         }
-        if (emissionCurve.size() == 1) {
-            return emissionCurve[0];
+        if (emissionCurve->size() == 1) {
+            return (*emissionCurve)[0];
         }
 
         // in case that the demanded power is smaller than the first entry (smallest) in the power pattern the first is returned (should never happen)
-        if (power <= powerPattern.front()) {
-            return emissionCurve[0];
+        if (power <= powerPattern->front()) {
+            return (*emissionCurve)[0];
         }
 
         // if power bigger than all entries in power pattern return the last (should never happen)
-        if (power >= powerPattern.back()) {
-            return emissionCurve.back();
+        if (power >= powerPattern->back()) {
+            return emissionCurve->back();
         }
 
-        FindLowerUpperInPattern(lowerIndex, upperIndex, powerPattern, power);
-        return Interpolate(power, powerPattern[lowerIndex], powerPattern[upperIndex], emissionCurve[lowerIndex], emissionCurve[upperIndex]);
+        if (patternIndex->isValid()) {
+            lowerIndex = patternIndex->findSegment(*powerPattern, power);
+            // exact hits are left to the bisection which decides between equal pattern entries
+            if ((*powerPattern)[lowerIndex] != power) {
+                return Interpolate(power, (*powerPattern)[lowerIndex], (*powerPattern)[lowerIndex + 1], (*emissionCurve)[lowerIndex], (*emissionCurve)[lowerIndex + 1]);
+            }
+        }
+        FindLowerUpperInPattern(lowerIndex, upperIndex, *powerPattern, power);
+        return Interpolate(power, (*powerPattern)[lowerIndex], (*powerPattern)[upperIndex], (*emissionCurve)[lowerIndex], (*emissionCurve)[upperIndex]);
+    }
+
+    int CEP::getPatternIndexMemory() const {
+        return _powerPatternFCvaluesIndex.getMemory() + _powerPatternPollutantsIndex.getMemory();
     }
 
     double CEP::GetCO2Emission(double _FC, double _CO, double _HC, Helpers* VehicleClass) {
@@ -493,7 +507,7 @@ namespace PHEMlightdllV5 {
         return Interpolate(speed, _speedPatternRotational[lowerIndex], _speedPatternRotational[upperIndex], _speedCurveRotational[lowerIndex], _speedCurveRotational[upperIndex]);
     }
 
-    void CEP::FindLowerUpperInPattern(int& lowerIndex, int& upperIndex, std::vector<double>& pattern, double value) {
+    void CEP::FindLowerUpperInPattern(int& lowerIndex, int& upperIndex, const std::vector<double>& pattern, double value) {
         lowerIndex = 0;
         upperIndex = 0;
 
@@ -29,6 +29,7 @@
 #include <cmath>
 #include <utility>
 #include "CEPHandler.h"
+#include <utils/emissions/PHEMPatternIndex.h>
 
 //C# TO C++ CONVERTER NOTE: Forward class declarations:
 namespace PHEMlightdllV5 { class VEHPHEMLightJSON; }
@@ -119,6 +120,10 @@ namespace PHEMlightdllV5 {
         std::vector<double> _nNormTable;
         std::vector<double> _dragNormTable;
 
+        // grids for finding the segments of the power patterns in constant time (shared with PHEMlight)
+        PHEMPatternIndex _powerPatternFCvaluesIndex;
+        PHEMPatternIndex _powerPatternPollutantsIndex;
+
     public:
         double CalcPower(double speed, double acc, double gradient, bool HBEV);
 
@@ -130,6 +135,9 @@ namespace PHEMlightdllV5 {
 
         double GetCO2Emission(double _FC, double _CO, double _HC, Helpers* VehicleClass);
 
+        // the memory used by the power pattern grids in bytes
+        int getPatternIndexMemory() const;
+
         //Calculate the weighted fuel factor values for Fleetmix
     private:
         bool CalcfCValMix(double& _fCBr, double& _fCHC, double& _fCCO, double& _fCCO2, Helpers* VehicleClass);
@@ -144,7 +152,7 @@ namespace PHEMlightdllV5 {
 
 
     private:
-        void FindLowerUpperInPattern(int& lowerIndex, int& upperIndex, std::vector<double>& pattern, double value);
+        void FindLowerUpperInPattern(int& lowerIndex, int& upperIndex, const std::vector<double>& pattern, double value);
 
         double Interpolate(double px, double p1, double p2, double e1, double e2);
 
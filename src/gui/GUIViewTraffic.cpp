@@ -87,6 +87,9 @@ GUIViewTraffic::GUIViewTraffic(
 
 GUIViewTraffic::~GUIViewTraffic() {
     endSnapshot();
+    if (MSNet::hasInstance()) {
+        GUINet::getGUIInstance()->removeVehicleSnapshotView(this);
+    }
 }
 
 
@@ -382,7 +385,12 @@ GUIViewTraffic::doPaintGL(int mode, const Boundary& bound) {
     glEnable(GL_POLYGON_OFFSET_FILL);
     glEnable(GL_POLYGON_OFFSET_LINE);
     const SUMORTree& grid = GUINet::getGUIInstance()->getVisualisationSpeedUp(myVisualizationSettings->secondaryShape);
+    if (mode == GL_RENDER) {
+        // if all vehicles are small, the whole frame draws them from the last completed step without blocking the simulation
+        GUINet::getGUIInstance()->beginVehicleSnapshotFrame(this, *myVisualizationSettings, bound);
+    }
     int hits2 = grid.Search(minB, maxB, *myVisualizationSettings);
+    GUINet::getGUIInstance()->endVehicleSnapshotFrame();
     GUIGlobals::gSecondaryShape = myVisualizationSettings->secondaryShape;
     // Draw additional objects
     if (myAdditionallyDrawn.size() > 0) {
@@ -65,6 +65,12 @@
 
 //#define DRAW_BOUNDING_BOX
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const double GUIBaseVehicle::POINT_LOD_PIXELS(3.);
+
+
 // ===========================================================================
 // FOX callback mapping
 // ===========================================================================
@@ -657,6 +663,80 @@ GUIBaseVehicle::drawGL(const GUIVisualizationSettings& s) const {
 }
 
 
+bool
+GUIBaseVehicle::drawAsPoint(const GUIVisualizationSettings& s) const {
+    if (s.drawForPositionSelection || s.drawForRectangleSelection) {
+        // selection needs the name of each vehicle
+        return false;
+    }
+    return s.scale * getDrawingSize(s) < POINT_LOD_PIXELS && !hasDrawingDetails(s);
+}
+
+
+double
+GUIBaseVehicle::getDrawingSize(const GUIVisualizationSettings& s, bool ignoreSelection) const {
+    // without the selection, settings with constant sizes or selection based scaling must be excluded by the caller
+    const double exaggeration = (ignoreSelection
+                                 ? s.vehicleSize.exaggeration * s.vehicleScaler.getScheme().getColor(getScaleValue(s, s.vehicleScaler.getActive()))
+                                 : getExaggeration(s));
+    return exaggeration * MAX2(getVType().getLength(), getVType().getWidth());
+}
+
+
+bool
+GUIBaseVehicle::hasDrawingDetails(const GUIVisualizationSettings& s, bool ignoreSelection) const {
+    auto show = [&](const GUIVisualizationTextSettings & text) {
+        return ignoreSelection ? text.showText : text.show(this);
+    };
+    return (s.drawMinGap || s.drawBrakeGap || s.showBTRange
+            || show(s.vehicleName) || show(s.vehicleValue) || show(s.vehicleScaleValue) || show(s.vehicleText)
+            || getNumPassengers() > 0 || getNumContainers() > 0);
+}
+
+
+void
+GUIBaseVehicle::PointBatch::add(const GUIBaseVehicle& veh, const GUIVisualizationSettings& s) {
+    const RGBColor col = veh.getDrawColor(s);
+    if (col.alpha() == 0) {
+        return;
+    }
+    const double angle = veh.getVisualAngle(s.secondaryShape);
+    const Position front = veh.getVisualPosition(s.secondaryShape);
+    const double halfLength = veh.getVType().getLength() / 2;
+    myCoords.push_back(front.x() - cos(angle) * halfLength);
+    myCoords.push_back(front.y() - sin(angle) * halfLength);
+    myCoords.push_back(veh.getType());
+    myColors.push_back(col.red());
+    myColors.push_back(col.green());
+    myColors.push_back(col.blue());
+    myColors.push_back(col.alpha());
+}
+
+
+void
+GUIBaseVehicle::PointBatch::draw() const {
+    if (myCoords.empty()) {
+        return;
+    }
+    glPointSize((GLfloat)POINT_LOD_PIXELS);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_DOUBLE, 0, myCoords.data());
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, myColors.data());
+    glDrawArrays(GL_POINTS, 0, (GLsizei)(myCoords.size() / 3));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glPointSize(1);
+}
+
+
+void
+GUIBaseVehicle::PointBatch::clear() {
+    myCoords.clear();
+    myColors.clear();
+}
+
+
 void
 GUIBaseVehicle::drawGLAdditional(GUISUMOAbstractView* const parent, const GUIVisualizationSettings& s) const {
     if (!myVehicle.isOnRoad()) {
@@ -705,12 +785,19 @@ GUIBaseVehicle::drawLinkItem(const Position& pos, SUMOTime arrivalTime, SUMOTime
 
 
 RGBColor
-GUIBaseVehicle::setColor(const GUIVisualizationSettings& s) const {
+GUIBaseVehicle::getDrawColor(const GUIVisualizationSettings& s) const {
     RGBColor col;
     const GUIColorer& c = s.vehicleColorer;
     if (!setFunctionalColor(c.getActive(), &myVehicle, col)) {
         col = c.getScheme().getColor(getColorValue(s, c.getActive()));
     }
+    return col;
+}
+
+
+RGBColor
+GUIBaseVehicle::setColor(const GUIVisualizationSettings& s) const {
+    const RGBColor col = getDrawColor(s);
     GLHelper::setColor(col);
     return col;
 }
@@ -204,6 +204,53 @@ public:
     void drawGL(const GUIVisualizationSettings& s) const;
 
 
+    /** @brief Returns whether the vehicle covers so few pixels that it is drawn as a single point
+     *
+     * Vehicles showing labels, gaps or transported persons and containers are always drawn completely.
+     * @param[in] s The settings for the current view
+     */
+    bool drawAsPoint(const GUIVisualizationSettings& s) const;
+
+    /** @brief Returns the exaggerated length or width of the vehicle (whichever is larger)
+     * @param[in] s The settings for the current view
+     * @param[in] ignoreSelection Whether the vehicle shall be treated as unselected (without accessing the selection)
+     */
+    double getDrawingSize(const GUIVisualizationSettings& s, bool ignoreSelection = false) const;
+
+    /** @brief Returns whether labels, gaps or transported persons and containers are drawn for the vehicle
+     * @param[in] s The settings for the current view
+     * @param[in] ignoreSelection Whether labels shown only for selected objects count as drawn (without accessing the selection)
+     */
+    bool hasDrawingDetails(const GUIVisualizationSettings& s, bool ignoreSelection = false) const;
+
+    /// @brief vehicles whose drawing size is below this number of pixels are drawn as points
+    static const double POINT_LOD_PIXELS;
+
+
+    /**
+     * @class PointBatch
+     * @brief Collects the vehicles which are drawn as points and draws them with a single call
+     */
+    class PointBatch {
+    public:
+        /// @brief adds the center of the vehicle with its current color
+        void add(const GUIBaseVehicle& veh, const GUIVisualizationSettings& s);
+
+        /// @brief draws all collected vehicles
+        void draw() const;
+
+        /// @brief removes all vehicles from the batch
+        void clear();
+
+    private:
+        /// @brief the coordinates (x, y, z) of the points
+        std::vector<double> myCoords;
+
+        /// @brief the colors (rgba) of the points
+        std::vector<unsigned char> myColors;
+    };
+
+
     /** @brief Draws additionally triggered visualisations
      * @param[in] parent The view
      * @param[in] s The settings for the current view (may influence drawing)
@@ -363,6 +410,9 @@ public:
 
 protected:
 
+    /// @brief returns the color according to the current settings
+    RGBColor getDrawColor(const GUIVisualizationSettings& s) const;
+
     /// @brief sets the color according to the current settings
     RGBColor setColor(const GUIVisualizationSettings& s) const;
 
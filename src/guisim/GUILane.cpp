@@ -218,6 +218,13 @@ GUILane::detectCollisions(SUMOTime timestep, const std::string& stage) {
 }
 
 
+void
+GUILane::findCollisions(SUMOTime timestep, const std::string& stage, std::vector<Collision>& into) {
+    FXMutexLock locker(myLock);
+    MSLane::findCollisions(timestep, stage, into);
+}
+
+
 double
 GUILane::setPartialOccupation(MSVehicle* v) {
     FXMutexLock locker(myLock);
@@ -649,7 +656,7 @@ GUILane::drawGL(const GUIVisualizationSettings& s) const {
                 // compute lane-marking intersection points)
                 double halfWidth = isInternal ? myQuarterLaneWidth : (myHalfLaneWidth - SUMO_const_laneMarkWidth / 2);
                 mustDrawMarkings = !isInternal && myPermissions != 0 && myPermissions != SVC_PEDESTRIAN && exaggeration == 1.0 && !isWaterway(myPermissions);
-                const int cornerDetail = drawDetails && !isInternal ? (int)(s.scale * exaggeration) : 0;
+                const int cornerDetail = drawDetails && !isInternal ? GLVertexArray::roundDetail((int)(s.scale * exaggeration)) : 0;
                 double offset = halfWidth * MAX2(0., (exaggeration - 1)) * (MSGlobals::gLefthand ? -1 : 1);
                 if (spreadSuperposed) {
                     offset += halfWidth * 0.5 * (MSGlobals::gLefthand ? -1 : 1);
@@ -658,7 +665,10 @@ GUILane::drawGL(const GUIVisualizationSettings& s) const {
                 if (shapeColors.size() > 0) {
                     GLHelper::drawBoxLines(baseShape, getShapeRotations(s2), getShapeLengths(s2), shapeColors, halfWidth * exaggeration, cornerDetail, offset);
                 } else {
-                    GLHelper::drawBoxLines(baseShape, getShapeRotations(s2), getShapeLengths(s2), halfWidth * exaggeration, cornerDetail, offset);
+                    if (myBodyVertices.needsRebuild(s2, halfWidth * exaggeration, cornerDetail, offset)) {
+                        myBodyVertices.addBoxLines(baseShape, getShapeRotations(s2), getShapeLengths(s2), halfWidth * exaggeration, cornerDetail, offset);
+                    }
+                    myBodyVertices.draw();
                 }
             }
 #ifdef GUILane_DEBUG_DRAW_FOE_INTERSECTIONS
@@ -754,24 +764,77 @@ GUILane::drawGL(const GUIVisualizationSettings& s) const {
         GLHelper::popMatrix();
     }
     // draw vehicles
-    if (s.scale * s.vehicleSize.getExaggeration(s, nullptr) > s.vehicleSize.minSize) {
+    const GUIVehicleSnapshot* const snapshot = GUINet::getGUIInstance()->getFrameVehicleSnapshot();
+    const GUIVehicleSnapshot::LaneVehicles* const snapshotVehicles = snapshot == nullptr ? nullptr : snapshot->getVehicles(*this);
+    if (snapshotVehicles != nullptr) {
+        // draw the vehicles of the last completed step without blocking the simulation
+        if (s.scale * s.vehicleSize.getExaggeration(s, nullptr) > s.vehicleSize.minSize) {
+            snapshotVehicles->points.draw();
+        }
+    } else if (s.scale * s.vehicleSize.getExaggeration(s, nullptr) > s.vehicleSize.minSize) {
         // retrieve vehicles from lane; disallow simulation
         const MSLane::VehCont& vehicles = getVehiclesSecure();
+        // vehicles covering only a few pixels are collected and drawn with a single call
+        static GUIBaseVehicle::PointBatch pointBatch;
         for (MSLane::VehCont::const_iterator v = vehicles.begin(); v != vehicles.end(); ++v) {
             if ((*v)->getLane() == this) {
-                static_cast<const GUIVehicle*>(*v)->drawGL(s);
+                const GUIVehicle* const veh = static_cast<const GUIVehicle*>(*v);
+                if (veh->drawAsPoint(s)) {
+                    pointBatch.add(*veh, s);
+                } else {
+                    veh->drawGL(s);
+                }
             } // else: this is the shadow during a continuous lane change
         }
         // draw parking vehicles
         for (const MSBaseVehicle* const v : myParkingVehicles) {
-            dynamic_cast<const GUIBaseVehicle*>(v)->drawGL(s);
+            const GUIBaseVehicle* const veh = dynamic_cast<const GUIBaseVehicle*>(v);
+            if (veh->drawAsPoint(s)) {
+                pointBatch.add(*veh, s);
+            } else {
+                veh->drawGL(s);
+            }
         }
+        pointBatch.draw();
+        pointBatch.clear();
         // allow lane simulation
         releaseVehicles();
     }
     GLHelper::popName();
 }
 
+
+bool
+GUILane::fillVehicleSnapshot(const GUIVisualizationSettings& s, GUIVehicleSnapshot::LaneVehicles& into, double& maxSize) const {
+    auto add = [&](const GUIBaseVehicle * const veh) {
+        // the selection belongs to the GUI thread
+        if (veh->hasDrawingDetails(s, true)) {
+            return false;
+        }
+        maxSize = MAX2(maxSize, veh->getDrawingSize(s, true));
+        into.points.add(*veh, s);
+        return true;
+    };
+    bool complete = true;
+    // the snapshot is built without locking the net
+    const MSLane::VehCont& vehicles = getVehiclesSecure();
+    for (const MSVehicle* const veh : vehicles) {
+        if (veh->getLane() == this && !add(static_cast<const GUIVehicle*>(veh))) {
+            complete = false;
+            break;
+        }
+    }
+    for (const MSBaseVehicle* const veh : myParkingVehicles) {
+        if (!complete || !add(dynamic_cast<const GUIBaseVehicle*>(veh))) {
+            complete = false;
+            break;
+        }
+    }
+    releaseVehicles();
+    return complete;
+}
+
+
 bool
 GUILane::neighLaneNotBidi() const {
     const MSLane* right = getParallelLane(-1, false);
@@ -795,15 +858,17 @@ GUILane::drawMarkings(const GUIVisualizationSettings& s, double scale) const {
     if (myIndex > 0 && (myEdge->getLanes()[myIndex - 1]->getPermissions() & myPermissions) != 0) {
         const bool cl = myEdge->getLanes()[myIndex - 1]->allowsChangingLeft(SVC_PASSENGER);
         const bool cr = allowsChangingRight(SVC_PASSENGER);
-        GLHelper::drawInverseMarkings(getShape(s2), getShapeRotations(s2), getShapeLengths(s2), 3, 6, myHalfLaneWidth, cl, cr, MSGlobals::gLefthand, scale);
+        if (myInverseMarkingVertices.needsRebuild(s2, cl, cr, MSGlobals::gLefthand, scale)) {
+            myInverseMarkingVertices.addInverseMarkings(getShape(s2), getShapeRotations(s2), getShapeLengths(s2), 3, 6, myHalfLaneWidth, cl, cr, MSGlobals::gLefthand, scale);
+        }
+        myInverseMarkingVertices.draw();
     }
     // draw white boundings and white markings
     glColor3d(1, 1, 1);
-    GLHelper::drawBoxLines(
-        getShape(s2),
-        getShapeRotations(s2),
-        getShapeLengths(s2),
-        (myHalfLaneWidth + SUMO_const_laneMarkWidth) * scale);
+    if (myMarkingVertices.needsRebuild(s2, scale)) {
+        myMarkingVertices.addBoxLines(getShape(s2), getShapeRotations(s2), getShapeLengths(s2), (myHalfLaneWidth + SUMO_const_laneMarkWidth) * scale);
+    }
+    myMarkingVertices.draw();
     GLHelper::popMatrix();
 }
 
@@ -29,8 +29,10 @@
 #include <microsim/MSEdge.h>
 #include <utils/geom/Position.h>
 #include <utils/geom/PositionVector.h>
+#include <utils/gui/div/GLVertexArray.h>
 #include <utils/gui/globjects/GUIGlObject.h>
 #include <utils/gui/settings/GUIPropertySchemeStorage.h>
+#include "GUIVehicleSnapshot.h"
 
 
 // ===========================================================================
@@ -148,6 +150,7 @@ public:
     /** the same as in MSLane, but locks the access for the visualisation
         first; the access will be granted at the end of this method */
     void detectCollisions(SUMOTime timestep, const std::string& stage) override;
+    void findCollisions(SUMOTime timestep, const std::string& stage, std::vector<Collision>& into) override;
 
 
     /** the same as in MSLane, but locks the access for the visualisation
@@ -208,6 +211,14 @@ public:
     double getClickPriority() const override;
     //@}
 
+    /** @brief Adds the current drawing state of the vehicles on this lane to a snapshot
+     * @param[in] s The copy of the settings to compute the colors with
+     * @param[in, out] maxSize The largest drawing size of the vehicles added so far
+     * @return Whether all vehicles could be added (none of them shows drawing details)
+     * @note called by the simulation thread at the end of a step (does not access the selection)
+     */
+    bool fillVehicleSnapshot(const GUIVisualizationSettings& s, GUIVehicleSnapshot::LaneVehicles& into, double& maxSize) const;
+
     const PositionVector& getShape(bool secondary) const override;
     const std::vector<double>& getShapeRotations(bool secondary) const;
     const std::vector<double>& getShapeLengths(bool secondary) const;
@@ -378,6 +389,15 @@ private:
     /// @brief An object that stores the tesselation
     mutable TesselatedPolygon* myTesselation;
 
+    /// @brief cached geometry of the lane body
+    mutable GLVertexArray myBodyVertices;
+
+    /// @brief cached geometry of the inverse lane markings
+    mutable GLVertexArray myInverseMarkingVertices;
+
+    /// @brief cached geometry of the white lane markings
+    mutable GLVertexArray myMarkingVertices;
+
 #ifdef HAVE_OSG
     osg::Geometry* myGeom;
 #endif
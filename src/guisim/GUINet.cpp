@@ -39,6 +39,7 @@
 #include <utils/common/RGBColor.h>
 #include <utils/iodevices/OutputDevice.h>
 #include <utils/gui/div/GLObjectValuePassConnector.h>
+#include <utils/gui/settings/GUIVisualizationSettings.h>
 #include <microsim/MSNet.h>
 #include <microsim/MSEdgeWeightsStorage.h>
 #include <microsim/MSJunction.h>
@@ -59,6 +60,7 @@
 #include <guisim/GUITrafficLightLogicWrapper.h>
 #include <guisim/GUIJunctionWrapper.h>
 #include <guisim/GUIVehicleControl.h>
+#include <guisim/GUIVehicleSnapshot.h>
 #include <gui/GUIGlobals.h>
 #include <gui/GUIApplicationWindow.h>
 #include "GUINet.h"
@@ -230,8 +232,93 @@ GUINet::guiSimulationStep() {
 
 void
 GUINet::simulationStep() {
-    FXMutexLock locker(myLock);
-    MSNet::simulationStep();
+    {
+        FXMutexLock locker(myLock);
+        MSNet::simulationStep();
+    }
+    // the snapshots only lock one lane at a time so the GUI thread may draw meanwhile
+    buildVehicleSnapshots();
+}
+
+
+void
+GUINet::buildVehicleSnapshots() {
+    std::map<const GUISUMOAbstractView*, VehicleSnapshotRequest> requests;
+    myVehicleSnapshotLock.lock();
+    requests.swap(myVehicleSnapshotRequests);
+    myVehicleSnapshotLock.unlock();
+    if (requests.empty()) {
+        return;
+    }
+    std::vector<std::shared_ptr<const GUIVehicleSnapshot> > snapshots;
+    for (const auto& item : requests) {
+        snapshots.push_back(std::make_shared<const GUIVehicleSnapshot>(*item.second.settings, item.second.area, myEdgeWrapper, myEdgeBoundaries));
+    }
+    FXMutexLock locker(myVehicleSnapshotLock);
+    auto snapshot = snapshots.begin();
+    for (auto& item : requests) {
+        if (myVehicleSnapshotViews.count(item.first) > 0) {
+            myLatestVehicleSnapshots[item.first] = *snapshot;
+        }
+        mySpareVehicleSnapshotSettings.push_back(std::move(item.second.settings));
+        ++snapshot;
+    }
+}
+
+
+void
+GUINet::beginVehicleSnapshotFrame(const GUISUMOAbstractView* view, const GUIVisualizationSettings& s, const Boundary& visible) {
+    const bool applicable = GUIVehicleSnapshot::isApplicable(s);
+    FXMutexLock locker(myVehicleSnapshotLock);
+    myFrameVehicleSnapshot = nullptr;
+    auto it = myLatestVehicleSnapshots.find(view);
+    if (it != myLatestVehicleSnapshots.end()) {
+        if (applicable && it->second->isUsable(s, visible)) {
+            myFrameVehicleSnapshot = it->second;
+        }
+        // each snapshot is drawn only once since the settings may change while the simulation does not advance
+        myLatestVehicleSnapshots.erase(it);
+    }
+    auto request = myVehicleSnapshotRequests.find(view);
+    if (applicable) {
+        myVehicleSnapshotViews.insert(view);
+        if (request == myVehicleSnapshotRequests.end()) {
+            request = myVehicleSnapshotRequests.insert(std::make_pair(view, VehicleSnapshotRequest())).first;
+            if (mySpareVehicleSnapshotSettings.empty()) {
+                request->second.settings.reset(new GUIVisualizationSettings("vehicle snapshot"));
+            } else {
+                request->second.settings = std::move(mySpareVehicleSnapshotSettings.back());
+                mySpareVehicleSnapshotSettings.pop_back();
+            }
+        }
+        // the simulation thread must not read the settings of the view while they are edited
+        GUIVehicleSnapshot::copySettings(s, *request->second.settings);
+        // the view may move a little until the snapshot is drawn
+        request->second.area = visible;
+        request->second.area.grow(0.25 * MAX2(visible.getWidth(), visible.getHeight()));
+    } else if (request != myVehicleSnapshotRequests.end()) {
+        mySpareVehicleSnapshotSettings.push_back(std::move(request->second.settings));
+        myVehicleSnapshotRequests.erase(request);
+    }
+}
+
+
+void
+GUINet::endVehicleSnapshotFrame() {
+    myFrameVehicleSnapshot = nullptr;
+}
+
+
+void
+GUINet::removeVehicleSnapshotView(const GUISUMOAbstractView* view) {
+    FXMutexLock locker(myVehicleSnapshotLock);
+    myVehicleSnapshotViews.erase(view);
+    myLatestVehicleSnapshots.erase(view);
+    auto request = myVehicleSnapshotRequests.find(view);
+    if (request != myVehicleSnapshotRequests.end()) {
+        mySpareVehicleSnapshotSettings.push_back(std::move(request->second.settings));
+        myVehicleSnapshotRequests.erase(request);
+    }
 }
 
 
@@ -321,6 +408,7 @@ GUINet::initGUIStructures() {
         const float cmin[2] = { (float)b.xmin(), (float)b.ymin() };
         const float cmax[2] = { (float)b.xmax(), (float)b.ymax() };
         myGrid.Insert(cmin, cmax, edge);
+        myEdgeBoundaries.push_back(b);
         myBoundary.add(b);
         if (myBoundary.getWidth() > 10e16 || myBoundary.getHeight() > 10e16) {
             throw ProcessError(TL("Network size exceeds 1 Lightyear. Please reconsider your inputs.\n"));
@@ -22,8 +22,12 @@
 #pragma once
 #include <config.h>
 
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 #include <microsim/MSNet.h>
 #include <microsim/devices/MSDevice_Tripinfo.h>
 #include <utils/geom/Boundary.h>
@@ -58,6 +62,8 @@ class GUIVehicle;
 class GUIVehicleControl;
 class MSVehicleControl;
 class GUIMEVehicleControl;
+class GUIVehicleSnapshot;
+class GUISUMOAbstractView;
 class Command;
 
 
@@ -339,6 +345,32 @@ public:
     /// @brief release exclusive access to the simulation state
     void unlock();
 
+    /// @name vehicle snapshots for drawing without blocking the simulation
+    /// @{
+
+    /** @brief Starts drawing a frame of the given view
+     *
+     * Takes the latest snapshot of the view (if it was not drawn before and covers the visible area)
+     *  and requests a new one to be built at the end of the next simulation step. The settings
+     *  needed for building it are copied.
+     * @param[in] view The view drawing the frame
+     * @param[in] s The settings of the view
+     * @param[in] visible The area drawn by the frame
+     */
+    void beginVehicleSnapshotFrame(const GUISUMOAbstractView* view, const GUIVisualizationSettings& s, const Boundary& visible);
+
+    /// @brief Finishes drawing a frame and releases its snapshot
+    void endVehicleSnapshotFrame();
+
+    /// @brief Discards the snapshots of a view which is closed
+    void removeVehicleSnapshotView(const GUISUMOAbstractView* view);
+
+    /// @brief Returns the snapshot of the frame being drawn (nullptr if there is none)
+    const GUIVehicleSnapshot* getFrameVehicleSnapshot() const {
+        return myFrameVehicleSnapshot.get();
+    }
+    /// @}
+
     /** @brief Returns the pointer to the unique instance of GUINet (singleton).
      * @return Pointer to the unique GUINet-instance
      * @exception ProcessError If a network was not yet constructed
@@ -459,4 +491,36 @@ private:
     /// The mutex used to avoid concurrent updates of the vehicle buffer
     mutable FXMutex myLock;
 
+    /// @brief builds the requested vehicle snapshots (called by the simulation thread after a step)
+    void buildVehicleSnapshots();
+
+    /// @brief the request of a view for a vehicle snapshot
+    struct VehicleSnapshotRequest {
+        /// @brief the copy of the settings of the view
+        std::unique_ptr<GUIVisualizationSettings> settings;
+        /// @brief the area to build the snapshot for
+        Boundary area;
+    };
+
+    /// @brief the views drawing with vehicle snapshots (not dereferenced by the simulation thread)
+    std::set<const GUISUMOAbstractView*> myVehicleSnapshotViews;
+
+    /// @brief the snapshots requested by the views for the next simulation step
+    std::map<const GUISUMOAbstractView*, VehicleSnapshotRequest> myVehicleSnapshotRequests;
+
+    /// @brief the latest snapshot of each view which was not drawn yet
+    std::map<const GUISUMOAbstractView*, std::shared_ptr<const GUIVehicleSnapshot> > myLatestVehicleSnapshots;
+
+    /// @brief the snapshot used by the frame which is currently drawn
+    std::shared_ptr<const GUIVehicleSnapshot> myFrameVehicleSnapshot;
+
+    /// @brief the settings copies which are currently unused (they are expensive to construct)
+    std::vector<std::unique_ptr<GUIVisualizationSettings> > mySpareVehicleSnapshotSettings;
+
+    /// @brief the boundaries of the edges within the visualization tree (by position in myEdgeWrapper)
+    std::vector<Boundary> myEdgeBoundaries;
+
+    /// @brief the mutex guarding the exchange of snapshots
+    FXMutex myVehicleSnapshotLock;
+
 };
@@ -0,0 +1,105 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    GUIVehicleSnapshot.cpp
+/// @author  agent
+/// @date    2026-10-17
+///
+// The drawing state of the vehicles at the end of a simulation step
+/****************************************************************************/
+#include <config.h>
+
+#include <microsim/MSGlobals.h>
+#include <utils/gui/div/GUIGlobalSelection.h>
+#include <utils/gui/settings/GUIVisualizationSettings.h>
+#include "GUIEdge.h"
+#include "GUILane.h"
+#include "GUIVehicleSnapshot.h"
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+GUIVehicleSnapshot::GUIVehicleSnapshot(const GUIVisualizationSettings& s, const Boundary& area,
+                                       const std::vector<GUIEdge*>& edges, const std::vector<Boundary>& edgeBoundaries) :
+    myArea(area),
+    myLanes(MSLane::dictSize()),
+    myMaxSize(0),
+    myComplete(true) {
+    for (int i = 0; i < (int)edges.size(); i++) {
+        const Boundary& b = edgeBoundaries[i];
+        // all edges found by searching the visualization tree with the area (with some tolerance for rounding)
+        if (b.xmin() > area.xmax() + 1 || b.xmax() < area.xmin() - 1 || b.ymin() > area.ymax() + 1 || b.ymax() < area.ymin() - 1) {
+            continue;
+        }
+        for (const MSLane* const lane : edges[i]->getLanes()) {
+            LaneVehicles& vehicles = myLanes[lane->getNumericalID()];
+            vehicles.contained = true;
+            if (!static_cast<const GUILane*>(lane)->fillVehicleSnapshot(s, vehicles, myMaxSize)) {
+                // the frame has to be drawn from the simulation state
+                myComplete = false;
+                myLanes.clear();
+                return;
+            }
+        }
+    }
+}
+
+
+bool
+GUIVehicleSnapshot::isApplicable(const GUIVisualizationSettings& s) {
+    if (MSGlobals::gUseMesoSim || s.drawForPositionSelection || s.drawForRectangleSelection
+            // the area is only known for the primary shapes
+            || s.secondaryShape
+            // the exaggeration of constant size vehicles depends on the zoom
+            || s.vehicleSize.constantSize || s.vehicleSize.constantSizeSelected
+            || s.vehicleColorer.getScheme().getName() == GUIVisualizationSettings::SCHEME_NAME_SELECTION
+            || s.vehicleScaler.getScheme().getName() == GUIVisualizationSettings::SCHEME_NAME_SELECTION) {
+        return false;
+    }
+    // selected vehicles are enlarged
+    return s.selectorFrameScale == 1 || gSelected.getSelected(GLO_VEHICLE).empty();
+}
+
+
+void
+GUIVehicleSnapshot::copySettings(const GUIVisualizationSettings& s, GUIVisualizationSettings& into) {
+    into.vehicleColorer = s.vehicleColorer;
+    into.vehicleScaler = s.vehicleScaler;
+    into.vehicleParam = s.vehicleParam;
+    into.vehicleScaleParam = s.vehicleScaleParam;
+    into.vehicleSize = s.vehicleSize;
+    into.vehicleName = s.vehicleName;
+    into.vehicleValue = s.vehicleValue;
+    into.vehicleScaleValue = s.vehicleScaleValue;
+    into.vehicleText = s.vehicleText;
+    into.drawMinGap = s.drawMinGap;
+    into.drawBrakeGap = s.drawBrakeGap;
+    into.showBTRange = s.showBTRange;
+    into.secondaryShape = s.secondaryShape;
+}
+
+
+bool
+GUIVehicleSnapshot::isUsable(const GUIVisualizationSettings& s, const Boundary& visible) const {
+    return (myComplete && s.scale * myMaxSize < GUIBaseVehicle::POINT_LOD_PIXELS
+            && visible.xmin() >= myArea.xmin() && visible.xmax() <= myArea.xmax()
+            && visible.ymin() >= myArea.ymin() && visible.ymax() <= myArea.ymax());
+}
+
+
+const GUIVehicleSnapshot::LaneVehicles*
+GUIVehicleSnapshot::getVehicles(const GUILane& lane) const {
+    const LaneVehicles& vehicles = myLanes[lane.getNumericalID()];
+    return vehicles.contained ? &vehicles : nullptr;
+}
@@ -0,0 +1,107 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    GUIVehicleSnapshot.h
+/// @author  agent
+/// @date    2026-10-17
+///
+// The drawing state of the vehicles at the end of a simulation step
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <vector>
+#include <utils/geom/Boundary.h>
+#include "GUIBaseVehicle.h"
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class GUIEdge;
+class GUILane;
+class GUIVisualizationSettings;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class GUIVehicleSnapshot
+ * @brief The drawing state of the vehicles around the visible area of a view at the end of a simulation step
+ *
+ * The snapshot is built by the simulation thread after the step (using a copy of the vehicle
+ *  settings of the view which requested it) and is not modified afterwards. A frame either draws
+ *  the vehicles of all lanes from the snapshot without locking the lanes, so drawing does not block
+ *  the simulation of the next step, or draws all of them from the simulation state as before.
+ *  The snapshot is only used if all vehicles in its area are small enough to be drawn as points.
+ */
+class GUIVehicleSnapshot {
+public:
+    /// @brief the vehicles of a single lane
+    struct LaneVehicles {
+        /// @brief the vehicles drawn as points
+        GUIBaseVehicle::PointBatch points;
+        /// @brief whether the lane lies within the area of the snapshot
+        bool contained = false;
+    };
+
+    /** @brief Constructor (builds the snapshot of the edges overlapping the given area)
+     * @param[in] s The copy of the settings to compute the colors with
+     * @param[in] area The area the snapshot is built for
+     * @param[in] edges All edges of the network
+     * @param[in] edgeBoundaries The boundaries of the edges within the visualization tree
+     */
+    GUIVehicleSnapshot(const GUIVisualizationSettings& s, const Boundary& area,
+                       const std::vector<GUIEdge*>& edges, const std::vector<Boundary>& edgeBoundaries);
+
+    /** @brief Returns whether snapshots can be built for the given settings
+     *
+     * Snapshots are not used if the drawing of vehicles depends on the selection
+     *  since the selection must not be accessed by the simulation thread.
+     * @note called by the GUI thread
+     */
+    static bool isApplicable(const GUIVisualizationSettings& s);
+
+    /// @brief Copies the settings needed for building a snapshot
+    static void copySettings(const GUIVisualizationSettings& s, GUIVisualizationSettings& into);
+
+    /** @brief Returns whether all vehicles of a frame can be drawn from the snapshot
+     * @param[in] s The settings of the frame
+     * @param[in] visible The area drawn by the frame
+     */
+    bool isUsable(const GUIVisualizationSettings& s, const Boundary& visible) const;
+
+    /// @brief Returns the vehicles of the lane (nullptr if the lane lies outside the area of the snapshot)
+    const LaneVehicles* getVehicles(const GUILane& lane) const;
+
+private:
+    /// @brief the area the snapshot was built for
+    const Boundary myArea;
+
+    /// @brief the vehicles of each lane (by numerical id)
+    std::vector<LaneVehicles> myLanes;
+
+    /// @brief the largest drawing size of the vehicles
+    double myMaxSize;
+
+    /// @brief whether all vehicles in the area are contained (none of them shows drawing details)
+    bool myComplete;
+
+private:
+    /// @brief Invalidated copy constructor.
+    GUIVehicleSnapshot(const GUIVehicleSnapshot&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    GUIVehicleSnapshot& operator=(const GUIVehicleSnapshot&) = delete;
+};
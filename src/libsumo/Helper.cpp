@@ -29,6 +29,7 @@
 #include <microsim/MSEdgeControl.h>
 #include <microsim/MSInsertionControl.h>
 #include <microsim/MSEdge.h>
+#include <microsim/MSGlobals.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSLink.h>
 #include <microsim/MSStoppingPlace.h>
@@ -85,6 +86,12 @@ std::map<int, std::shared_ptr<VariableWrapper> > Helper::myWrapper;
 Helper::VehicleStateListener Helper::myVehicleStateListener;
 Helper::TransportableStateListener Helper::myTransportableStateListener;
 LANE_RTREE_QUAL* Helper::myLaneTree;
+bool Helper::myUseTrafficObjectIndex = false;
+bool Helper::myHaveTrafficObjectIndex = false;
+NamedGrid* Helper::myVehicleGrid = nullptr;
+NamedGrid* Helper::myPersonGrid = nullptr;
+std::unordered_map<const Named*, Helper::IndexedObject> Helper::myIndexedObjects;
+std::map<SumoXMLTag, std::pair<int, NamedRTree*> > Helper::myStoppingPlaceTrees;
 std::map<std::string, MSVehicle*> Helper::myRemoteControlledVehicles;
 std::map<std::string, MSPerson*> Helper::myRemoteControlledPersons;
 
@@ -166,14 +173,138 @@ Helper::handleSubscriptions(const SUMOTime t) {
         }
         ++i;
     }
-    for (const libsumo::Subscription& s : mySubscriptions) {
-        if (s.beginTime <= t) {
-            handleSingleSubscription(s);
+    TrafficObjectIndexScope indexScope(countTrafficObjectQueries(mySubscriptions, t));
+    std::vector<ContextObjects> contexts;
+    evaluateContextObjects(mySubscriptions, t, contexts);
+    for (int i = 0; i < (int)mySubscriptions.size(); i++) {
+        if (mySubscriptions[i].beginTime <= t) {
+            handleSingleSubscription(mySubscriptions[i], contexts.empty() ? nullptr : &contexts[i]);
         }
     }
 }
 
 
+bool
+Helper::allowsConcurrentContextEvaluation(const Subscription& s) {
+    if (s.contextDomain <= 0) {
+        return false;
+    }
+    if (s.activeFilters == 0) {
+        return true;
+    }
+    // filters which may emit warnings (the message handling is not thread safe) are evaluated serially
+    if (!s.isVehicleToVehicleContextSubscription() || (s.activeFilters & SUBS_FILTER_LATERAL_DIST) != 0) {
+        return false;
+    }
+    if ((s.activeFilters & SUBS_FILTER_NOOPPOSITE) != 0 && (s.activeFilters & SUBS_FILTER_NO_RTREE) == 0) {
+        return false;
+    }
+    if ((s.activeFilters & SUBS_FILTER_FIELD_OF_VISION) != 0
+            && (s.filterFieldOfVisionOpeningAngle <= 0. || s.filterFieldOfVisionOpeningAngle >= 360.)) {
+        return false;
+    }
+    return true;
+}
+
+
+void
+Helper::evaluateContextObjects(const std::vector<Subscription>& subscriptions, const SUMOTime t, std::vector<ContextObjects>& into) {
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads <= 1) {
+        return;
+    }
+    std::vector<int> concurrent;
+    for (int i = 0; i < (int)subscriptions.size(); i++) {
+        if (subscriptions[i].beginTime <= t && allowsConcurrentContextEvaluation(subscriptions[i])) {
+            concurrent.push_back(i);
+        }
+    }
+    if (concurrent.size() < 2) {
+        return;
+    }
+    into.resize(subscriptions.size());
+    // the shapes and the lazily built lookup trees are prepared serially
+    std::set<int> preparedDomains;
+    for (const int i : concurrent) {
+        const Subscription& s = subscriptions[i];
+        ContextObjects& c = into[i];
+        c.evaluated = true;
+        if ((s.activeFilters & SUBS_FILTER_NO_RTREE) == 0) {
+            try {
+                findObjectShape(s.commandId, s.id, c.shape);
+                if (preparedDomains.insert(s.contextDomain).second) {
+                    std::set<const Named*> ignored;
+                    collectObjectsInRange(s.contextDomain, c.shape, 0., ignored);
+                }
+            } catch (TraCIException& e) {
+                c.error = e.what();
+            }
+        }
+    }
+    MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+    const int numChunks = MIN2((int)concurrent.size(), 4 * threadPool.size());
+    for (int i = 0; i < numChunks; i++) {
+        threadPool.add(new ContextTask(subscriptions, concurrent.cbegin() + i * concurrent.size() / numChunks,
+                                       concurrent.cbegin() + (i + 1) * concurrent.size() / numChunks, into), i % threadPool.size());
+    }
+    threadPool.waitAll();
+    return;
+#endif
+#endif
+    UNUSED_PARAMETER(subscriptions);
+    UNUSED_PARAMETER(t);
+    UNUSED_PARAMETER(into);
+}
+
+
+void
+Helper::evaluateContextObjects(const std::vector<Subscription>& subscriptions, std::vector<int>::const_iterator begin,
+                               std::vector<int>::const_iterator end, std::vector<ContextObjects>& into) {
+    for (auto it = begin; it != end; ++it) {
+        const Subscription& s = subscriptions[*it];
+        ContextObjects& c = into[*it];
+        if (!c.error.empty()) {
+            continue;
+        }
+        try {
+            if ((s.activeFilters & SUBS_FILTER_NO_RTREE) == 0) {
+                collectObjectIDsInRange(s.contextDomain, c.shape, s.range, c.objIDs);
+            }
+            applySubscriptionFilters(s, c.objIDs);
+        } catch (TraCIException& e) {
+            c.error = e.what();
+        }
+    }
+}
+
+
+#ifdef HAVE_FOX
+void
+Helper::ContextTask::run(MFXWorkerThread* /*context*/) {
+    evaluateContextObjects(mySubscriptions, myBegin, myEnd, myInto);
+}
+#endif
+
+
+void
+Helper::collectContextObjectIDs(const Subscription& s, ContextObjects* precomputed, std::set<std::string>& objIDs) {
+    if (precomputed != nullptr && precomputed->evaluated) {
+        if (!precomputed->error.empty()) {
+            throw TraCIException(precomputed->error);
+        }
+        objIDs.swap(precomputed->objIDs);
+        return;
+    }
+    if ((s.activeFilters & SUBS_FILTER_NO_RTREE) == 0) {
+        PositionVector shape;
+        findObjectShape(s.commandId, s.id, shape);
+        collectObjectIDsInRange(s.contextDomain, shape, s.range, objIDs);
+    }
+    applySubscriptionFilters(s, objIDs);
+}
+
+
 bool
 Helper::needNewSubscription(libsumo::Subscription& s, std::vector<Subscription>& subscriptions, libsumo::Subscription*& modifiedSubscription) {
     for (libsumo::Subscription& o : subscriptions) {
@@ -229,16 +360,11 @@ Helper::addSubscriptionFilter(SubscriptionFilterType filter) {
 
 
 void
-Helper::handleSingleSubscription(const Subscription& s) {
+Helper::handleSingleSubscription(const Subscription& s, ContextObjects* precomputed) {
     const int getCommandId = s.contextDomain > 0 ? s.contextDomain : s.commandId - 0x30;
     std::set<std::string> objIDs;
     if (s.contextDomain > 0) {
-        if ((s.activeFilters & SUBS_FILTER_NO_RTREE) == 0) {
-            PositionVector shape;
-            findObjectShape(s.commandId, s.id, shape);
-            collectObjectIDsInRange(s.contextDomain, shape, s.range, objIDs);
-        }
-        applySubscriptionFilters(s, objIDs);
+        collectContextObjectIDs(s, precomputed, objIDs);
     } else {
         objIDs.insert(s.id);
     }
@@ -685,6 +811,15 @@ Helper::cleanup() {
     Helper::clearSubscriptions();
     delete myLaneTree;
     myLaneTree = nullptr;
+    setTrafficObjectIndexActive(false);
+    delete myVehicleGrid;
+    myVehicleGrid = nullptr;
+    delete myPersonGrid;
+    myPersonGrid = nullptr;
+    for (auto& item : myStoppingPlaceTrees) {
+        delete item.second.second;
+    }
+    myStoppingPlaceTrees.clear();
 }
 
 
@@ -817,18 +952,10 @@ Helper::collectObjectsInRange(int domain, const PositionVector& shape, double ra
     const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
     switch (domain) {
         case libsumo::CMD_GET_BUSSTOP_VARIABLE:
-            for (const auto& stop : MSNet::getInstance()->getStoppingPlaces(SUMO_TAG_BUS_STOP)) {
-                if (shape.distance2D(stop.second->getCenterPos()) <= range) {
-                    into.insert(stop.second);
-                }
-            }
+            collectStoppingPlacesInRange(SUMO_TAG_BUS_STOP, shape, range, cmin, cmax, into);
             break;
         case libsumo::CMD_GET_CHARGINGSTATION_VARIABLE:
-            for (const auto& stop : MSNet::getInstance()->getStoppingPlaces(SUMO_TAG_CHARGING_STATION)) {
-                if (shape.distance2D(stop.second->getCenterPos()) <= range) {
-                    into.insert(stop.second);
-                }
-            }
+            collectStoppingPlacesInRange(SUMO_TAG_CHARGING_STATION, shape, range, cmin, cmax, into);
             break;
         case libsumo::CMD_GET_CALIBRATOR_VARIABLE:
             for (const auto& calib : MSCalibrator::getInstances()) {
@@ -846,24 +973,24 @@ Helper::collectObjectsInRange(int domain, const PositionVector& shape, double ra
         case libsumo::CMD_GET_LANEAREA_VARIABLE:
             LaneArea::getTree()->Search(cmin, cmax, Named::StoringVisitor(into));
             break;
-        case libsumo::CMD_GET_PARKINGAREA_VARIABLE: {
-            for (const auto& stop : MSNet::getInstance()->getStoppingPlaces(SUMO_TAG_PARKING_AREA)) {
-                if (shape.distance2D(stop.second->getCenterPos()) <= range) {
-                    into.insert(stop.second);
-                }
-            }
+        case libsumo::CMD_GET_PARKINGAREA_VARIABLE:
+            collectStoppingPlacesInRange(SUMO_TAG_PARKING_AREA, shape, range, cmin, cmax, into);
             break;
-        }
         case libsumo::CMD_GET_POI_VARIABLE:
             POI::getTree()->Search(cmin, cmax, Named::StoringVisitor(into));
             break;
         case libsumo::CMD_GET_POLYGON_VARIABLE:
             Polygon::getTree()->Search(cmin, cmax, Named::StoringVisitor(into));
             break;
-        case libsumo::CMD_GET_EDGE_VARIABLE:
-        case libsumo::CMD_GET_LANE_VARIABLE:
         case libsumo::CMD_GET_PERSON_VARIABLE:
-        case libsumo::CMD_GET_VEHICLE_VARIABLE: {
+        case libsumo::CMD_GET_VEHICLE_VARIABLE:
+            if (myUseTrafficObjectIndex) {
+                collectTrafficObjectsInRange(domain, shape, range, cmin, cmax, into);
+                break;
+            }
+            FALLTHROUGH;
+        case libsumo::CMD_GET_EDGE_VARIABLE:
+        case libsumo::CMD_GET_LANE_VARIABLE: {
             if (myLaneTree == nullptr) {
                 myLaneTree = new LANE_RTREE_QUAL(&MSLane::visit);
                 MSLane::fill(*myLaneTree);
@@ -880,6 +1007,179 @@ Helper::collectObjectsInRange(int domain, const PositionVector& shape, double ra
 
 
 
+int
+Helper::countTrafficObjectQueries(const std::vector<Subscription>& subscriptions, const SUMOTime t) {
+    int result = 0;
+    for (const Subscription& s : subscriptions) {
+        if (s.beginTime <= t && (s.activeFilters & SUBS_FILTER_NO_RTREE) == 0
+                && (s.contextDomain == libsumo::CMD_GET_VEHICLE_VARIABLE || s.contextDomain == libsumo::CMD_GET_PERSON_VARIABLE)) {
+            result++;
+        }
+    }
+    return result;
+}
+
+
+bool
+Helper::trafficObjectIndexPaysOff(int numQueries) {
+    // building the index visits every lane and vehicle once while a lane based query
+    // typically visits a few dozen lanes around the queried shape
+    const int buildCost = MSLane::dictSize() + MSNet::getInstance()->getVehicleControl().getRunningVehicleNo();
+    return numQueries * 32 >= buildCost;
+}
+
+
+void
+Helper::setTrafficObjectIndexActive(bool active) {
+    myUseTrafficObjectIndex = active;
+    myHaveTrafficObjectIndex = false;
+    myIndexedObjects.clear();
+    if (myVehicleGrid != nullptr) {
+        myVehicleGrid->clear();
+        myPersonGrid->clear();
+    }
+}
+
+
+void
+Helper::collectTrafficObjects(const MSEdgeVector& edges, int begin, int end, std::vector<IndexedObject>& into) {
+    // the same objects as visited by MSLane::StoringVisitor
+    for (int i = begin; i < end; i++) {
+        const MSEdge* const edge = edges[i];
+        for (const MSLane* const lane : edge->getLanes()) {
+            for (const MSVehicle* veh : lane->getVehiclesSecure()) {
+                into.push_back({veh, veh->getPosition(), lane, nullptr});
+                for (const MSTransportable* p : veh->getPersons()) {
+                    into.push_back({p, p->getPosition(), nullptr, edge});
+                }
+            }
+            lane->releaseVehicles();
+            for (const MSBaseVehicle* veh : lane->getParkingVehicles()) {
+                into.push_back({veh, veh->getPosition(), lane, nullptr});
+            }
+        }
+        for (const MSTransportable* p : edge->getPersons()) {
+            into.push_back({p, p->getPosition(), nullptr, edge});
+        }
+    }
+}
+
+
+#ifdef HAVE_FOX
+void
+Helper::CollectTrafficObjectsTask::run(MFXWorkerThread* /*context*/) {
+    collectTrafficObjects(myEdges, myBegin, myEnd, myInto);
+}
+#endif
+
+
+void
+Helper::buildTrafficObjectIndex() {
+    if (myVehicleGrid == nullptr) {
+        // cells in the order of typical context subscription ranges
+        myVehicleGrid = new NamedGrid(50.);
+        myPersonGrid = new NamedGrid(50.);
+    }
+    const MSEdgeVector& edges = MSEdge::getAllEdges();
+    std::vector<std::vector<IndexedObject> > found(1);
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1 && edges.size() > 1) {
+        MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+        const int numChunks = MIN2((int)edges.size(), 4 * threadPool.size());
+        found.resize(numChunks);
+        for (int i = 0; i < numChunks; i++) {
+            threadPool.add(new CollectTrafficObjectsTask(edges, i * (int)edges.size() / numChunks,
+                           (i + 1) * (int)edges.size() / numChunks, found[i]), i % threadPool.size());
+        }
+        threadPool.waitAll();
+    } else {
+#endif
+#endif
+        collectTrafficObjects(edges, 0, (int)edges.size(), found.front());
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    }
+#endif
+#endif
+    for (const std::vector<IndexedObject>& chunk : found) {
+        for (const IndexedObject& o : chunk) {
+            if (myIndexedObjects.insert(std::make_pair(o.object, o)).second) {
+                const float pos[2] = {(float)o.pos.x(), (float)o.pos.y()};
+                (o.lane != nullptr ? myVehicleGrid : myPersonGrid)->update(pos, pos, o.object);
+            }
+        }
+    }
+    myHaveTrafficObjectIndex = true;
+}
+
+
+bool
+Helper::laneTreeOverlaps(const MSLane* lane, const float cmin[2], const float cmax[2]) {
+    // the lane rectangle as inserted by MSLane::fill
+    Boundary b = lane->getShape().getBoxBoundary();
+    b.grow(3.);
+    return (float)b.xmin() <= cmax[0] && cmin[0] <= (float)b.xmax() && (float)b.ymin() <= cmax[1] && cmin[1] <= (float)b.ymax();
+}
+
+
+void
+Helper::collectTrafficObjectsInRange(int domain, const PositionVector& shape, double range,
+                                     const float cmin[2], const float cmax[2], std::set<const Named*>& into) {
+    if (!myHaveTrafficObjectIndex) {
+        buildTrafficObjectIndex();
+    }
+    // objects are only reported if the lane search would have found them
+    std::vector<const Named*> candidates;
+    (domain == libsumo::CMD_GET_VEHICLE_VARIABLE ? myVehicleGrid : myPersonGrid)->search(cmin, cmax, candidates);
+    for (const Named* const object : candidates) {
+        const IndexedObject& o = myIndexedObjects.find(object)->second;
+        if (shape.distance2D(o.pos) > range) {
+            continue;
+        }
+        bool found = false;
+        if (o.lane != nullptr) {
+            found = laneTreeOverlaps(o.lane, cmin, cmax);
+        } else {
+            for (const MSLane* const lane : o.edge->getLanes()) {
+                if (laneTreeOverlaps(lane, cmin, cmax)) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (found) {
+            into.insert(object);
+        }
+    }
+}
+
+
+void
+Helper::collectStoppingPlacesInRange(SumoXMLTag category, const PositionVector& shape, double range,
+                                     const float cmin[2], const float cmax[2], std::set<const Named*>& into) {
+    const NamedObjectCont<MSStoppingPlace*>& stops = MSNet::getInstance()->getStoppingPlaces(category);
+    std::pair<int, NamedRTree*>& tree = myStoppingPlaceTrees[category];
+    if (tree.second == nullptr || tree.first != stops.size()) {
+        delete tree.second;
+        tree.second = new NamedRTree();
+        for (const auto& stop : stops) {
+            const Position center = stop.second->getCenterPos();
+            const float pos[2] = {(float)center.x(), (float)center.y()};
+            tree.second->Insert(pos, pos, stop.second);
+        }
+        tree.first = stops.size();
+    }
+    std::set<const Named*> candidates;
+    Named::StoringVisitor sv(candidates);
+    tree.second->Search(cmin, cmax, sv);
+    for (const Named* const stop : candidates) {
+        if (shape.distance2D(static_cast<const MSStoppingPlace*>(stop)->getCenterPos()) <= range) {
+            into.insert(stop);
+        }
+    }
+}
+
 void
 Helper::applySubscriptionFilters(const Subscription& s, std::set<std::string>& objIDs) {
 #ifdef DEBUG_SURROUNDING
@@ -21,12 +21,18 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include <libsumo/Subscription.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSNet.h>
 #include <microsim/traffic_lights/MSTLLogicControl.h>
 #include <microsim/trigger/MSCalibrator.h>
+#include <utils/common/NamedGrid.h>
+#include <utils/common/NamedRTree.h>
 #include <utils/vehicle/SUMOVehicleParameter.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -61,6 +67,36 @@ public:
 
     static void handleSubscriptions(const SUMOTime t);
 
+    /// @brief The (filtered) objects of a context subscription, evaluated before the variables are retrieved
+    struct ContextObjects {
+        /// @brief whether the objects were evaluated in advance
+        bool evaluated = false;
+        /// @brief the error message if the evaluation failed
+        std::string error;
+        /// @brief the shape of the subscribed object
+        PositionVector shape;
+        /// @brief the ids of the found objects
+        std::set<std::string> objIDs;
+    };
+
+    /** @brief Evaluates the context objects of the active context subscriptions in parallel (if multiple simulation threads are used)
+     *
+     * Only subscriptions whose range search and filters are safe for concurrent use are evaluated,
+     *  the entries of the other ones are left unevaluated. The variables are retrieved afterwards
+     *  in the order of the subscriptions.
+     * @param[in] subscriptions The subscriptions
+     * @param[in] t The current time, subscriptions beginning later are not evaluated
+     * @param[out] into The context objects per subscription, left empty if nothing was evaluated
+     */
+    static void evaluateContextObjects(const std::vector<Subscription>& subscriptions, const SUMOTime t, std::vector<ContextObjects>& into);
+
+    /** @brief Collects the (filtered) object ids of a context subscription or takes the ones evaluated in advance
+     * @param[in] s The context subscription
+     * @param[in] precomputed The objects evaluated in advance (may be nullptr)
+     * @param[out] objIDs The found object ids
+     */
+    static void collectContextObjectIDs(const Subscription& s, ContextObjects* precomputed, std::set<std::string>& objIDs);
+
     static bool needNewSubscription(libsumo::Subscription& s, std::vector<Subscription>& subscriptions, libsumo::Subscription*& modifiedSubscription);
 
     static void clearSubscriptions();
@@ -98,6 +134,34 @@ public:
     static void collectObjectsInRange(int domain, const PositionVector& shape, double range, std::set<const Named*>& into);
     static void collectObjectIDsInRange(int domain, const PositionVector& shape, double range, std::set<std::string>& into);
 
+    /// @brief returns the number of vehicle and person range queries of the context subscriptions active at t
+    static int countTrafficObjectQueries(const std::vector<Subscription>& subscriptions, const SUMOTime t);
+
+    /** @class TrafficObjectIndexScope
+     * @brief Uses a position index of all vehicles and persons for the range queries during its lifetime
+     *
+     * The index is only used if the expected number of vehicle and person queries makes up for
+     *  building it, otherwise the lane based search is kept. It is built on the first vehicle or
+     *  person query and reused by all further queries, so the simulation state must not change while
+     *  the scope exists (e.g. while evaluating all context subscriptions of a step). The results are
+     *  the same as without the index.
+     */
+    class TrafficObjectIndexScope {
+    public:
+        /// @param[in] numQueries The expected number of vehicle and person range queries
+        TrafficObjectIndexScope(int numQueries) {
+            setTrafficObjectIndexActive(trafficObjectIndexPaysOff(numQueries));
+        }
+        ~TrafficObjectIndexScope() {
+            setTrafficObjectIndexActive(false);
+        }
+    private:
+        /// @brief Invalidated copy constructor.
+        TrafficObjectIndexScope(const TrafficObjectIndexScope&) = delete;
+        /// @brief Invalidated assignment operator.
+        TrafficObjectIndexScope& operator=(const TrafficObjectIndexScope&) = delete;
+    };
+
     /**
      * @brief Filter the given ID-Set (which was obtained from an R-Tree search)
      *        according to the filters set by the subscription or firstly build the object ID list if
@@ -232,7 +296,14 @@ public:
     };
 
 private:
-    static void handleSingleSubscription(const Subscription& s);
+    static void handleSingleSubscription(const Subscription& s, ContextObjects* precomputed = nullptr);
+
+    /// @brief whether the context of the subscription can be evaluated concurrently with other subscriptions
+    static bool allowsConcurrentContextEvaluation(const Subscription& s);
+
+    /// @brief evaluates the prepared context objects of the given subscriptions (called from multiple threads)
+    static void evaluateContextObjects(const std::vector<Subscription>& subscriptions, std::vector<int>::const_iterator begin,
+                                       std::vector<int>::const_iterator end, std::vector<ContextObjects>& into);
 
     /// @brief Adds lane coverage information from newLaneCoverage into aggregatedLaneCoverage
     /// @param[in/out] aggregatedLaneCoverage - aggregated lane coverage info, to which the new will be added
@@ -276,6 +347,90 @@ private:
     /// @brief A lookup tree of lanes
     static LANE_RTREE_QUAL* myLaneTree;
 
+    /// @brief A vehicle or person with the position and the lane (vehicles) or edge (persons) it is found on
+    struct IndexedObject {
+        const Named* object;
+        Position pos;
+        const MSLane* lane;
+        const MSEdge* edge;
+    };
+
+    /// @brief enables or disables (and invalidates) the position index of vehicles and persons
+    static void setTrafficObjectIndexActive(bool active);
+
+    /// @brief whether building the position index is cheaper than the given number of lane based queries
+    static bool trafficObjectIndexPaysOff(int numQueries);
+
+    /// @brief collects the vehicles and persons on the given edges (called from multiple threads)
+    static void collectTrafficObjects(const MSEdgeVector& edges, int begin, int end, std::vector<IndexedObject>& into);
+
+    /// @brief builds the position index of vehicles and persons
+    static void buildTrafficObjectIndex();
+
+    /// @brief collects the vehicles or persons in range using the position index
+    static void collectTrafficObjectsInRange(int domain, const PositionVector& shape, double range,
+            const float cmin[2], const float cmax[2], std::set<const Named*>& into);
+
+    /// @brief whether the lane is found by a search of the lane tree with the given rectangle
+    static bool laneTreeOverlaps(const MSLane* lane, const float cmin[2], const float cmax[2]);
+
+    /// @brief collects the stopping places of the given type in range using a lookup tree of their centers
+    static void collectStoppingPlacesInRange(SumoXMLTag category, const PositionVector& shape, double range,
+            const float cmin[2], const float cmax[2], std::set<const Named*>& into);
+
+#ifdef HAVE_FOX
+    /// @brief collects the vehicles and persons on a range of edges
+    class CollectTrafficObjectsTask : public MFXWorkerThread::Task {
+    public:
+        CollectTrafficObjectsTask(const MSEdgeVector& edges, int begin, int end, std::vector<IndexedObject>& into) :
+            myEdges(edges), myBegin(begin), myEnd(end), myInto(into) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const MSEdgeVector& myEdges;
+        const int myBegin;
+        const int myEnd;
+        std::vector<IndexedObject>& myInto;
+    private:
+        /// @brief Invalidated assignment operator.
+        CollectTrafficObjectsTask& operator=(const CollectTrafficObjectsTask&) = delete;
+    };
+
+    /// @brief evaluates the context objects of a range of subscriptions
+    class ContextTask : public MFXWorkerThread::Task {
+    public:
+        ContextTask(const std::vector<Subscription>& subscriptions, std::vector<int>::const_iterator begin,
+                    std::vector<int>::const_iterator end, std::vector<ContextObjects>& into) :
+            mySubscriptions(subscriptions), myBegin(begin), myEnd(end), myInto(into) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const std::vector<Subscription>& mySubscriptions;
+        const std::vector<int>::const_iterator myBegin;
+        const std::vector<int>::const_iterator myEnd;
+        std::vector<ContextObjects>& myInto;
+    private:
+        /// @brief Invalidated assignment operator.
+        ContextTask& operator=(const ContextTask&) = delete;
+    };
+#endif
+
+    /// @brief Whether range queries for vehicles and persons use the position index
+    static bool myUseTrafficObjectIndex;
+
+    /// @brief Whether the position index is up to date
+    static bool myHaveTrafficObjectIndex;
+
+    /// @brief The positions of all vehicles (on lanes and parking)
+    static NamedGrid* myVehicleGrid;
+
+    /// @brief The positions of all persons (walking, waiting and riding)
+    static NamedGrid* myPersonGrid;
+
+    /// @brief The indexed vehicles and persons
+    static std::unordered_map<const Named*, IndexedObject> myIndexedObjects;
+
+    /// @brief Lookup trees of the stopping place centers with the number of stopping places they were built for
+    static std::map<SumoXMLTag, std::pair<int, NamedRTree*> > myStoppingPlaceTrees;
+
     static std::map<std::string, MSVehicle*> myRemoteControlledVehicles;
     static std::map<std::string, MSPerson*> myRemoteControlledPersons;
 
@@ -59,6 +59,7 @@
 MSEdge::DictType MSEdge::myDict;
 MSEdgeVector MSEdge::myEdges;
 SVCPermissions MSEdge::myMesoIgnoredVClasses(0);
+int MSEdge::myChangeCounter(0);
 
 
 // ===========================================================================
@@ -119,6 +120,7 @@ void MSEdge::recalcCache() {
     if (myLanes->empty()) {
         return;
     }
+    myChangeCounter++;
     myLength = myLanes->front()->getLength();
     myEmptyTraveltime = myLength / MAX2(getSpeedLimit(), NUMERICAL_EPS);
     if (isNormal() && (MSGlobals::gUseMesoSim || MSGlobals::gTLSPenalty > 0)) {
@@ -326,6 +328,7 @@ MSEdge::rebuildAllowedLanes(const bool onInit) {
         }
     }
     if (!onInit) {
+        myChangeCounter++;
         rebuildAllowedTargets(false);
         for (MSEdge* pred : myPredecessors) {
             pred->rebuildAllowedTargets(false);
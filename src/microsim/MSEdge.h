@@ -790,6 +790,11 @@ public:
         myMesoIgnoredVClasses = ignored;
     }
 
+    /// @brief returns the number of speed or permission changes of any edge (used to invalidate cached routes)
+    static int getChangeCounter() {
+        return myChangeCounter;
+    }
+
 public:
     /// @name Static parser helper
     /// @{
@@ -981,6 +986,9 @@ protected:
     static MSEdgeVector myEdges;
 
     static SVCPermissions myMesoIgnoredVClasses;
+
+    /// @brief the number of speed or permission changes of any edge
+    static int myChangeCounter;
     /// @}
 
 
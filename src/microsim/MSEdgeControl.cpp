@@ -22,6 +22,7 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <algorithm>
 #include <iostream>
 #include <queue>
 #include <vector>
@@ -39,6 +40,35 @@
 
 //#define PARALLEL_STOPWATCH
 
+// ===========================================================================
+// class definitions
+// ===========================================================================
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+/**
+ * @class CollisionTask
+ * @brief finds the collisions on a range of lanes without handling them
+ */
+class MSEdgeControl::CollisionTask : public MFXWorkerThread::Task {
+public:
+    CollisionTask(std::vector<MSLane*>::const_iterator begin, std::vector<MSLane*>::const_iterator end,
+                  std::vector<std::vector<MSLane::Collision> >::iterator into, SUMOTime timestep, const std::string& stage) :
+        myBegin(begin), myEnd(end), myInto(into), myTimestep(timestep), myStage(stage) {}
+    void run(MFXWorkerThread* context);
+private:
+    const std::vector<MSLane*>::const_iterator myBegin;
+    const std::vector<MSLane*>::const_iterator myEnd;
+    const std::vector<std::vector<MSLane::Collision> >::iterator myInto;
+    const SUMOTime myTimestep;
+    const std::string& myStage;
+private:
+    /// @brief Invalidated assignment operator.
+    CollisionTask& operator=(const CollisionTask&) = delete;
+};
+#endif
+#endif
+
+
 // ===========================================================================
 // member method definitions
 // ===========================================================================
@@ -336,6 +366,54 @@ MSEdgeControl::changeLanes(const SUMOTime t) {
 
 void
 MSEdgeControl::detectCollisions(SUMOTime timestep, const std::string& stage) {
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1) {
+        std::vector<MSLane*> lanes;
+        for (MSLane* lane : myActiveLanes) {
+            if (lane->needsCollisionCheck()) {
+                lanes.push_back(lane);
+            }
+        }
+        const int numActive = (int)lanes.size();
+        if (myInactiveCheckCollisions.size() > 0) {
+            // getContainer locks the container, so it must be called exactly once
+            const auto& inactive = myInactiveCheckCollisions.getContainer();
+            lanes.insert(lanes.end(), inactive.begin(), inactive.end());
+            myInactiveCheckCollisions.clear();
+            myInactiveCheckCollisions.unlock();
+        }
+        // an inactive lane may also be active, its second check is done serially
+        std::vector<MSLane*> parallel(lanes);
+        for (int i = numActive; i < (int)lanes.size(); i++) {
+            if (std::find(lanes.begin(), lanes.begin() + numActive, lanes[i]) != lanes.begin() + numActive) {
+                parallel[i] = nullptr;
+            }
+        }
+        std::vector<std::vector<MSLane::Collision> > collisions(lanes.size());
+        if (lanes.size() > 1) {
+            const int numChunks = MIN2((int)lanes.size(), 4 * myThreadPool.size());
+            for (int i = 0; i < numChunks; i++) {
+                myThreadPool.add(new CollisionTask(parallel.cbegin() + i * lanes.size() / numChunks, parallel.cbegin() + (i + 1) * lanes.size() / numChunks,
+                                                   collisions.begin() + i * lanes.size() / numChunks, timestep, stage), i % myThreadPool.size());
+            }
+            myThreadPool.waitAll();
+        }
+        bool removed = false;
+        for (int i = 0; i < (int)lanes.size(); i++) {
+            if (removed || parallel[i] == nullptr || lanes.size() == 1) {
+                // removals change the vehicles seen by the detection on the following lanes
+                collisions[i].clear();
+                lanes[i]->findCollisions(timestep, stage, collisions[i]);
+            }
+            if (!collisions[i].empty()) {
+                removed |= lanes[i]->handleCollisions(timestep, stage, collisions[i]);
+            }
+        }
+        return;
+    }
+#endif
+#endif
     // Detections is made by the edge's lanes, therefore hand over.
     for (MSLane* lane : myActiveLanes) {
         if (lane->needsCollisionCheck()) {
@@ -352,6 +430,21 @@ MSEdgeControl::detectCollisions(SUMOTime timestep, const std::string& stage) {
 }
 
 
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+void
+MSEdgeControl::CollisionTask::run(MFXWorkerThread* /*context*/) {
+    std::vector<std::vector<MSLane::Collision> >::iterator into = myInto;
+    for (std::vector<MSLane*>::const_iterator it = myBegin; it != myEnd; ++it, ++into) {
+        if (*it != nullptr) {
+            (*it)->findCollisions(myTimestep, myStage, *into);
+        }
+    }
+}
+#endif
+#endif
+
+
 void
 MSEdgeControl::gotActive(MSLane* l) {
     myChangedStateLanes.insert(l);
@@ -163,6 +163,10 @@ public:
      * Shouldn't be necessary if model-implementation is correct.
      * The parameter is simply passed to the lane-instance for reporting.
      *
+     * If multiple simulation threads are used, the collisions of all lanes are found in
+     *  parallel and handled afterwards in the lane order. Once vehicles were removed,
+     *  the collisions on the remaining lanes are found again to get the serial results.
+     *
      * @param[in] timestep The current time step
      * @param[in] stage The current stage within the simulation step
      * @note see MSNet::simulationStep
@@ -263,6 +267,13 @@ public:
     };
 #endif
 
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    /// @brief finds the collisions on a range of lanes without handling them (defined in the source to avoid including MSLane.h)
+    class CollisionTask;
+#endif
+#endif
+
 private:
     /// @brief Loaded edges
     MSEdgeVector myEdges;
@@ -121,4 +121,10 @@ MSEdgeWeightsStorage::knowsEffort(const MSEdge* const e) const {
 }
 
 
+bool
+MSEdgeWeightsStorage::hasTravelTimes() const {
+    return !myTravelTimes.empty();
+}
+
+
 /****************************************************************************/
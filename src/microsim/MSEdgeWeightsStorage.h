@@ -110,6 +110,12 @@ public:
     bool knowsEffort(const MSEdge* const e) const;
 
 
+    /** @brief Returns the information whether any travel time is stored
+     * @return Whether travel time information about any edge is stored
+     */
+    bool hasTravelTimes() const;
+
+
 private:
     /// @brief A map of edge->time->travel time
     std::map<const MSEdge*, ValueTimeLine<double> > myTravelTimes;
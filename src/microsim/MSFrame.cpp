@@ -517,7 +517,7 @@ MSFrame::fillOptions() {
 
     // pedestrian model
     oc.doRegister("pedestrian.model", new Option_String("striping"));
-    oc.addDescription("pedestrian.model", "Processing", TL("Select among pedestrian models ['nonInteracting', 'striping', 'remote']"));
+    oc.addDescription("pedestrian.model", "Processing", TL("Select among pedestrian models ['nonInteracting', 'striping', 'grid', 'remote'] (model 'grid' uses the striping parameters)"));
 
     oc.doRegister("pedestrian.striping.stripe-width", new Option_Float(0.64));
     oc.addDescription("pedestrian.striping.stripe-width", "Processing", TL("Width of parallel stripes for segmenting a sidewalk (meters) for use with model 'striping'"));
@@ -550,6 +550,9 @@ MSFrame::fillOptions() {
     oc.doRegister("pedestrian.striping.walkingarea-detail", new Option_Integer(4));
     oc.addDescription("pedestrian.striping.walkingarea-detail", "Processing", TL("Generate INT intermediate points to smooth out lanes within the walkingarea"));
 
+    oc.doRegister("pedestrian.striping.parallel", new Option_Bool(false));
+    oc.addDescription("pedestrian.striping.parallel", "Processing", TL("Move the pedestrians of different lanes in parallel when using multiple threads (the results differ from the serial movement)"));
+
     oc.doRegister("pedestrian.remote.address", new Option_String("localhost:9000"));
     oc.addDescription("pedestrian.remote.address", "Processing", TL("The address (host:port) of the external simulation"));
 
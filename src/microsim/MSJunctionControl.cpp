@@ -24,6 +24,8 @@
 #include <algorithm>
 #include "MSInternalJunction.h"
 #include "MSJunctionControl.h"
+#include "MSEdge.h"
+#include "MSLane.h"
 #include "MSLink.h"
 
 
@@ -53,6 +55,14 @@ MSJunctionControl::postloadInitContainer() {
         }
     }
     MSLink::recheckSetRequestInformation();
+    // the foe links are complete now
+    for (const MSEdge* const edge : MSEdge::getAllEdges()) {
+        for (const MSLane* const lane : edge->getLanes()) {
+            for (MSLink* const link : lane->getLinkCont()) {
+                link->initFoeCrossings();
+            }
+        }
+    }
 }
 
 
@@ -1543,6 +1543,14 @@ MSLane::updateLeaderInfo(const MSVehicle* veh, VehCont::reverse_iterator& vehPar
 
 void
 MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
+    std::vector<Collision> collisions;
+    findCollisions(timestep, stage, collisions);
+    handleCollisions(timestep, stage, collisions);
+}
+
+
+void
+MSLane::findCollisions(SUMOTime timestep, const std::string& stage, std::vector<Collision>& into) {
     myNeedsCollisionCheck = false;
 #ifdef DEBUG_COLLISIONS
     if (DEBUG_COND) {
@@ -1562,8 +1570,6 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
         return;
     }
 
-    std::set<const MSVehicle*, ComparatorNumericalIdLess> toRemove;
-    std::set<const MSVehicle*, ComparatorNumericalIdLess> toTeleport;
     if (mustCheckJunctionCollisions()) {
         myNeedsCollisionCheck = true; // always check
 #ifdef DEBUG_JUNCTION_COLLISIONS
@@ -1615,20 +1621,20 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
                             // junction leader is the victim (collider must still be on junction)
                             assert(isInternal());
                             if (victim->getLane()->isInternal() && victim->isLeader(myLinks.front(), collider, -1)) {
-                                foeLane->handleCollisionBetween(timestep, stage, victim, collider, -1, 0, toRemove, toTeleport);
+                                into.push_back({foeLane, victim, collider, nullptr, -1, 0, ""});
                             } else {
-                                handleCollisionBetween(timestep, stage, collider, victim, -1, 0, toRemove, toTeleport);
+                                into.push_back({this, collider, victim, nullptr, -1, 0, ""});
                             }
                         }
                     }
                 }
-                detectPedestrianJunctionCollision(collider, colliderBoundary, foeLane, timestep, stage, toRemove, toTeleport);
+                detectPedestrianJunctionCollision(collider, colliderBoundary, foeLane, timestep, stage, into);
             }
             if (myLinks.front()->getWalkingAreaFoe() != nullptr) {
-                detectPedestrianJunctionCollision(collider, colliderBoundary, myLinks.front()->getWalkingAreaFoe(), timestep, stage, toRemove, toTeleport);
+                detectPedestrianJunctionCollision(collider, colliderBoundary, myLinks.front()->getWalkingAreaFoe(), timestep, stage, into);
             }
             if (myLinks.front()->getWalkingAreaFoeExit() != nullptr) {
-                detectPedestrianJunctionCollision(collider, colliderBoundary, myLinks.front()->getWalkingAreaFoeExit(), timestep, stage, toRemove, toTeleport);
+                detectPedestrianJunctionCollision(collider, colliderBoundary, myLinks.front()->getWalkingAreaFoeExit(), timestep, stage, into);
             }
         }
     }
@@ -1663,7 +1669,7 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
                     continue;
                 }
                 const double gap = leader.second - length;
-                handleIntermodalCollisionBetween(timestep, stage, v, leader.first, gap, "sharedLane", toRemove, toTeleport);
+                into.push_back({this, v, nullptr, leader.first, gap, 0, "sharedLane"});
             }
         }
     }
@@ -1676,10 +1682,10 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
         VehCont::reverse_iterator lastVeh = myVehicles.rend() - 1;
         for (VehCont::reverse_iterator pred = myVehicles.rbegin(); pred != lastVeh; ++pred) {
             VehCont::reverse_iterator veh = pred + 1;
-            detectCollisionBetween(timestep, stage, *veh, *pred, toRemove, toTeleport);
+            detectCollisionBetween(timestep, stage, *veh, *pred, into);
         }
         if (myPartialVehicles.size() > 0) {
-            detectCollisionBetween(timestep, stage, *lastVeh, myPartialVehicles.front(), toRemove, toTeleport);
+            detectCollisionBetween(timestep, stage, *lastVeh, myPartialVehicles.front(), into);
         }
         if (getBidiLane() != nullptr) {
             // bidirectional railway
@@ -1719,7 +1725,7 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
                             if (collider->getSpeed() < victim->getSpeed()) {
                                 std::swap(victim, collider);
                             }
-                            handleCollisionBetween(timestep, stage, collider, victim, -1, 0, toRemove, toTeleport);
+                            into.push_back({this, collider, victim, nullptr, -1, 0, ""});
                         }
                     }
                 }
@@ -1745,15 +1751,27 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
                 if (lead->getPositionOnLane(this) < follow->getPositionOnLane(this)) {
                     continue;
                 }
-                if (detectCollisionBetween(timestep, stage, follow, lead, toRemove, toTeleport)) {
+                if (detectCollisionBetween(timestep, stage, follow, lead, into)) {
                     // XXX what about collisions with multiple leaders at once?
                     break;
                 }
             }
         }
     }
+}
 
 
+bool
+MSLane::handleCollisions(SUMOTime timestep, const std::string& stage, const std::vector<Collision>& collisions) {
+    std::set<const MSVehicle*, ComparatorNumericalIdLess> toRemove;
+    std::set<const MSVehicle*, ComparatorNumericalIdLess> toTeleport;
+    for (const Collision& c : collisions) {
+        if (c.victim != nullptr) {
+            c.lane->handleCollisionBetween(timestep, stage, c.collider, c.victim, c.gap, c.latGap, toRemove, toTeleport);
+        } else {
+            c.lane->handleIntermodalCollisionBetween(timestep, stage, c.collider, c.person, c.gap, c.type, toRemove, toTeleport);
+        }
+    }
     for (std::set<const MSVehicle*, ComparatorNumericalIdLess>::iterator it = toRemove.begin(); it != toRemove.end(); ++it) {
         MSVehicle* veh = const_cast<MSVehicle*>(*it);
         MSLane* vehLane = veh->getMutableLane();
@@ -1765,14 +1783,13 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
             MSNet::getInstance()->getVehicleControl().scheduleVehicleRemoval(veh);
         }
     }
+    return !toRemove.empty();
 }
 
 
 void
 MSLane::detectPedestrianJunctionCollision(const MSVehicle* collider, const PositionVector& colliderBoundary, const MSLane* foeLane,
-        SUMOTime timestep, const std::string& stage,
-        std::set<const MSVehicle*, ComparatorNumericalIdLess>& toRemove,
-        std::set<const MSVehicle*, ComparatorNumericalIdLess>& toTeleport) {
+        SUMOTime timestep, const std::string& stage, std::vector<Collision>& into) const {
     if (myIntermodalCollisionAction != COLLISION_ACTION_NONE && foeLane->getEdge().getPersons().size() > 0 && foeLane->hasPedestrians()) {
 #ifdef DEBUG_PEDESTRIAN_COLLISIONS
         if (DEBUG_COND) {
@@ -1802,7 +1819,7 @@ MSLane::detectPedestrianJunctionCollision(const MSVehicle* collider, const Posit
                 } else if (foeLane->getEdge().isWalkingArea()) {
                     collisionType = "walkingarea";
                 }
-                handleIntermodalCollisionBetween(timestep, stage, collider, *it_p, 0, collisionType, toRemove, toTeleport);
+                into.push_back({this, collider, nullptr, *it_p, 0, 0, collisionType});
             }
         }
     }
@@ -1811,8 +1828,7 @@ MSLane::detectPedestrianJunctionCollision(const MSVehicle* collider, const Posit
 
 bool
 MSLane::detectCollisionBetween(SUMOTime timestep, const std::string& stage, MSVehicle* collider, MSVehicle* victim,
-                               std::set<const MSVehicle*, ComparatorNumericalIdLess>& toRemove,
-                               std::set<const MSVehicle*, ComparatorNumericalIdLess>& toTeleport) const {
+                               std::vector<Collision>& into) const {
     if (myCollisionAction == COLLISION_ACTION_TELEPORT && ((victim->hasInfluencer() && victim->getInfluencer().isRemoteAffected(timestep)) ||
             (collider->hasInfluencer() && collider->getInfluencer().isRemoteAffected(timestep)))) {
         return false;
@@ -1909,7 +1925,7 @@ MSLane::detectCollisionBetween(SUMOTime timestep, const std::string& stage, MSVe
             std::cout << SIMTIME << " detectedCollision gap=" << gap << " latGap=" << latGap << "\n";
         }
 #endif
-        handleCollisionBetween(timestep, stage, collider, victim, gap, latGap, toRemove, toTeleport);
+        into.push_back({this, collider, victim, nullptr, gap, latGap, ""});
         return true;
     }
     return false;
@@ -2600,6 +2616,8 @@ MSLane::setFrictionCoefficient(double val) {
 
 void
 MSLane::setLength(double val) {
+    // the best lanes depend on the lane lengths
+    MSVehicle::clearBestLanesCache();
     myLength = val;
     myEdge->recalcCache();
 }
@@ -4278,6 +4296,7 @@ MSLane::initCollisionOptions(const OptionsCont& oc) {
 
 void
 MSLane::setPermissions(SVCPermissions permissions, long long transientID) {
+    MSVehicle::clearBestLanesCache();
     if (transientID == CHANGE_PERMISSIONS_PERMANENT) {
         myPermissions = permissions;
         myOriginalPermissions = permissions;
@@ -4290,6 +4309,7 @@ MSLane::setPermissions(SVCPermissions permissions, long long transientID) {
 
 void
 MSLane::resetPermissions(long long transientID) {
+    MSVehicle::clearBestLanesCache();
     myPermissionChanges.erase(transientID);
     if (myPermissionChanges.empty()) {
         myPermissions = myOriginalPermissions;
@@ -4311,12 +4331,14 @@ MSLane::hadPermissionChanges() const {
 
 void
 MSLane::setChangeLeft(SVCPermissions permissions) {
+    MSVehicle::clearBestLanesCache();
     myChangeLeft = permissions;
 }
 
 
 void
 MSLane::setChangeRight(SVCPermissions permissions) {
+    MSVehicle::clearBestLanesCache();
     myChangeRight = permissions;
 }
 
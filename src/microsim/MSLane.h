@@ -697,6 +697,38 @@ public:
     /// Check if vehicles are too close.
     virtual void detectCollisions(SUMOTime timestep, const std::string& stage);
 
+    /// @brief A detected collision which still has to be handled
+    struct Collision {
+        /// @brief the lane which handles the collision
+        const MSLane* lane;
+        const MSVehicle* collider;
+        /// @brief the victim vehicle (nullptr for collisions with persons)
+        const MSVehicle* victim;
+        /// @brief the victim person (nullptr for collisions between vehicles)
+        const MSTransportable* person;
+        double gap;
+        double latGap;
+        /// @brief the type of a collision with a person
+        std::string type;
+    };
+
+    /** @brief Finds the collisions on this lane without handling them
+     *
+     * Only reads the state of the vehicles and persons and may be called for multiple lanes in parallel.
+     * @param[in] timestep The current time
+     * @param[in] stage The simulation stage
+     * @param[filled] into The found collisions in the order in which they have to be handled
+     */
+    virtual void findCollisions(SUMOTime timestep, const std::string& stage, std::vector<Collision>& into);
+
+    /** @brief Handles the collisions found on this lane and removes or teleports the involved vehicles
+     * @param[in] timestep The current time
+     * @param[in] stage The simulation stage
+     * @param[in] collisions The collisions found by findCollisions
+     * @return Whether vehicles were removed from the network
+     */
+    bool handleCollisions(SUMOTime timestep, const std::string& stage, const std::vector<Collision>& collisions);
+
 
     /** Returns the information whether this lane may be used to continue
         the current route */
@@ -1355,14 +1387,11 @@ protected:
 
     /// @brief detect whether a vehicle collids with pedestrians on the junction
     void detectPedestrianJunctionCollision(const MSVehicle* collider, const PositionVector& colliderBoundary, const MSLane* foeLane,
-                                           SUMOTime timestep, const std::string& stage,
-                                           std::set<const MSVehicle*, ComparatorNumericalIdLess>& toRemove,
-                                           std::set<const MSVehicle*, ComparatorNumericalIdLess>& toTeleport);
+                                           SUMOTime timestep, const std::string& stage, std::vector<Collision>& into) const;
 
     /// @brief detect whether there is a collision between the two vehicles
     bool detectCollisionBetween(SUMOTime timestep, const std::string& stage, MSVehicle* collider, MSVehicle* victim,
-                                std::set<const MSVehicle*, ComparatorNumericalIdLess>& toRemove,
-                                std::set<const MSVehicle*, ComparatorNumericalIdLess>& toTeleport) const;
+                                std::vector<Collision>& into) const;
 
     /// @brief take action upon collision
     void handleCollisionBetween(SUMOTime timestep, const std::string& stage, const MSVehicle* collider, const MSVehicle* victim,
@@ -38,6 +38,8 @@ MSLeaderInfo::MSLeaderInfo(const double laneWidth, const MSVehicle* ego, const d
     myWidth(laneWidth),
     myOffset(0),
     myVehicles(MAX2(1, int(ceil(laneWidth / MSGlobals::gLateralResolution))), (MSVehicle*)nullptr),
+    myOccupied(0),
+    myEgoMask(sublaneMask(0, myVehicles.size() - 1)),
     myFreeSublanes((int)myVehicles.size()),
     egoRightMost(-1),
     egoLeftMost(-1),
@@ -47,6 +49,9 @@ MSLeaderInfo::MSLeaderInfo(const double laneWidth, const MSVehicle* ego, const d
         // filter out sublanes not of interest to ego
         myFreeSublanes -= egoRightMost;
         myFreeSublanes -= (int)myVehicles.size() - 1 - egoLeftMost;
+        if (egoRightMost >= 0) {
+            myEgoMask = sublaneMask(egoRightMost, egoLeftMost);
+        }
     }
 }
 
@@ -54,6 +59,18 @@ MSLeaderInfo::MSLeaderInfo(const double laneWidth, const MSVehicle* ego, const d
 MSLeaderInfo::~MSLeaderInfo() { }
 
 
+unsigned long long
+MSLeaderInfo::sublaneMask(int rightmost, int leftmost) {
+    rightmost = MAX2(0, rightmost);
+    leftmost = MIN2(MAX_MASKED_SUBLANES - 1, leftmost);
+    if (rightmost > leftmost) {
+        return 0;
+    }
+    const unsigned long long upTo = leftmost == MAX_MASKED_SUBLANES - 1 ? ~0ULL : (1ULL << (leftmost + 1)) - 1;
+    return upTo & ~((1ULL << rightmost) - 1);
+}
+
+
 int
 MSLeaderInfo::addLeader(const MSVehicle* veh, bool beyond, double latOffset) {
     if (veh == nullptr) {
@@ -62,7 +79,7 @@ MSLeaderInfo::addLeader(const MSVehicle* veh, bool beyond, double latOffset) {
     if (myVehicles.size() == 1) {
         // speedup for the simple case
         if (!beyond || myVehicles[0] == 0) {
-            myVehicles[0] = veh;
+            setVehicle(0, veh);
             myFreeSublanes = 0;
             myHasVehicles = true;
         }
@@ -71,6 +88,11 @@ MSLeaderInfo::addLeader(const MSVehicle* veh, bool beyond, double latOffset) {
     // map center-line based coordinates into [0, myWidth] coordinates
     int rightmost, leftmost;
     getSubLanes(veh, latOffset, rightmost, leftmost);
+    if (beyond && myVehicles.size() <= MAX_MASKED_SUBLANES
+            && (sublaneMask(rightmost, leftmost) & myEgoMask & ~myOccupied) == 0) {
+        // all relevant sublanes are already occupied by closer vehicles
+        return myFreeSublanes;
+    }
     //if (gDebugFlag1) std::cout << " addLeader veh=" << veh->getID() << " beyond=" << beyond << " latOffset=" << latOffset << " sublaneOffset=" << myOffset
     //    << " rightmost=" << rightmost << " leftmost=" << leftmost
     //    << " eRM=" << egoRightMost << " eLM=" << egoLeftMost
@@ -81,7 +103,7 @@ MSLeaderInfo::addLeader(const MSVehicle* veh, bool beyond, double latOffset) {
             if (myVehicles[sublane] == 0) {
                 myFreeSublanes--;
             }
-            myVehicles[sublane] = veh;
+            setVehicle(sublane, veh);
             myHasVehicles = true;
         }
     }
@@ -91,7 +113,8 @@ MSLeaderInfo::addLeader(const MSVehicle* veh, bool beyond, double latOffset) {
 
 void
 MSLeaderInfo::clear() {
-    myVehicles.assign(myVehicles.size(), (MSVehicle*)nullptr);
+    myVehicles.fill(nullptr);
+    myOccupied = 0;
     myFreeSublanes = (int)myVehicles.size();
     if (egoRightMost >= 0) {
         myFreeSublanes -= egoRightMost;
@@ -210,7 +233,7 @@ MSLeaderInfo::removeOpposite(const MSLane* lane) {
         if (veh != 0 &&
                 (veh->getLaneChangeModel().isOpposite()
                  || &lane->getEdge() != &veh->getLane()->getEdge())) {
-            myVehicles[i] = nullptr;
+            setVehicle(i, nullptr);
         }
     }
 }
@@ -229,7 +252,7 @@ MSLeaderDistanceInfo::MSLeaderDistanceInfo(const CLeaderDist& cLeaderDist, const
     MSLeaderInfo(laneWidth, nullptr, 0.),
     myDistances(1, cLeaderDist.second) {
     assert(myVehicles.size() == 1);
-    myVehicles[0] = cLeaderDist.first;
+    setVehicle(0, cLeaderDist.first);
     myHasVehicles = cLeaderDist.first != nullptr;
 }
 
@@ -254,7 +277,7 @@ MSLeaderDistanceInfo::addLeader(const MSVehicle* veh, double gap, double latOffs
             if (myVehicles[sublane] == 0) {
                 myFreeSublanes--;
             }
-            myVehicles[sublane] = veh;
+            setVehicle(sublane, veh);
             myDistances[sublane] = gap;
             myHasVehicles = true;
         }
@@ -272,7 +295,7 @@ MSLeaderDistanceInfo::addLeader(const MSVehicle* veh, double gap, double latOffs
             if (myVehicles[sublaneIdx] == 0) {
                 myFreeSublanes--;
             }
-            myVehicles[sublaneIdx] = veh;
+            setVehicle(sublaneIdx, veh);
             myDistances[sublaneIdx] = gap;
             myHasVehicles = true;
         }
@@ -297,7 +320,7 @@ MSLeaderDistanceInfo::addLeaders(MSLeaderDistanceInfo& other) {
 void
 MSLeaderDistanceInfo::clear() {
     MSLeaderInfo::clear();
-    myDistances.assign(myVehicles.size(), std::numeric_limits<double>::max());
+    myDistances.fill(std::numeric_limits<double>::max());
 }
 
 
@@ -337,7 +360,7 @@ MSLeaderDistanceInfo::fixOppositeGaps(bool isFollower) {
                 myDistances[i] -= myVehicles[i]->getVehicleType().getLength();
             } else if (isFollower && myDistances[i] > POSITION_EPS) {
                 // can ignore oncoming followers once they are past
-                myVehicles[i] = nullptr;
+                setVehicle(i, nullptr);
                 myDistances[i] = -1;
             }
         }
@@ -377,9 +400,9 @@ MSLeaderDistanceInfo::moveSamePosTo(const MSVehicle* ego, MSLeaderDistanceInfo&
     for (int i = 0; i < (int)myVehicles.size(); ++i) {
         if (myVehicles[i] != nullptr && myDistances[i] < 0 && myVehicles[i]->getPositionOnLane() == pos
                 && &myVehicles[i]->getLane()->getEdge() == &ego->getLane()->getEdge()) {
-            other.myVehicles[i] = myVehicles[i];
+            other.setVehicle(i, myVehicles[i]);
             other.myDistances[i] = myDistances[i];
-            myVehicles[i] = nullptr;
+            setVehicle(i, nullptr);
             myDistances[i] = -1;
         }
     }
@@ -445,7 +468,7 @@ MSCriticalFollowerDistanceInfo::addFollower(const MSVehicle* veh, const MSVehicl
             if (myVehicles[sublane] == 0) {
                 myFreeSublanes--;
             }
-            myVehicles[sublane] = veh;
+            setVehicle(sublane, veh);
             myDistances[sublane] = gap;
             myMissingGaps[sublane] = missingGap;
             myHasVehicles = true;
@@ -467,7 +490,7 @@ MSCriticalFollowerDistanceInfo::addFollower(const MSVehicle* veh, const MSVehicl
             if (myVehicles[sublaneIdx] == 0) {
                 myFreeSublanes--;
             }
-            myVehicles[sublaneIdx] = veh;
+            setVehicle(sublaneIdx, veh);
             myDistances[sublaneIdx] = gap;
             myMissingGaps[sublaneIdx] = missingGap;
             myHasVehicles = true;
@@ -480,7 +503,7 @@ MSCriticalFollowerDistanceInfo::addFollower(const MSVehicle* veh, const MSVehicl
 void
 MSCriticalFollowerDistanceInfo::clear() {
     MSLeaderDistanceInfo::clear();
-    myMissingGaps.assign(myVehicles.size(), -std::numeric_limits<double>::max());
+    myMissingGaps.fill(-std::numeric_limits<double>::max());
 }
 
 
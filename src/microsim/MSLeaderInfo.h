@@ -21,6 +21,7 @@
 #pragma once
 #include <config.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <utils/common/StdDefs.h>
@@ -42,6 +43,75 @@ typedef std::pair<MSVehicle*, double> LeaderDist;
 // ===========================================================================
 // class definitions
 // ===========================================================================
+/**
+ * @class MSSublaneValues
+ * @brief Per-sublane values which are stored inside the object for the common case of few sublanes
+ *
+ * Leader infos are created and copied very often (once per vehicle and step at least),
+ *  keeping the values of up to INLINE_CAPACITY sublanes in place avoids the heap allocations.
+ *  Wider lanes (or a very fine lateral resolution) use a vector instead.
+ */
+template<class T>
+class MSSublaneValues {
+public:
+    /// @brief the maximum number of sublanes stored in place
+    static const int INLINE_CAPACITY = 16;
+
+    /// Constructor
+    MSSublaneValues(const int size, const T& value) :
+        mySize(size) {
+        // initialize all entries to allow copying
+        std::fill(myInline, myInline + INLINE_CAPACITY, value);
+        if (size > INLINE_CAPACITY) {
+            myOverflow.assign(size, value);
+        }
+    }
+
+    int size() const {
+        return mySize;
+    }
+
+    T& operator[](int sublane) {
+        return begin()[sublane];
+    }
+
+    const T& operator[](int sublane) const {
+        return begin()[sublane];
+    }
+
+    /// @brief set all entries to the given value
+    void fill(const T& value) {
+        std::fill(begin(), end(), value);
+    }
+
+    T* begin() {
+        return mySize > INLINE_CAPACITY ? myOverflow.data() : myInline;
+    }
+
+    T* end() {
+        return begin() + mySize;
+    }
+
+    const T* begin() const {
+        return mySize > INLINE_CAPACITY ? myOverflow.data() : myInline;
+    }
+
+    const T* end() const {
+        return begin() + mySize;
+    }
+
+private:
+    /// @brief the number of sublanes
+    int mySize;
+
+    /// @brief the values if there are at most INLINE_CAPACITY sublanes
+    T myInline[INLINE_CAPACITY];
+
+    /// @brief the values if there are more than INLINE_CAPACITY sublanes
+    std::vector<T> myOverflow;
+};
+
+
 /**
  * @class MSLeaderInfo
  */
@@ -95,7 +165,7 @@ public:
         return myHasVehicles;
     }
 
-    const std::vector<const MSVehicle*>& getVehicles() const {
+    const MSSublaneValues<const MSVehicle*>& getVehicles() const {
         return myVehicles;
     }
 
@@ -116,6 +186,23 @@ public:
     virtual std::string toString() const;
 
 protected:
+    /// @brief the maximum number of sublanes for which the occupancy is tracked by bits
+    static const int MAX_MASKED_SUBLANES = 64;
+
+    /// @brief returns the bits of the sublanes from rightmost to leftmost (clipped to the masked sublanes)
+    static unsigned long long sublaneMask(int rightmost, int leftmost);
+
+    /// @brief sets the vehicle of the given sublane and updates the occupancy bits
+    void setVehicle(int sublane, const MSVehicle* veh) {
+        myVehicles[sublane] = veh;
+        if (sublane < MAX_MASKED_SUBLANES) {
+            if (veh == nullptr) {
+                myOccupied &= ~(1ULL << sublane);
+            } else {
+                myOccupied |= 1ULL << sublane;
+            }
+        }
+    }
 
     /// @brief the width of the lane to which this instance applies
     // @note: not const to simplify assignment
@@ -124,7 +211,13 @@ protected:
     /// @brief an extra offset for shifting the interpretation of sublane borders (default [0,myWidth])
     int myOffset;
 
-    std::vector<const MSVehicle*> myVehicles;
+    MSSublaneValues<const MSVehicle*> myVehicles;
+
+    /// @brief bit i is set if sublane i holds a vehicle (only valid for sublanes below MAX_MASKED_SUBLANES)
+    unsigned long long myOccupied;
+
+    /// @brief the sublanes of interest to ego (all sublanes if there is no ego)
+    unsigned long long myEgoMask;
 
     /// @brief the number of free sublanes
     // if an ego vehicle is given in the constructor, the number of free
@@ -181,7 +274,7 @@ public:
     /// @brief print a debugging representation
     virtual std::string toString() const;
 
-    const std::vector<double>& getDistances() const {
+    const MSSublaneValues<double>& getDistances() const {
         return myDistances;
     }
 
@@ -198,7 +291,7 @@ public:
 
 protected:
 
-    std::vector<double> myDistances;
+    MSSublaneValues<double> myDistances;
 
 };
 
@@ -248,7 +341,7 @@ public:
 protected:
 
     // @brief the differences between requriedGap and actual gap for each of the followers
-    std::vector<double> myMissingGaps;
+    MSSublaneValues<double> myMissingGaps;
 
     // @brief whether this Info objects tracks leaders instead of followers
     bool myHaveOppositeLeaders;
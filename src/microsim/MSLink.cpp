@@ -116,6 +116,7 @@ MSLink::MSLink(MSLane* predLane, MSLane* succLane, MSLane* via, LinkDirection di
                bool indirect) :
     myLane(succLane),
     myLaneBefore(predLane),
+    myEarliestApproachArrival(SUMOTime_MAX),
     myIndex(-1),
     myTLIndex(tlIndex),
     myLogic(logic),
@@ -555,6 +556,28 @@ MSLink::recheckSetRequestInformation() {
     myRecheck.clear();
 }
 
+
+void
+MSLink::initFoeCrossings() {
+    const MSLink* const exitLink = getCorrespondingExitLink();
+    const MSLane* const viaLaneOrLane = getViaLaneOrLane();
+    const auto compute = [exitLink, viaLaneOrLane](const std::vector<MSLink*>& foeLinks, std::vector<FoeCrossing>& into) {
+        into.clear();
+        for (const MSLink* const foeLink : foeLinks) {
+            const MSLink* const foeExitLink = foeLink->getCorrespondingExitLink();
+            // only exit links know their crossing points
+            into.push_back({exitLink->myInternalLaneBefore == nullptr ? INVALID_DOUBLE : exitLink->getLengthBeforeCrossing(foeLink->getViaLaneOrLane()),
+                            foeExitLink->myInternalLaneBefore == nullptr ? INVALID_DOUBLE : foeExitLink->getLengthBeforeCrossing(viaLaneOrLane)});
+        }
+    };
+    compute(myFoeLinks, myFoeCrossings);
+    if (myOffFoeLinks != nullptr) {
+        compute(*myOffFoeLinks, myOffFoeCrossings);
+    }
+    compute(mySublaneFoeLinks, mySublaneFoeCrossings);
+    compute(mySublaneFoeLinks2, mySublaneFoeCrossings2);
+}
+
 double
 MSLink::computeDistToDivergence(const MSLane* lane, const MSLane* sibling, double minDist, bool sameSource) const {
     double lbcSibling = 0;
@@ -662,9 +685,8 @@ MSLink::setApproaching(const SUMOVehicle* approaching, const SUMOTime arrivalTim
         }
     }
 #endif
-    myApproachingVehicles.emplace(approaching,
-                                  ApproachingVehicleInformation(arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, setRequest,
-                                          arrivalSpeedBraking, waitingTime, dist, approaching->getSpeed(), latOffset));
+    setApproaching(approaching, ApproachingVehicleInformation(arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, setRequest,
+                   arrivalSpeedBraking, waitingTime, dist, approaching->getSpeed(), latOffset));
 }
 
 
@@ -679,7 +701,12 @@ MSLink::setApproaching(const SUMOVehicle* approaching, ApproachingVehicleInforma
         }
     }
 #endif
-    myApproachingVehicles.emplace(approaching, ai);
+    auto it = std::lower_bound(myApproachingVehicles.begin(), myApproachingVehicles.end(), approaching, approachingBefore);
+    if (it != myApproachingVehicles.end() && it->first == approaching) {
+        return;
+    }
+    myEarliestApproachArrival = MIN2(myEarliestApproachArrival, ai.arrivalTime);
+    myApproachingVehicles.insert(it, std::make_pair(approaching, ai));
 }
 
 
@@ -713,13 +740,30 @@ MSLink::removeApproaching(const SUMOVehicle* veh) {
         }
     }
 #endif
-    myApproachingVehicles.erase(veh);
+    const auto it = std::lower_bound(myApproachingVehicles.begin(), myApproachingVehicles.end(), veh, approachingBefore);
+    if (it != myApproachingVehicles.end() && it->first == veh) {
+        const SUMOTime arrivalTime = it->second.arrivalTime;
+        myApproachingVehicles.erase(it);
+        if (arrivalTime == myEarliestApproachArrival) {
+            myEarliestApproachArrival = SUMOTime_MAX;
+            for (const auto& item : myApproachingVehicles) {
+                myEarliestApproachArrival = MIN2(myEarliestApproachArrival, item.second.arrivalTime);
+            }
+        }
+    }
+}
+
+
+MSLink::ApproachInfos::const_iterator
+MSLink::findApproaching(const SUMOVehicle* veh) const {
+    const auto it = std::lower_bound(myApproachingVehicles.begin(), myApproachingVehicles.end(), veh, approachingBefore);
+    return it != myApproachingVehicles.end() && it->first == veh ? it : myApproachingVehicles.end();
 }
 
 
 MSLink::ApproachingVehicleInformation
 MSLink::getApproaching(const SUMOVehicle* veh) const {
-    auto i = myApproachingVehicles.find(veh);
+    auto i = findApproaching(veh);
     if (i != myApproachingVehicles.end()) {
         return i->second;
     } else {
@@ -731,6 +775,7 @@ MSLink::getApproaching(const SUMOVehicle* veh) const {
 void
 MSLink::clearState() {
     myApproachingVehicles.clear();
+    myEarliestApproachArrival = SUMOTime_MAX;
 }
 
 
@@ -762,19 +807,28 @@ MSLink::opened(SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed, dou
     }
     //csy end
     const SUMOTime leaveTime = getLeaveTime(arrivalTime, arrivalSpeed, leaveSpeed, vehicleLength);
+    // foes arriving after this cannot block (unless both links have the same target lane)
+    const SUMOTime latestBlockingArrival = getLatestBlockingArrival(leaveTime, getLookAheadTime(ego));
+    const bool skipLateFoes = maySkipLateFoes(ego);
     if (MSGlobals::gLateralResolution > 0) {
         // check for foes on the same lane with the same target edge
-        for (const MSLink* foeLink : mySublaneFoeLinks) {
+        for (int i = 0; i < (int)mySublaneFoeLinks.size(); i++) {
+            const MSLink* const foeLink = mySublaneFoeLinks[i];
+            const FoeCrossing& crossing = mySublaneFoeCrossings[i];
             assert(myLane != foeLink->getLane());
+            if (skipLateFoes && foeLink->myEarliestApproachArrival > latestBlockingArrival) {
+                continue;
+            }
             for (const auto& it : foeLink->myApproachingVehicles) {
+                if (skipLateFoes && it.second.arrivalTime > latestBlockingArrival) {
+                    continue;
+                }
                 const SUMOVehicle* foe = it.first;
                 // csy start
                 double egoSpeed = ego->getLane()->getVehicleMaxSpeed(ego);
                 double foeSpeed = foe->getLane()->getVehicleMaxSpeed(foe);
-                double distToCrossing = this->getCorrespondingExitLink()->getLengthBeforeCrossing(foeLink->getViaLaneOrLane())
-                                      + STEPS2TIME(arrivalTime - SIMSTEP) * arrivalSpeed;
-                double foeDistToCrossing = foeLink->getCorrespondingExitLink()->getLengthBeforeCrossing(this->getViaLaneOrLane())
-                                         + STEPS2TIME(it.second.arrivalTime - SIMSTEP) * it.second.arrivalSpeed;
+                double distToCrossing = crossing.lengthBeforeCrossing + STEPS2TIME(arrivalTime - SIMSTEP) * arrivalSpeed;
+                double foeDistToCrossing = crossing.foeLengthBeforeCrossing + STEPS2TIME(it.second.arrivalTime - SIMSTEP) * it.second.arrivalSpeed;
                 double egoTTC = distToCrossing / egoSpeed;
                 double foeTTC = (foeDistToCrossing + foe->getLength()) / foeSpeed + STEPS2TIME(it.second.arrivalTime - SIMSTEP);
                 if (!isFoePerceived(ego, foe, egoTTC, distToCrossing, foeTTC)) {
@@ -814,17 +868,23 @@ MSLink::opened(SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed, dou
         // check for foes on the same lane with a different target edge
         // (straight movers take precedence if the paths cross)
         const int lhSign = MSGlobals::gLefthand ? -1 : 1;
-        for (const MSLink* foeLink : mySublaneFoeLinks2) {
+        for (int i = 0; i < (int)mySublaneFoeLinks2.size(); i++) {
+            const MSLink* const foeLink = mySublaneFoeLinks2[i];
+            const FoeCrossing& crossing = mySublaneFoeCrossings2[i];
             assert(myDirection != LinkDirection::STRAIGHT);
+            if (skipLateFoes && foeLink->myEarliestApproachArrival > latestBlockingArrival) {
+                continue;
+            }
             for (const auto& it : foeLink->myApproachingVehicles) {
+                if (skipLateFoes && it.second.arrivalTime > latestBlockingArrival) {
+                    continue;
+                }
                 const SUMOVehicle* foe = it.first;
                 // csy start
                 double egoSpeed = ego->getLane()->getVehicleMaxSpeed(ego);
                 double foeSpeed = foe->getLane()->getVehicleMaxSpeed(foe);
-                double distToCrossing = this->getCorrespondingExitLink()->getLengthBeforeCrossing(foeLink->getViaLaneOrLane())
-                                      + STEPS2TIME(arrivalTime - SIMSTEP) * arrivalSpeed;
-                double foeDistToCrossing = foeLink->getCorrespondingExitLink()->getLengthBeforeCrossing(this->getViaLaneOrLane())
-                                         + STEPS2TIME(it.second.arrivalTime - SIMSTEP) * it.second.arrivalSpeed;
+                double distToCrossing = crossing.lengthBeforeCrossing + STEPS2TIME(arrivalTime - SIMSTEP) * arrivalSpeed;
+                double foeDistToCrossing = crossing.foeLengthBeforeCrossing + STEPS2TIME(it.second.arrivalTime - SIMSTEP) * it.second.arrivalSpeed;
                 double egoTTC = distToCrossing / egoSpeed;
                 double foeTTC = (foeDistToCrossing + foe->getLength()) / foeSpeed + STEPS2TIME(it.second.arrivalTime - SIMSTEP);
                 if (!isFoePerceived(ego, foe, egoTTC, distToCrossing, foeTTC)) {
@@ -871,7 +931,9 @@ MSLink::opened(SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed, dou
         return false;
     }
 
-    const std::vector<MSLink*>& foeLinks = (myOffFoeLinks == nullptr || getCorrespondingEntryLink()->getState() != LINKSTATE_ALLWAY_STOP) ? myFoeLinks : *myOffFoeLinks;
+    const bool useOffFoes = myOffFoeLinks != nullptr && getCorrespondingEntryLink()->getState() == LINKSTATE_ALLWAY_STOP;
+    const std::vector<MSLink*>& foeLinks = useOffFoes ? *myOffFoeLinks : myFoeLinks;
+    const std::vector<FoeCrossing>& foeCrossings = useOffFoes ? myOffFoeCrossings : myFoeCrossings;
 #ifdef MSLink_DEBUG_OPENED
     if (gDebugFlag1) {
         std::cout << SIMTIME << " opened link=" << getViaLaneOrLane()->getID() << " foeLinks=" << foeLinks.size() << "\n";
@@ -882,7 +944,9 @@ MSLink::opened(SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed, dou
         return true;
     }
     const bool lastWasContRed = lastWasContState(LINKSTATE_TL_RED);
-    for (const MSLink* const link : foeLinks) {
+    for (int i = 0; i < (int)foeLinks.size(); i++) {
+        const MSLink* const link = foeLinks[i];
+        const FoeCrossing& crossing = foeCrossings[i];
         if (MSGlobals::gUseMesoSim) {
             if (link->haveRed()) {
                 continue;
@@ -894,14 +958,20 @@ MSLink::opened(SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed, dou
         }
 #endif
         // csy start
+        const bool sameTargetLane = myLane == link->getLane();
+        const bool skipLate = skipLateFoes && !sameTargetLane;
+        if (skipLate && link->myEarliestApproachArrival > latestBlockingArrival) {
+            continue;
+        }
         for (const auto& it : link->myApproachingVehicles) {
+            if (skipLate && it.second.arrivalTime > latestBlockingArrival) {
+                continue;
+            }
             const SUMOVehicle* foe = it.first;
             double egoSpeed = ego->getLane()->getVehicleMaxSpeed(ego);
             double foeSpeed = foe->getLane()->getVehicleMaxSpeed(foe);
-            double distToCrossing = this->getCorrespondingExitLink()->getLengthBeforeCrossing(link->getViaLaneOrLane())
-                                  + STEPS2TIME(arrivalTime - SIMSTEP) * arrivalSpeed;
-            double foeDistToCrossing = link->getCorrespondingExitLink()->getLengthBeforeCrossing(this->getViaLaneOrLane())
-                                     + STEPS2TIME(it.second.arrivalTime - SIMSTEP) * it.second.arrivalSpeed;
+            double distToCrossing = crossing.lengthBeforeCrossing + STEPS2TIME(arrivalTime - SIMSTEP) * arrivalSpeed;
+            double foeDistToCrossing = crossing.foeLengthBeforeCrossing + STEPS2TIME(it.second.arrivalTime - SIMSTEP) * it.second.arrivalSpeed;
             double egoTTC = distToCrossing / egoSpeed;
             double foeTTC = (foeDistToCrossing + foe->getLength()) / foeSpeed + STEPS2TIME(it.second.arrivalTime - SIMSTEP);
             /*WRITE_MESSAGE("ego veh " + ego->getID() + "; foe veh " + foe->getID() + "; distToCrossing: " + std::to_string(distToCrossing) + "; foeDistToCrossing: " + std::to_string(foeDistToCrossing)
@@ -910,7 +980,7 @@ MSLink::opened(SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed, dou
                 continue;
             }
             if (foe != ego && !ignoreFoe(ego, foe)
-                && blockedByFoe(it.first, it.second, arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, myLane == link->getLane(),
+                && blockedByFoe(it.first, it.second, arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, sameTargetLane,
                                 impatience, decel, waitingTime, ego)) {
                 if (collectFoes == nullptr) {
                     return false;
@@ -936,7 +1006,15 @@ bool
 MSLink::blockedAtTime(SUMOTime arrivalTime, SUMOTime leaveTime, double arrivalSpeed, double leaveSpeed,
                       bool sameTargetLane, double impatience, double decel, SUMOTime waitingTime,
                       BlockingFoes* collectFoes, const SUMOTrafficObject* ego, bool lastWasContRed) const {
+    // foes arriving after this cannot block (unless both links have the same target lane)
+    const SUMOTime latestBlockingArrival = getLatestBlockingArrival(leaveTime, getLookAheadTime(ego));
+    if (!sameTargetLane && myEarliestApproachArrival > latestBlockingArrival) {
+        return false;
+    }
     for (const auto& it : myApproachingVehicles) {
+        if (!sameTargetLane && it.second.arrivalTime > latestBlockingArrival) {
+            continue;
+        }
 #ifdef MSLink_DEBUG_OPENED
         if (gDebugFlag1) {
             if (ego != nullptr
@@ -1025,11 +1103,7 @@ MSLink::blockedByFoe(const SUMOVehicle* veh, const ApproachingVehicleInformation
     }
 
 
-    const SUMOTime lookAhead = (myState == LINKSTATE_ZIPPER
-                                ? myLookaheadTimeZipper
-                                : (ego == nullptr
-                                   ? myLookaheadTime
-                                   : TIME2STEPS(ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_TIMEGAP_MINOR, STEPS2TIME(myLookaheadTime)))));
+    const SUMOTime lookAhead = getLookAheadTime(ego);
     //if (ego != 0) std::cout << SIMTIME << " ego=" << ego->getID() << " jmTimegapMinor=" << ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_TIMEGAP_MINOR, -1) << " lookAhead=" << lookAhead << "\n";
 #ifdef MSLink_DEBUG_OPENED
     if (gDebugFlag1 || gDebugFlag6) {
@@ -1074,6 +1148,22 @@ MSLink::blockedByFoe(const SUMOVehicle* veh, const ApproachingVehicleInformation
 }
 
 
+bool
+MSLink::maySkipLateFoes(const SUMOTrafficObject* ego) {
+    return ego == nullptr || (ego->isVehicle() && !MSGlobals::gUseMesoSim);
+}
+
+
+SUMOTime
+MSLink::getLookAheadTime(const SUMOTrafficObject* ego) const {
+    return (myState == LINKSTATE_ZIPPER
+            ? myLookaheadTimeZipper
+            : (ego == nullptr
+               ? myLookaheadTime
+               : TIME2STEPS(ego->getVehicleType().getParameter().getJMParam(SUMO_ATTR_JM_TIMEGAP_MINOR, STEPS2TIME(myLookaheadTime)))));
+}
+
+
 SUMOTime
 MSLink::computeFoeArrivalTimeBraking(SUMOTime arrivalTime, const SUMOVehicle* foe, SUMOTime foeArrivalTime, double impatience, double dist, double& fasb) {
     // a: distance saved when foe brakes from arrivalTime to foeArrivalTime
@@ -1238,7 +1328,7 @@ MSLink::writeApproaching(OutputDevice& od, const std::string fromLaneID) const {
         std::sort(toSort.begin(), toSort.end());
         for (std::vector<std::pair<SUMOTime, const SUMOVehicle*> >::const_iterator it = toSort.begin(); it != toSort.end(); ++it) {
             od.openTag("approaching");
-            const ApproachingVehicleInformation& avi = myApproachingVehicles.find(it->second)->second;
+            const ApproachingVehicleInformation& avi = findApproaching(it->second)->second;
             od.writeAttr(SUMO_ATTR_ID, it->second->getID());
             od.writeAttr(SUMO_ATTR_IMPATIENCE, it->second->getImpatience());
             od.writeAttr("arrivalTime", time2string(avi.arrivalTime));
@@ -140,29 +140,30 @@ public:
         }
 
         /// @brief The time the vehicle's front arrives at the link
-        const SUMOTime arrivalTime;
+        SUMOTime arrivalTime;
         /// @brief The estimated time at which the vehicle leaves the link
-        const SUMOTime leavingTime;
+        SUMOTime leavingTime;
         /// @brief The estimated speed with which the vehicle arrives at the link (for headway computation)
-        const double arrivalSpeed;
+        double arrivalSpeed;
         /// @brief The estimated speed with which the vehicle leaves the link (for headway computation)
-        const double leaveSpeed;
+        double leaveSpeed;
         /// @brief Whether the vehicle wants to pass the link (@todo: check semantics)
-        const bool willPass;
+        bool willPass;
         /// @brief The estimated speed with which the vehicle arrives at the link if it starts braking(for headway computation)
-        const double arrivalSpeedBraking;
+        double arrivalSpeedBraking;
         /// @brief The waiting duration at the current link
-        const SUMOTime waitingTime;
+        SUMOTime waitingTime;
         /// @brief The distance up to the current link
-        const double dist;
+        double dist;
         /// @brief The current speed
-        const double speed;
+        double speed;
         /// @brief The lateral offset from the center of the entering lane
-        const double latOffset;
+        double latOffset;
 
     };
 
-    typedef std::map<const SUMOVehicle*, const ApproachingVehicleInformation, ComparatorNumericalIdLess> ApproachInfos;
+    /// @brief the vehicles approaching a link sorted by numerical id
+    typedef std::vector<std::pair<const SUMOVehicle*, ApproachingVehicleInformation> > ApproachInfos;
     typedef std::vector<const SUMOVehicle*> BlockingFoes;
 
     enum ConflictFlag {
@@ -671,6 +672,9 @@ public:
     /// @brief post-processing for legacy networks
     static void recheckSetRequestInformation();
 
+    /// @brief computes the distances to the crossing points with all foe links (to be called after all junctions are initialized)
+    void initFoeCrossings();
+
     static bool ignoreFoe(const SUMOTrafficObject* ego, const SUMOTrafficObject* foe);
 
     static const double NO_INTERSECTION;
@@ -724,6 +728,31 @@ private:
                       bool sameTargetLane, double impatience, double decel, SUMOTime waitingTime,
                       const SUMOTrafficObject* ego) const;
 
+    /// @brief the time gap ego needs in front of a foe when passing this link before it
+    SUMOTime getLookAheadTime(const SUMOTrafficObject* ego) const;
+
+    /** @brief the latest arrival time of a foe which may block ego (unless both links have the same target lane)
+     * @note blockedByFoe never lets a foe arrive earlier than announced (up to rounding)
+     */
+    static SUMOTime getLatestBlockingArrival(SUMOTime leaveTime, SUMOTime lookAhead) {
+        return leaveTime >= SUMOTime_MAX - lookAhead - DELTA_T ? SUMOTime_MAX : leaveTime + lookAhead + DELTA_T;
+    }
+
+    /// @brief returns the position of the given vehicle in myApproachingVehicles (or the end if it is not approaching)
+    ApproachInfos::const_iterator findApproaching(const SUMOVehicle* veh) const;
+
+    /// @brief whether the entry of myApproachingVehicles is sorted before the given vehicle
+    static bool approachingBefore(const ApproachInfos::value_type& item, const SUMOVehicle* veh) {
+        return item.first->getNumericalID() < veh->getNumericalID();
+    }
+
+    /** @brief whether foes arriving too late to block ego may be skipped
+     *
+     * Checking whether a foe is perceived draws random numbers unless ego is a vehicle of the
+     *  microsimulation (which uses one random value per step), so all foes must be visited then.
+     */
+    static bool maySkipLateFoes(const SUMOTrafficObject* ego);
+
     /// @brief figure out whether the cont status remains in effect when switching off the tls
     bool checkContOff() const;
 
@@ -750,6 +779,8 @@ private:
     MSLane* myLaneBefore;
 
     ApproachInfos myApproachingVehicles;
+    /// @brief the earliest arrival time of the approaching vehicles
+    SUMOTime myEarliestApproachArrival;
     std::set<MSLink*> myBlockedFoeLinks;
 
     /// @brief The position within this respond
@@ -824,6 +855,22 @@ private:
     std::vector<MSLink*> myFoeLinks;
     std::vector<const MSLane*> myFoeLanes;
 
+    /// @brief the distances to the crossing point with a foe link
+    struct FoeCrossing {
+        /// @brief the distance of the crossing point behind this link
+        double lengthBeforeCrossing;
+        /// @brief the distance of the crossing point behind the foe link
+        double foeLengthBeforeCrossing;
+    };
+
+    /* @brief crossing distances for myFoeLinks, myOffFoeLinks, mySublaneFoeLinks and mySublaneFoeLinks2
+     * (index corresponds to the respective foe links)
+     */
+    std::vector<FoeCrossing> myFoeCrossings;
+    std::vector<FoeCrossing> myOffFoeCrossings;
+    std::vector<FoeCrossing> mySublaneFoeCrossings;
+    std::vector<FoeCrossing> mySublaneFoeCrossings2;
+
     /* prioritized links when the traffic light is switched off (only needed for RightOfWay::ALLWAYSTOP)
      * @note stored as a pointer to save space since it won't be used in most cases
      */
@@ -748,6 +748,8 @@ MSNet::simulationStep(const bool onlyMove) {
             myPeriodicStateFiles.erase(myPeriodicStateFiles.begin());
         }
     }
+    // idle traffic lights which were activated by detectors resume their switch checks
+    myLogics->wakeUpIdle();
     myBeginOfTimestepEvents->execute(myStep);
     MSRailSignal::recheckGreen();
 #ifdef HAVE_FOX
@@ -938,6 +940,7 @@ MSNet::clearAll() {
     MSEdge::clear();
     MSLane::clear();
     MSRoute::clear();
+    MSVehicle::clearBestLanesCache();
     delete MSVehicleTransfer::getInstance();
     MSDevice::cleanupAll();
     MSCalibrator::cleanup();
@@ -1132,9 +1135,7 @@ MSNet::writeOutput() {
     }
 
     // write SSM output
-    for (MSDevice_SSM* dev : MSDevice_SSM::getInstances()) {
-        dev->updateAndWriteOutput();
-    }
+    MSDevice_SSM::updateAndWriteAllOutputs();
 
     // write ToC output
     for (MSDevice_ToC* dev : MSDevice_ToC::getInstances()) {
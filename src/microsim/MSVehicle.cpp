@@ -43,6 +43,7 @@
 #include <utils/common/FileHelpers.h>
 #include <utils/router/DijkstraRouter.h>
 #include <utils/common/RandHelper.h>
+#include <utils/common/ScopedLocker.h>
 #include <utils/common/StringUtils.h>
 #include <utils/common/StdDefs.h>
 #include <utils/geom/GeomHelper.h>
@@ -124,6 +125,10 @@
 // static value definitions
 // ===========================================================================
 std::vector<MSLane*> MSVehicle::myEmptyLaneVector;
+std::map<MSVehicle::BestLanesKey, std::shared_ptr<const std::vector<std::vector<MSVehicle::LaneQ> > > > MSVehicle::myBestLanesCache;
+#ifdef HAVE_FOX
+FXMutex MSVehicle::myBestLanesCacheMutex;
+#endif
 
 
 // ===========================================================================
@@ -5710,6 +5715,53 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
     bool progress = true;
     // bestLanes must cover the braking distance even when at the very end of the current lane to avoid unecessary slow down
     const double maxBrakeDist = startLane->getLength() + getCarFollowModel().getHeadwayTime() * getMaxSpeed() + getCarFollowModel().brakeGap(getMaxSpeed()) + getVehicleType().getMinGap();
+    // without stops the best lanes only depend on the edges ahead and the vehicle class and can be shared
+    const bool useCache = nextStopEdge == myRoute->end() && getDevice(typeid(MSDevice_ElecHybrid)) == nullptr;
+    BestLanesKey cacheKey;
+    if (useCache) {
+        // the lane choice depends on the priority of the links ahead which changes with the traffic light phases
+        std::string tlsPriorities;
+        for (MSRouteIterator ce = myCurrEdge; progress;) {
+            ++seen;
+            seenLength += (*ce)->getLanes()[0]->getLength();
+            for (const MSLane* const lane : (*ce)->getLanes()) {
+                for (const MSLink* const link : lane->getLinkCont()) {
+                    if (link->getTLLogic() != nullptr) {
+                        tlsPriorities += link->havePriority() ? '1' : '0';
+                    }
+                }
+            }
+            ++ce;
+            progress &= (seen <= 4 || seenLength < MAX2(maxBrakeDist, 3000.0)); // motorway
+            progress &= (seen <= 8 || seenLength < MAX2(maxBrakeDist, 200.0) || isRailway(getVClass()));  // urban
+            progress &= ce != myRoute->end();
+        }
+        // the allowed lanes of the last edge depend on the following one
+        cacheKey = BestLanesKey(getVClass(), seen, ConstMSEdgeVector(myCurrEdge, myCurrEdge + MIN2(seen + 1, (int)(myRoute->end() - myCurrEdge))), tlsPriorities);
+        std::shared_ptr<const std::vector<std::vector<LaneQ> > > cached;
+        {
+#ifdef HAVE_FOX
+            ScopedLocker<> lock(myBestLanesCacheMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+            auto it = myBestLanesCache.find(cacheKey);
+            if (it != myBestLanesCache.end()) {
+                cached = it->second;
+            }
+        }
+        if (cached != nullptr) {
+            myBestLanes = *cached;
+            updateOccupancyAndCurrentBestLane(startLane);
+#ifdef DEBUG_BESTLANES
+            if (DEBUG_COND) {
+                std::cout << SIMTIME << " veh=" << getID() << " cached bestCont=" << toString(getBestLanesContinuation()) << "\n";
+            }
+#endif
+            return;
+        }
+        seen = 0;
+        seenLength = 0;
+        progress = true;
+    }
     for (MSRouteIterator ce = myCurrEdge; progress;) {
         std::vector<LaneQ> currentLanes;
         const std::vector<MSLane*>* allowed = nullptr;
@@ -5980,6 +6032,16 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
 #endif
 
     }
+    if (useCache) {
+        std::shared_ptr<const std::vector<std::vector<LaneQ> > > entry = std::make_shared<const std::vector<std::vector<LaneQ> > >(myBestLanes);
+#ifdef HAVE_FOX
+        ScopedLocker<> lock(myBestLanesCacheMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+        if ((int)myBestLanesCache.size() >= BEST_LANES_CACHE_ENTRIES_PER_LANE * MSLane::dictSize()) {
+            myBestLanesCache.clear();
+        }
+        myBestLanesCache[cacheKey] = entry;
+    }
     updateOccupancyAndCurrentBestLane(startLane);
 #ifdef DEBUG_BESTLANES
     if (DEBUG_COND) {
@@ -5990,6 +6052,15 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
 }
 
 
+void
+MSVehicle::clearBestLanesCache() {
+#ifdef HAVE_FOX
+    ScopedLocker<> lock(myBestLanesCacheMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+    myBestLanesCache.clear();
+}
+
+
 int
 MSVehicle::nextLinkPriority(const std::vector<MSLane*>& conts) {
     if (conts.size() < 2) {
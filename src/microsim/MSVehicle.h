@@ -36,9 +36,13 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <tuple>
 #include "MSGlobals.h"
 #include "MSBaseVehicle.h"
 #include "MSNet.h"
+#ifdef HAVE_FOX
+#include <utils/foxtools/fxheader.h>
+#endif
 
 #define INVALID_SPEED 299792458 + 1 // nothing can go faster than the speed of light! Refs. #2577
 
@@ -925,6 +929,13 @@ public:
     void updateBestLanes(bool forceRebuild = false, const MSLane* startLane = 0);
 
 
+    /** @brief Removes all entries from the best lanes cache
+     *
+     * Must be called whenever lane permissions change (the cache is shared by all vehicles).
+     */
+    static void clearBestLanesCache();
+
+
     /** @brief Returns the best sequence of lanes to continue the route starting at myLane
      * @return The bestContinuations of the LaneQ for myLane (see LaneQ)
      */
@@ -1920,6 +1931,24 @@ protected:
 
     static std::vector<MSLane*> myEmptyLaneVector;
 
+    /** @brief The key of the best lanes cache: the vehicle class, the number of considered edges, the considered edges plus the following one
+     * and the priorities of the traffic light controlled links leaving the considered edges
+     */
+    typedef std::tuple<SUMOVehicleClass, int, ConstMSEdgeVector, std::string> BestLanesKey;
+
+    /* @brief The best lanes (without occupancy) computed for vehicles without stops, shared by all vehicles
+     * The entries are reference counted so they stay valid while being copied even if the cache is cleared
+     */
+    static std::map<BestLanesKey, std::shared_ptr<const std::vector<std::vector<LaneQ> > > > myBestLanesCache;
+
+#ifdef HAVE_FOX
+    /// @brief The mutex for access to the best lanes cache
+    static FXMutex myBestLanesCacheMutex;
+#endif
+
+    /// @brief The maximum number of entries per lane in the best lanes cache before it gets cleared
+    static const int BEST_LANES_CACHE_ENTRIES_PER_LANE = 4;
+
     /// @brief The current acceleration after dawdling in m/s
     double myAcceleration;
 
@@ -21,6 +21,9 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <algorithm>
+#include <functional>
+
 #include <utils/common/MsgHandler.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/iodevices/OutputDevice.h>
@@ -48,6 +51,7 @@ double MSDevice_BTreceiver::myRange = -1.;
 double MSDevice_BTreceiver::myOffTime = -1.;
 SumoRNG MSDevice_BTreceiver::sRecognitionRNG("btreceiver");
 std::map<std::string, MSDevice_BTreceiver::VehicleInformation*> MSDevice_BTreceiver::sVehicles;
+std::map<SUMOTrafficObject::NumericalID, MSTransportableDevice_BTreceiver*> MSTransportableDevice_BTreceiver::sInstances;
 
 
 // ===========================================================================
@@ -82,11 +86,11 @@ MSVehicleDevice_BTreceiver::buildVehicleDevices(SUMOVehicle& v, std::vector<MSVe
         MSVehicleDevice_BTreceiver* device = new MSVehicleDevice_BTreceiver(v, "btreceiver_" + v.getID());
         into.push_back(device);
         if (!myWasInitialised) {
-            new BTreceiverUpdate();
             myWasInitialised = true;
             myRange = oc.getFloat("device.btreceiver.range");
             myOffTime = oc.getFloat("device.btreceiver.offtime");
             sRecognitionRNG.seed(oc.getInt("seed"));
+            new BTreceiverUpdate();
         }
     }
 }
@@ -105,11 +109,11 @@ MSTransportableDevice_BTreceiver::buildDevices(MSTransportable& t, std::vector<M
         into.push_back(device);
         myHasPersons = true;
         if (!myWasInitialised) {
-            new BTreceiverUpdate();
             myWasInitialised = true;
             myRange = oc.getFloat("device.btreceiver.range");
             myOffTime = oc.getFloat("device.btreceiver.offtime");
             sRecognitionRNG.seed(oc.getInt("seed"));
+            new BTreceiverUpdate();
         }
     }
 }
@@ -118,7 +122,8 @@ MSTransportableDevice_BTreceiver::buildDevices(MSTransportable& t, std::vector<M
 // ---------------------------------------------------------------------------
 // MSDevice_BTreceiver::BTreceiverUpdate-methods
 // ---------------------------------------------------------------------------
-MSDevice_BTreceiver::BTreceiverUpdate::BTreceiverUpdate() {
+MSDevice_BTreceiver::BTreceiverUpdate::BTreceiverUpdate() :
+    mySenderGrid(myRange) {
     MSNet::getInstance()->getEndOfTimestepEvents()->addEvent(this);
 }
 
@@ -136,47 +141,53 @@ MSDevice_BTreceiver::BTreceiverUpdate::~BTreceiverUpdate() {
 }
 
 
+void
+MSDevice_BTreceiver::BTreceiverUpdate::updatePersons() {
+    for (const auto& item : MSTransportableDevice_BTsender::sInstances) {
+        MSTransportable& t = item.second->getHolder();
+        if (t.getCurrentStageType() != MSStageType::WAITING_FOR_DEPART) {
+            item.second->notifyMove(t, t.getPositionOnLane(), t.getPositionOnLane(), t.getSpeed());
+            MSDevice_BTsender::VehicleInformation* const info = item.second->getInfo(t);
+            if (info->route.back() != t.getEdge()) {
+                info->route.push_back(t.getEdge());
+            }
+        }
+    }
+    for (const auto& item : MSTransportableDevice_BTreceiver::sInstances) {
+        MSTransportable& t = item.second->getHolder();
+        if (t.getCurrentStageType() != MSStageType::WAITING_FOR_DEPART) {
+            item.second->notifyMove(t, t.getPositionOnLane(), t.getPositionOnLane(), t.getSpeed());
+            VehicleInformation* const info = item.second->getInfo(t);
+            if (info->route.back() != t.getEdge()) {
+                info->route.push_back(t.getEdge());
+            }
+        }
+    }
+}
+
+
 SUMOTime
 MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
     // loop over equipped persons to update their positions
     if (myHasPersons && MSNet::getInstance()->hasPersons()) {  // the check whether the net has persons is only important in the final cleanup
-        MSTransportableControl& c = MSNet::getInstance()->getPersonControl();
-        for (MSTransportableControl::constVehIt i = c.loadedBegin(); i != c.loadedEnd(); ++i) {
-            MSTransportable* t = i->second;
-            if (t->getCurrentStageType() != MSStageType::WAITING_FOR_DEPART) {
-                MSDevice_BTsender* snd = dynamic_cast<MSDevice_BTsender*>(t->getDevice(typeid(MSTransportableDevice_BTsender)));
-                MSDevice_BTreceiver* rec = dynamic_cast<MSDevice_BTreceiver*>(t->getDevice(typeid(MSTransportableDevice_BTreceiver)));
-                if (snd) {
-                    snd->notifyMove(*t, t->getPositionOnLane(), t->getPositionOnLane(), t->getSpeed());
-                    if (MSDevice_BTsender::sVehicles[t->getID()]->route.back() != t->getEdge()) {
-                        MSDevice_BTsender::sVehicles[t->getID()]->route.push_back(t->getEdge());
-                    }
-                }
-                if (rec) {
-                    rec->notifyMove(*t, t->getPositionOnLane(), t->getPositionOnLane(), t->getSpeed());
-                    if (sVehicles[t->getID()]->route.back() != t->getEdge()) {
-                        sVehicles[t->getID()]->route.push_back(t->getEdge());
-                    }
-                }
-            }
-        }
+        updatePersons();
     }
 
-    // build rtree with senders
-    NamedRTree rt;
-    for (std::map<std::string, MSDevice_BTsender::VehicleInformation*>::const_iterator i = MSDevice_BTsender::sVehicles.begin(); i != MSDevice_BTsender::sVehicles.end(); ++i) {
-        MSDevice_BTsender::VehicleInformation* vi = (*i).second;
+    // move the senders within the grid
+    for (const auto& item : MSDevice_BTsender::sVehicles) {
+        MSDevice_BTsender::VehicleInformation* vi = item.second;
         Boundary b = vi->getBoxBoundary();
         b.grow(POSITION_EPS);
         const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
         const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
-        rt.Insert(cmin, cmax, vi);
+        mySenderGrid.update(cmin, cmax, vi);
     }
 
     // check visibility for all receivers
     OptionsCont& oc = OptionsCont::getOptions();
     bool allRecognitions = oc.getBool("device.btreceiver.all-recognitions");
     bool haveOutput = oc.isSet("bt-output");
+    std::vector<const Named*> surroundingVehicles;
     for (std::map<std::string, MSDevice_BTreceiver::VehicleInformation*>::iterator i = MSDevice_BTreceiver::sVehicles.begin(); i != MSDevice_BTreceiver::sVehicles.end();) {
         // collect surrounding vehicles
         MSDevice_BTreceiver::VehicleInformation* vi = (*i).second;
@@ -184,9 +195,10 @@ MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
         b.grow(vi->range);
         const float cmin[2] = {(float) b.xmin(), (float) b.ymin()};
         const float cmax[2] = {(float) b.xmax(), (float) b.ymax()};
-        std::set<const Named*> surroundingVehicles;
-        Named::StoringVisitor sv(surroundingVehicles);
-        rt.Search(cmin, cmax, sv);
+        surroundingVehicles.clear();
+        mySenderGrid.search(cmin, cmax, surroundingVehicles);
+        // the checks consume random numbers, keep the order of the former set of senders
+        std::sort(surroundingVehicles.begin(), surroundingVehicles.end(), std::less<const Named*>());
 
         // loop over surrounding vehicles, check visibility status
         for (const Named* vehicle : surroundingVehicles) {
@@ -194,7 +206,8 @@ MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
                 // seeing oneself? skip
                 continue;
             }
-            updateVisibility(*vi, *MSDevice_BTsender::sVehicles.find(vehicle->getID())->second);
+            // the grid stores the sender information itself, no need to look it up again
+            updateVisibility(*vi, *const_cast<MSDevice_BTsender::VehicleInformation*>(static_cast<const MSDevice_BTsender::VehicleInformation*>(vehicle)));
         }
 
         if (vi->haveArrived) {
@@ -215,6 +228,7 @@ MSDevice_BTreceiver::BTreceiverUpdate::execute(SUMOTime /*currentTime*/) {
     for (std::map<std::string, MSDevice_BTsender::VehicleInformation*>::iterator i = MSDevice_BTsender::sVehicles.begin(); i != MSDevice_BTsender::sVehicles.end();) {
         MSDevice_BTsender::VehicleInformation* vi = (*i).second;
         if (vi->haveArrived) {
+            mySenderGrid.remove(vi);
             delete vi;
             MSDevice_BTsender::sVehicles.erase(i++);
         } else {
@@ -397,32 +411,51 @@ MSDevice_BTreceiver::~MSDevice_BTreceiver() {
 }
 
 
+MSDevice_BTreceiver::VehicleInformation*
+MSDevice_BTreceiver::getInfo(const SUMOTrafficObject& o) const {
+    if (myInfo != nullptr) {
+        return myInfo;
+    }
+    auto it = sVehicles.find(o.getID());
+    return it == sVehicles.end() ? nullptr : it->second;
+}
+
+
 bool
 MSDevice_BTreceiver::notifyEnter(SUMOTrafficObject& veh, MSMoveReminder::Notification reason, const MSLane* /* enteredLane */) {
-    if (reason == MSMoveReminder::NOTIFICATION_DEPARTED && sVehicles.find(veh.getID()) == sVehicles.end()) {
-        sVehicles[veh.getID()] = new VehicleInformation(veh.getID(), myRange);
-        sVehicles[veh.getID()]->route.push_back(veh.getEdge());
+    if (myInfo == nullptr) {
+        auto it = sVehicles.find(veh.getID());
+        if (it != sVehicles.end()) {
+            myInfo = it->second;
+        } else if (reason == MSMoveReminder::NOTIFICATION_DEPARTED) {
+            myInfo = sVehicles[veh.getID()] = new VehicleInformation(veh.getID(), myRange);
+            myInfo->route.push_back(veh.getEdge());
+        } else {
+            // keep the old behavior of failing hard on unknown vehicles
+            myInfo = sVehicles[veh.getID()];
+        }
     }
-    if (reason == MSMoveReminder::NOTIFICATION_TELEPORT && sVehicles.find(veh.getID()) != sVehicles.end()) {
-        sVehicles[veh.getID()]->amOnNet = true;
+    if (reason == MSMoveReminder::NOTIFICATION_TELEPORT) {
+        myInfo->amOnNet = true;
     }
     if (reason == MSMoveReminder::NOTIFICATION_TELEPORT || reason == MSMoveReminder::NOTIFICATION_JUNCTION) {
-        sVehicles[veh.getID()]->route.push_back(veh.getEdge());
+        myInfo->route.push_back(veh.getEdge());
     }
     const std::string location = MSDevice_BTsender::getLocation(veh);
-    sVehicles[veh.getID()]->updates.push_back(MSDevice_BTsender::VehicleState(veh.getSpeed(), veh.getPosition(), location, veh.getPositionOnLane(), veh.getRoutePosition()));
+    myInfo->updates.push_back(MSDevice_BTsender::VehicleState(veh.getSpeed(), veh.getPosition(), location, veh.getPositionOnLane(), veh.getRoutePosition()));
     return true;
 }
 
 
 bool
 MSDevice_BTreceiver::notifyMove(SUMOTrafficObject& veh, double /* oldPos */, double newPos, double newSpeed) {
-    if (sVehicles.find(veh.getID()) == sVehicles.end()) {
+    VehicleInformation* const info = getInfo(veh);
+    if (info == nullptr) {
         WRITE_WARNINGF(TL("btreceiver: Can not update position of vehicle '%' which is not on the road."), veh.getID());
         return true;
     }
     const std::string location = MSDevice_BTsender::getLocation(veh);
-    sVehicles[veh.getID()]->updates.push_back(MSDevice_BTsender::VehicleState(newSpeed, veh.getPosition(), location, newPos, veh.getRoutePosition()));
+    info->updates.push_back(MSDevice_BTsender::VehicleState(newSpeed, veh.getPosition(), location, newPos, veh.getRoutePosition()));
     return true;
 }
 
@@ -432,18 +465,21 @@ MSDevice_BTreceiver::notifyLeave(SUMOTrafficObject& veh, double /* lastPos */, M
     if (reason < MSMoveReminder::NOTIFICATION_TELEPORT) {
         return true;
     }
-    if (sVehicles.find(veh.getID()) == sVehicles.end()) {
+    VehicleInformation* const info = getInfo(veh);
+    if (info == nullptr) {
         WRITE_WARNINGF(TL("btreceiver: Can not update position of vehicle '%' which is not on the road."), veh.getID());
         return true;
     }
     const std::string location = MSDevice_BTsender::getLocation(veh);
-    sVehicles[veh.getID()]->updates.push_back(MSDevice_BTsender::VehicleState(veh.getSpeed(), veh.getPosition(), location, veh.getPositionOnLane(), veh.getRoutePosition()));
+    info->updates.push_back(MSDevice_BTsender::VehicleState(veh.getSpeed(), veh.getPosition(), location, veh.getPositionOnLane(), veh.getRoutePosition()));
     if (reason == MSMoveReminder::NOTIFICATION_TELEPORT) {
-        sVehicles[veh.getID()]->amOnNet = false;
+        info->amOnNet = false;
     }
     if (reason >= MSMoveReminder::NOTIFICATION_ARRIVED) {
-        sVehicles[veh.getID()]->amOnNet = false;
-        sVehicles[veh.getID()]->haveArrived = true;
+        info->amOnNet = false;
+        info->haveArrived = true;
+        // the information may be deleted by the update from now on
+        myInfo = nullptr;
     }
     return true;
 }
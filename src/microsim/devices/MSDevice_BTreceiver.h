@@ -26,6 +26,7 @@
 #include "MSDevice_BTsender.h"
 #include <utils/common/SUMOTime.h>
 #include <utils/common/Command.h>
+#include <utils/common/NamedGrid.h>
 #include <utils/common/RandHelper.h>
 
 
@@ -206,7 +207,7 @@ protected:
      * @param[in] holder The vehicle that holds this device
      * @param[in] id The ID of the device
      */
-    MSDevice_BTreceiver() {}
+    MSDevice_BTreceiver() : myInfo(nullptr) {}
 
 
     /// @brief Whether the bt-system was already initialised
@@ -286,6 +287,11 @@ protected:
         SUMOTime execute(SUMOTime currentTime);
 
 
+        /** @brief Updates the positions of all equipped persons
+         */
+        void updatePersons();
+
+
         /** @brief Rechecks the visibility for a given receiver/sender pair
          * @param[in] receiver Definition of the receiver vehicle
          * @param[in] sender Definition of the sender vehicle
@@ -339,7 +345,9 @@ protected:
                          bool allRecognitions);
 
 
-
+    private:
+        /// @brief The senders (their VehicleInformation) stored by their surrounding box, updated every step
+        NamedGrid mySenderGrid;
 
     };
 
@@ -352,6 +360,12 @@ protected:
     /// @brief The list of arrived receivers
     static std::map<std::string, VehicleInformation*> sVehicles;
 
+    /// @brief Returns the information of the holder or nullptr if it was not registered
+    VehicleInformation* getInfo(const SUMOTrafficObject& o) const;
+
+    /// @brief The information of the holder (cached to avoid lookups in sVehicles on every move)
+    VehicleInformation* myInfo;
+
 
 
 private:
@@ -435,6 +449,11 @@ public:
      */
     static void buildDevices(MSTransportable& t, std::vector<MSTransportableDevice*>& into);
 
+    /// @brief Destructor.
+    ~MSTransportableDevice_BTreceiver() {
+        sInstances.erase(getHolder().getNumericalID());
+    }
+
     /// @brief return the name for this type of device
     const std::string deviceName() const {
         return "btreceiver";
@@ -461,7 +480,14 @@ private:
      */
     MSTransportableDevice_BTreceiver(MSTransportable& holder, const std::string& id) :
         MSTransportableDevice(holder, id) {
+        sInstances[holder.getNumericalID()] = this;
     }
 
+    /// @brief All currently existing devices of transportables keyed by the numerical id of the holder
+    static std::map<SUMOTrafficObject::NumericalID, MSTransportableDevice_BTreceiver*> sInstances;
+
+    /// for updating the positions of the holders
+    friend class MSDevice_BTreceiver;
+
 };
 
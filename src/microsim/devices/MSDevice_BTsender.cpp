@@ -38,6 +38,7 @@
 // static members
 // ===========================================================================
 std::map<std::string, MSDevice_BTsender::VehicleInformation*> MSDevice_BTsender::sVehicles;
+std::map<SUMOTrafficObject::NumericalID, MSTransportableDevice_BTsender*> MSTransportableDevice_BTsender::sInstances;
 
 
 // ===========================================================================
@@ -81,6 +82,7 @@ MSDevice_BTsender::cleanup() {
     for (i = sVehicles.begin(); i != sVehicles.end(); i++) {
         delete i->second;
     }
+    sVehicles.clear();
 }
 
 
@@ -97,30 +99,49 @@ MSDevice_BTsender::getLocation(const SUMOTrafficObject& o) {
     return o.getLane() == nullptr ? o.getEdge()->getID() : o.getLane()->getID();
 }
 
+MSDevice_BTsender::VehicleInformation*
+MSDevice_BTsender::getInfo(const SUMOTrafficObject& o) const {
+    if (myInfo != nullptr) {
+        return myInfo;
+    }
+    auto it = sVehicles.find(o.getID());
+    return it == sVehicles.end() ? nullptr : it->second;
+}
+
+
 bool
 MSDevice_BTsender::notifyEnter(SUMOTrafficObject& veh, MSMoveReminder::Notification reason, const MSLane* /* enteredLane */) {
-    if (reason == MSMoveReminder::NOTIFICATION_DEPARTED && sVehicles.find(veh.getID()) == sVehicles.end()) {
-        sVehicles[veh.getID()] = new VehicleInformation(veh.getID());
-        sVehicles[veh.getID()]->route.push_back(veh.getEdge());
+    if (myInfo == nullptr) {
+        auto it = sVehicles.find(veh.getID());
+        if (it != sVehicles.end()) {
+            myInfo = it->second;
+        } else if (reason == MSMoveReminder::NOTIFICATION_DEPARTED) {
+            myInfo = sVehicles[veh.getID()] = new VehicleInformation(veh.getID());
+            myInfo->route.push_back(veh.getEdge());
+        } else {
+            // keep the old behavior of failing hard on unknown vehicles
+            myInfo = sVehicles[veh.getID()];
+        }
     }
-    if (reason == MSMoveReminder::NOTIFICATION_TELEPORT && sVehicles.find(veh.getID()) != sVehicles.end()) {
-        sVehicles[veh.getID()]->amOnNet = true;
+    if (reason == MSMoveReminder::NOTIFICATION_TELEPORT) {
+        myInfo->amOnNet = true;
     }
     if (reason == MSMoveReminder::NOTIFICATION_TELEPORT || reason == MSMoveReminder::NOTIFICATION_JUNCTION) {
-        sVehicles[veh.getID()]->route.push_back(veh.getEdge());
+        myInfo->route.push_back(veh.getEdge());
     }
-    sVehicles[veh.getID()]->updates.push_back(VehicleState(veh.getSpeed(), veh.getPosition(), getLocation(veh), veh.getPositionOnLane(), veh.getRoutePosition()));
+    myInfo->updates.push_back(VehicleState(veh.getSpeed(), veh.getPosition(), getLocation(veh), veh.getPositionOnLane(), veh.getRoutePosition()));
     return true;
 }
 
 
 bool
 MSDevice_BTsender::notifyMove(SUMOTrafficObject& veh, double /* oldPos */, double newPos, double newSpeed) {
-    if (sVehicles.find(veh.getID()) == sVehicles.end()) {
+    VehicleInformation* const info = getInfo(veh);
+    if (info == nullptr) {
         WRITE_WARNINGF(TL("btsender: Can not update position of vehicle '%' which is not on the road."), veh.getID());
         return true;
     }
-    sVehicles[veh.getID()]->updates.push_back(VehicleState(newSpeed, veh.getPosition(), getLocation(veh), newPos, veh.getRoutePosition()));
+    info->updates.push_back(VehicleState(newSpeed, veh.getPosition(), getLocation(veh), newPos, veh.getRoutePosition()));
     return true;
 }
 
@@ -130,17 +151,17 @@ MSDevice_BTsender::notifyLeave(SUMOTrafficObject& veh, double /* lastPos */, MSM
     if (reason < MSMoveReminder::NOTIFICATION_TELEPORT) {
         return true;
     }
-    if (sVehicles.find(veh.getID()) == sVehicles.end()) {
+    VehicleInformation* const info = getInfo(veh);
+    if (info == nullptr) {
         WRITE_WARNINGF(TL("btsender: Can not update position of vehicle '%' which is not on the road."), veh.getID());
         return true;
     }
-    sVehicles[veh.getID()]->updates.push_back(VehicleState(veh.getSpeed(), veh.getPosition(), getLocation(veh), veh.getPositionOnLane(), veh.getRoutePosition()));
-    if (reason >= MSMoveReminder::NOTIFICATION_TELEPORT) {
-        sVehicles[veh.getID()]->amOnNet = false;
-    }
+    info->updates.push_back(VehicleState(veh.getSpeed(), veh.getPosition(), getLocation(veh), veh.getPositionOnLane(), veh.getRoutePosition()));
+    info->amOnNet = false;
     if (reason >= MSMoveReminder::NOTIFICATION_ARRIVED) {
-        sVehicles[veh.getID()]->amOnNet = false;
-        sVehicles[veh.getID()]->haveArrived = true;
+        info->haveArrived = true;
+        // the information may be deleted by the receivers from now on
+        myInfo = nullptr;
     }
     return true;
 }
@@ -182,12 +182,18 @@ public:
 
 
 protected:
+    /// @brief Returns the information of the holder or nullptr if it was not registered
+    VehicleInformation* getInfo(const SUMOTrafficObject& o) const;
+
     /// @brief The list of arrived senders
     static std::map<std::string, VehicleInformation*> sVehicles;
 
+    /// @brief The information of the holder (cached to avoid lookups in sVehicles on every move)
+    VehicleInformation* myInfo;
+
     /** @brief Constructor
      */
-    MSDevice_BTsender() { }
+    MSDevice_BTsender() : myInfo(nullptr) { }
 
 
 
@@ -274,6 +280,11 @@ public:
      */
     static void buildDevices(MSTransportable& t, std::vector<MSTransportableDevice*>& into);
 
+    /// @brief Destructor.
+    ~MSTransportableDevice_BTsender() {
+        sInstances.erase(getHolder().getNumericalID());
+    }
+
     /// @brief return the name for this type of device
     const std::string deviceName() const {
         return "btsender";
@@ -300,7 +311,14 @@ private:
      */
     MSTransportableDevice_BTsender(MSTransportable& holder, const std::string& id) :
         MSTransportableDevice(holder, id) {
+        sInstances[holder.getNumericalID()] = this;
     }
 
+    /// @brief All currently existing devices of transportables keyed by the numerical id of the holder
+    static std::map<SUMOTrafficObject::NumericalID, MSTransportableDevice_BTsender*> sInstances;
+
+    /// for updating the positions of the holders
+    friend class MSDevice_BTreceiver;
+
 };
 
@@ -47,7 +47,9 @@ const long long int MSDevice_FCD::myDefaultMask(~(
 // ===========================================================================
 std::set<const MSEdge*> MSDevice_FCD::myEdgeFilter;
 std::vector<PositionVector> MSDevice_FCD::myShape4Filters;
+std::vector<bool> MSDevice_FCD::myEdgeFilterFlags;
 bool MSDevice_FCD::myEdgeFilterInitialized(false);
+bool MSDevice_FCD::myHaveCustomPeriods(false);
 bool MSDevice_FCD::myShapeFilterInitialized(false);
 bool MSDevice_FCD::myShapeFilterDesired(false);
 long long int MSDevice_FCD::myWrittenAttributes(myDefaultMask);
@@ -71,6 +73,12 @@ MSDevice_FCD::insertOptions(OptionsCont& oc) {
 
     oc.doRegister("device.fcd.radius", new Option_Float(0));
     oc.addDescription("device.fcd.radius", "FCD Device", TL("Record objects in a radius around equipped vehicles"));
+
+    oc.doRegister("device.fcd.min-position-change", new Option_Float(0));
+    oc.addDescription("device.fcd.min-position-change", "FCD Device", TL("Record equipped vehicles only if they moved at least FLOAT m since their last record"));
+
+    oc.doRegister("device.fcd.min-speed-change", new Option_Float(0));
+    oc.addDescription("device.fcd.min-speed-change", "FCD Device", TL("Record equipped vehicles only if their speed changed by at least FLOAT m/s since their last record"));
 }
 
 
@@ -89,13 +97,49 @@ MSDevice_FCD::buildVehicleDevices(SUMOVehicle& v, std::vector<MSVehicleDevice*>&
 // MSDevice_FCD-methods
 // ---------------------------------------------------------------------------
 MSDevice_FCD::MSDevice_FCD(SUMOVehicle& holder, const std::string& id) :
-    MSVehicleDevice(holder, id) {
+    MSVehicleDevice(holder, id),
+    myHaveRecord(false),
+    myLastSpeed(0.) {
+    const OptionsCont& oc = OptionsCont::getOptions();
+    const SUMOTime globalPeriod = string2time(oc.getString("device.fcd.period"));
+    myPeriod = getTimeParam(holder, oc, "fcd.period", globalPeriod, false);
+    if (myPeriod != globalPeriod) {
+        myHaveCustomPeriods = true;
+    }
+    myMinPositionChange = getFloatParam(holder, oc, "fcd.min-position-change", 0., false);
+    myMinSpeedChange = getFloatParam(holder, oc, "fcd.min-speed-change", 0., false);
 }
 
 
 MSDevice_FCD::~MSDevice_FCD() {
 }
 
+
+bool
+MSDevice_FCD::checkChange(const Position& pos, double speed) {
+    if (myHaveRecord && (myMinPositionChange > 0 || myMinSpeedChange > 0)) {
+        const bool moved = myMinPositionChange > 0 && pos.distanceTo(myLastPosition) >= myMinPositionChange;
+        const bool accelerated = myMinSpeedChange > 0 && fabs(speed - myLastSpeed) >= myMinSpeedChange;
+        if (!moved && !accelerated) {
+            return false;
+        }
+    }
+    myHaveRecord = true;
+    myLastPosition = pos;
+    myLastSpeed = speed;
+    return true;
+}
+
+
+bool
+MSDevice_FCD::passesEdgeFilter(const MSEdge* edge) {
+    if (myEdgeFilter.empty()) {
+        return true;
+    }
+    const int index = edge->getNumericalID();
+    return index < (int)myEdgeFilterFlags.size() && myEdgeFilterFlags[index];
+}
+
 bool
 MSDevice_FCD::shapeFilter(const SUMOTrafficObject* veh) {
     // lazily build the shape filter in the case where route file is loaded as an additional file
@@ -156,6 +200,12 @@ MSDevice_FCD::initOnce() {
             }
             myEdgeFilter.insert(MSEdge::dictionary(name));
         }
+        myEdgeFilterFlags.assign(MSEdge::getAllEdges().size(), false);
+        for (const MSEdge* const edge : myEdgeFilter) {
+            if (edge != nullptr) {
+                myEdgeFilterFlags[edge->getNumericalID()] = true;
+            }
+        }
     }
     if (oc.isSet("fcd-output.attributes")) {
         myWrittenAttributes = 0;
@@ -186,8 +236,10 @@ MSDevice_FCD::initOnce() {
 void
 MSDevice_FCD::cleanup() {
     myEdgeFilter.clear();
+    myEdgeFilterFlags.clear();
     myShape4Filters.clear();
     myEdgeFilterInitialized = false;
+    myHaveCustomPeriods = false;
     myShapeFilterInitialized = false;
     myShapeFilterDesired = false;
     myWrittenAttributes = myDefaultMask;
@@ -84,6 +84,9 @@ public:
         return myEdgeFilter;
     }
 
+    /// @brief whether the edge passes the edge filter (always true if there is no filter)
+    static bool passesEdgeFilter(const MSEdge* edge);
+
     static long long int getWrittenAttributes() {
         return myWrittenAttributes;
     }
@@ -103,6 +106,27 @@ public:
         return myShapeFilterDesired == true;
     }
 
+    /// @brief whether any device uses a recording period which differs from the global one
+    static bool hasCustomPeriods() {
+        return myHaveCustomPeriods;
+    }
+
+    /// @brief whether the holder shall be recorded at the given time step according to the device period
+    bool isDue(SUMOTime t, SUMOTime begin) const {
+        return myPeriod <= 0 || (t - begin) % myPeriod == 0;
+    }
+
+    /** @brief checks whether the holder changed enough since the last record to be recorded again
+     *
+     * If there are no thresholds for the change of position and speed, every record is accepted.
+     *  Otherwise a record is accepted if one of the thresholds is exceeded. The state of an
+     *  accepted record is remembered for the next comparison.
+     * @param[in] pos The current position of the holder
+     * @param[in] speed The current speed of the holder
+     * @return whether the holder shall be recorded
+     */
+    bool checkChange(const Position& pos, double speed);
+
 private:
     /** @brief Constructor
      *
@@ -112,10 +136,28 @@ private:
     MSDevice_FCD(SUMOVehicle& holder, const std::string& id);
 
 
+    /// @brief the recording period of this device (0 means every step)
+    SUMOTime myPeriod;
+
+    /// @brief the minimum change of position and speed for writing a new record (0 disables the check)
+    double myMinPositionChange;
+    double myMinSpeedChange;
+
+    /// @brief the position and speed of the last record
+    bool myHaveRecord;
+    Position myLastPosition;
+    double myLastSpeed;
+
     /// @brief edge filter for FCD output
     static std::set<const MSEdge*> myEdgeFilter;
     static bool myEdgeFilterInitialized;
 
+    /// @brief the edge filter indexed by numerical edge id
+    static std::vector<bool> myEdgeFilterFlags;
+
+    /// @brief whether any device has a period which differs from the global one
+    static bool myHaveCustomPeriods;
+
     /// @brief polygon spatial filter for FCD output
     static std::vector<PositionVector> myShape4Filters;
     static bool myShapeFilterInitialized;
@@ -44,6 +44,8 @@
 #include <microsim/MSEdge.h>
 #include <microsim/MSVehicle.h>
 #include <microsim/MSVehicleControl.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/MSGlobals.h>
 #include <microsim/MSJunctionControl.h>
 #include <microsim/lcmodels/MSAbstractLaneChangeModel.h>
 #include "MSDevice_SSM.h"
@@ -483,6 +485,53 @@ MSDevice_SSM::updateAndWriteOutput() {
     }
 }
 
+void
+MSDevice_SSM::updateAndWriteAllOutputs() {
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1 && myInstances->size() > 1) {
+        MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+        std::vector<MSDevice_SSM*> onRoad;
+        for (MSDevice_SSM* dev : *myInstances) {
+            if (dev->myHolder.isOnRoad()) {
+                onRoad.push_back(dev);
+            }
+        }
+        // a few chunks per thread to balance the load without creating a task per device
+        const int numChunks = MIN2((int)onRoad.size(), 4 * threadPool.size());
+        for (int i = 0; i < numChunks; i++) {
+            threadPool.add(new UpdateTask(onRoad.begin() + i * onRoad.size() / numChunks,
+                                          onRoad.begin() + (i + 1) * onRoad.size() / numChunks), i % threadPool.size());
+        }
+        threadPool.waitAll();
+        for (MSDevice_SSM* dev : *myInstances) {
+            if (dev->myHolder.isOnRoad()) {
+                dev->flushConflicts();
+            } else {
+                dev->resetEncounters();
+                dev->flushConflicts(true);
+            }
+        }
+        return;
+    }
+#endif
+#endif
+    for (MSDevice_SSM* dev : *myInstances) {
+        dev->updateAndWriteOutput();
+    }
+}
+
+
+#ifdef HAVE_FOX
+void
+MSDevice_SSM::UpdateTask::run(MFXWorkerThread* /*context*/) {
+    for (std::vector<MSDevice_SSM*>::const_iterator it = myBegin; it != myEnd; ++it) {
+        (*it)->update();
+    }
+}
+#endif
+
+
 void
 MSDevice_SSM::update() {
 #ifdef DEBUG_SSM
@@ -501,7 +550,10 @@ MSDevice_SSM::update() {
         scan = myEdgeFilter.find(egoEdge) != myEdgeFilter.end();
     }
     if (scan) {
-        findSurroundingVehicles(*myHolderMS, myRange, foes);
+        if (!myScanPlan.isValidFor(*myHolderMS)) {
+            buildScanPlan(*myHolderMS, myRange, myScanPlan);
+        }
+        collectFoes(*myHolderMS, myScanPlan, foes);
     }
 
 #ifdef DEBUG_SSM
@@ -3038,6 +3090,27 @@ MSDevice_SSM::notifyMove(SUMOTrafficObject& veh, double /* oldPos */,
 
 void
 MSDevice_SSM::findSurroundingVehicles(const MSVehicle& veh, double range, FoeInfoMap& foeCollector) {
+    ScanPlan plan;
+    buildScanPlan(veh, range, plan);
+    collectFoes(veh, plan, foeCollector);
+}
+
+
+bool
+MSDevice_SSM::ScanPlan::isValidFor(const MSVehicle& veh) const {
+    return veh.getLane() == lane && veh.getPositionOnLane() == pos && veh.getLength() == egoLength
+           && veh.getLaneChangeModel().isOpposite() == opposite && veh.getBestLanesContinuation() == bestLanes;
+}
+
+
+void
+MSDevice_SSM::buildScanPlan(const MSVehicle& veh, double range, ScanPlan& plan) {
+    plan.lane = veh.getLane();
+    plan.pos = veh.getPositionOnLane();
+    plan.egoLength = veh.getLength();
+    plan.opposite = veh.getLaneChangeModel().isOpposite();
+    plan.bestLanes = veh.getBestLanesContinuation();
+    plan.scans.clear();
     if (!veh.isOnRoad()) {
         return;
     }
@@ -3065,7 +3138,7 @@ MSDevice_SSM::findSurroundingVehicles(const MSVehicle& veh, double range, FoeInf
     //assert(*edgeIter != 0);
 
     // Best continuation lanes for the ego vehicle
-    std::vector<MSLane*> egoBestLanes = veh.getBestLanesContinuation();
+    std::vector<MSLane*> egoBestLanes = plan.bestLanes;
 
     // current lane in loop below
     const MSLane* lane = veh.getLane();
@@ -3125,7 +3198,7 @@ MSDevice_SSM::findSurroundingVehicles(const MSVehicle& veh, double range, FoeInf
 
         const MSJunction* junction = edge->getToJunction();
         // Collect vehicles on the junction
-        getVehiclesOnJunction(junction, lane, distToConflictLane, lane, foeCollector, seenLanes);
+        getVehiclesOnJunction(junction, lane, distToConflictLane, lane, plan, seenLanes);
         routeJunctions.insert(junction);
 
         // Collect vehicles on incoming edges.
@@ -3244,7 +3317,7 @@ MSDevice_SSM::findSurroundingVehicles(const MSVehicle& veh, double range, FoeInf
 
                 if (seenLanes.count(lane) == 0) {
                     // Collect vehicles on the junction, if it wasn't considered already
-                    getVehiclesOnJunction(junction, lane, distToConflictLane, lane, foeCollector, seenLanes);
+                    getVehiclesOnJunction(junction, lane, distToConflictLane, lane, plan, seenLanes);
                     routeJunctions.insert(junction);
 
                     // Collect vehicles on incoming edges (except the last edge, where we already collected). Use full range.
@@ -3304,7 +3377,45 @@ MSDevice_SSM::findSurroundingVehicles(const MSVehicle& veh, double range, FoeInf
 
     // Scan upstream branches from collected starting points
     for (UpstreamScanStartInfo& i : upstreamScanStartPositions) {
-        getUpstreamVehicles(i, foeCollector, seenLanes, routeJunctions);
+        getUpstreamVehicles(i, plan, seenLanes, routeJunctions);
+    }
+#ifdef DEBUG_SSM_SURROUNDING
+    gDebugFlag3 = false;
+#endif
+}
+
+
+void
+MSDevice_SSM::collectFoes(const MSVehicle& veh, const ScanPlan& plan, FoeInfoMap& foeCollector) {
+#ifdef DEBUG_SSM_SURROUNDING
+    gDebugFlag3 = DEBUG_COND_FIND(veh);
+#endif
+    for (const LaneScan& scan : plan.scans) {
+        for (MSVehicle* const foe : scan.lane->getVehiclesSecure()) {
+            FoeInfoMap::iterator it = foeCollector.find(foe);
+            if (scan.overwrite) {
+                // Add FoeInfos (XXX: for some situations, a vehicle may be collected twice. Then the later finding overwrites the earlier in foeCollector.
+                // This could lead to neglecting a conflict when determining foeConflictLane later.) -> TODO: test with twice intersecting routes
+                if (it != foeCollector.end()) {
+                    delete it->second;
+                }
+            } else if (it != foeCollector.end()) {
+                // vehicle already recognized, earlier recognized conflict has priority
+                continue;
+            } else if (foe->getPositionOnLane() - foe->getLength() > scan.maxPos || foe->getPositionOnLane() < scan.minPos) {
+                continue;
+            }
+            FoeInfo* c = new FoeInfo(); // c is deleted in updateEncounter()
+            c->egoConflictLane = scan.egoConflictLane;
+            c->egoDistToConflictLane = scan.egoDistToConflictLane;
+            foeCollector[foe] = c;
+#ifdef DEBUG_SSM_SURROUNDING
+            if (gDebugFlag3) {
+                std::cout << "\t" << foe->getID() << " on lane '" << scan.lane->getID() << "' egoConflictLane=" << Named::getIDSecure(scan.egoConflictLane) << "\n";
+            }
+#endif
+        }
+        scan.lane->releaseVehicles();
     }
 
 #ifdef DEBUG_SSM_SURROUNDING
@@ -3313,6 +3424,7 @@ MSDevice_SSM::findSurroundingVehicles(const MSVehicle& veh, double range, FoeInf
             std::cout << "    foe " << foeInfo.first->getID() << " conflict at " << foeInfo.second->egoConflictLane->getID() << " egoDist " << foeInfo.second->egoDistToConflictLane << std::endl;
         }
     }
+    gDebugFlag3 = false;
 #endif
 
     // remove ego vehicle
@@ -3321,12 +3433,11 @@ MSDevice_SSM::findSurroundingVehicles(const MSVehicle& veh, double range, FoeInf
         delete it->second;
         foeCollector.erase(it);
     }
-    gDebugFlag3 = false;
 }
 
 
 void
-MSDevice_SSM::getUpstreamVehicles(const UpstreamScanStartInfo& scanStart, FoeInfoMap& foeCollector, std::set<const MSLane*>& seenLanes, const std::set<const MSJunction*>& routeJunctions) {
+MSDevice_SSM::getUpstreamVehicles(const UpstreamScanStartInfo& scanStart, ScanPlan& plan, std::set<const MSLane*>& seenLanes, const std::set<const MSJunction*>& routeJunctions) {
 #ifdef DEBUG_SSM_SURROUNDING
     if (gDebugFlag3) {
         std::cout << SIMTIME << " getUpstreamVehicles() for edge '" << scanStart.edge->getID() << "'"
@@ -3344,32 +3455,7 @@ MSDevice_SSM::getUpstreamVehicles(const UpstreamScanStartInfo& scanStart, FoeInf
         if (seenLanes.find(lane) != seenLanes.end()) {
             return;
         }
-        int foundCount = 0;
-        for (MSVehicle* const veh : lane->getVehiclesSecure()) {
-            if (foeCollector.find(veh) != foeCollector.end()) {
-                // vehicle already recognized, earlier recognized conflict has priority
-                continue;
-            }
-            if (veh->getPositionOnLane() - veh->getLength() <= scanStart.pos && veh->getPositionOnLane() >= scanStart.pos - scanStart.range) {
-#ifdef DEBUG_SSM_SURROUNDING
-                if (gDebugFlag3) {
-                    std::cout << "\t" << veh->getID() << "\n";
-                }
-#endif
-                FoeInfo* c = new FoeInfo(); // c is deleted in updateEncounter()
-                c->egoDistToConflictLane = scanStart.egoDistToConflictLane;
-                c->egoConflictLane = scanStart.egoConflictLane;
-                foeCollector[veh] = c;
-                foundCount++;
-            }
-        }
-        lane->releaseVehicles();
-
-#ifdef DEBUG_SSM_SURROUNDING
-        if (gDebugFlag3 && foundCount > 0) {
-            std::cout << "\t" << lane->getID() << ": Found " << foundCount << "\n";
-        }
-#endif
+        plan.scans.push_back(LaneScan(lane, scanStart.pos - scanStart.range, scanStart.pos, false, scanStart.egoDistToConflictLane, scanStart.egoConflictLane));
         seenLanes.insert(lane);
     }
 
@@ -3408,7 +3494,7 @@ MSDevice_SSM::getUpstreamVehicles(const UpstreamScanStartInfo& scanStart, FoeInf
         // run vehicle collection for all incoming connections
         for (MSLane* const internalLane : junction->getInternalLanes()) {
             if (internalLane->getEdge().getSuccessors()[0]->getID() == scanStart.edge->getID()) {
-                getVehiclesOnJunction(junction, internalLane, scanStart.egoDistToConflictLane, scanStart.egoConflictLane, foeCollector, seenLanes);
+                getVehiclesOnJunction(junction, internalLane, scanStart.egoDistToConflictLane, scanStart.egoConflictLane, plan, seenLanes);
                 incomingEdgeCount++;
             }
         }
@@ -3443,53 +3529,28 @@ MSDevice_SSM::getUpstreamVehicles(const UpstreamScanStartInfo& scanStart, FoeInf
             }
             // account for vehicles on the predecessor edge
             UpstreamScanStartInfo nextInfo(inEdge, inEdge->getLength(), remainingRange - distOnJunction, scanStart.egoDistToConflictLane, scanStart.egoConflictLane);
-            getUpstreamVehicles(nextInfo, foeCollector, seenLanes, routeJunctions);
+            getUpstreamVehicles(nextInfo, plan, seenLanes, routeJunctions);
         }
     }
 }
 
 
 void
-MSDevice_SSM::getVehiclesOnJunction(const MSJunction* junction, const MSLane* const egoJunctionLane, double egoDistToConflictLane, const MSLane* const egoConflictLane, FoeInfoMap& foeCollector, std::set<const MSLane*>& seenLanes) {
+MSDevice_SSM::getVehiclesOnJunction(const MSJunction* junction, const MSLane* const egoJunctionLane, double egoDistToConflictLane, const MSLane* const egoConflictLane, ScanPlan& plan, std::set<const MSLane*>& seenLanes) {
 #ifdef DEBUG_SSM_SURROUNDING
     if (gDebugFlag3) {
         std::cout << SIMTIME << " getVehiclesOnJunction() for junction '" << junction->getID()
                   << "' egoJunctionLane=" << Named::getIDSecure(egoJunctionLane)
-                  << "\nFound vehicles:"
                   << std::endl;
     }
 #endif
-    // FoeInfo creation
-    auto collectFoeInfos = [&](const MSLane::VehCont & vehicles) {
-        for (MSVehicle* const veh : vehicles) {
-            if (foeCollector.find(veh) != foeCollector.end()) {
-                delete foeCollector[veh];
-            }
-            FoeInfo* c = new FoeInfo();
-            c->egoConflictLane = egoConflictLane;
-            c->egoDistToConflictLane = egoDistToConflictLane;
-            foeCollector[veh] = c;
-#ifdef DEBUG_SSM_SURROUNDING
-            if (gDebugFlag3) {
-                std::cout << "\t" << veh->getID() << " egoConflictLane=" << Named::getIDSecure(egoConflictLane) << "\n";
-            }
-#endif
-        }
-    };
-
     // stop condition
     if (seenLanes.find(egoJunctionLane) != seenLanes.end() || egoJunctionLane->getEdge().isCrossing()) {
         return;
     }
 
     auto scanInternalLane = [&](const MSLane * lane) {
-        const MSLane::VehCont& vehicles = lane->getVehiclesSecure();
-
-        // Add FoeInfos (XXX: for some situations, a vehicle may be collected twice. Then the later finding overwrites the earlier in foeCollector.
-        // This could lead to neglecting a conflict when determining foeConflictLane later.) -> TODO: test with twice intersecting routes
-        collectFoeInfos(vehicles);
-
-        lane->releaseVehicles();
+        plan.scans.push_back(LaneScan(lane, 0., 0., true, egoDistToConflictLane, egoConflictLane));
 
         // check additional internal link upstream in the same junction
         // TODO: getEntryLink returns nullptr
@@ -3499,11 +3560,8 @@ MSDevice_SSM::getVehiclesOnJunction(const MSJunction* junction, const MSLane* co
             // This code must be modified, if more than two-piece internal lanes are allowed. Thus, assert:
             assert(!lane->getEntryLink()->fromInternalLane());
 
-            // collect vehicles
-            const MSLane::VehCont& vehicles2 = lane->getVehiclesSecure();
             // Add FoeInfos for the first internal lane
-            collectFoeInfos(vehicles2);
-            lane->releaseVehicles();
+            plan.scans.push_back(LaneScan(lane, 0., 0., true, egoDistToConflictLane, egoConflictLane));
         }
 
 
@@ -3514,11 +3572,8 @@ MSDevice_SSM::getVehiclesOnJunction(const MSJunction* junction, const MSLane* co
             // This code must be modified, if more than two-piece internal lanes are allowed. Thus, assert:
             assert(lane->getLinkCont().size() == 0 || lane->getLinkCont()[0]->getViaLane() == 0);
 
-            // collect vehicles
-            const MSLane::VehCont& vehicles2 = lane->getVehiclesSecure();
-            // Add FoeInfos for the first internal lane
-            collectFoeInfos(vehicles2);
-            lane->releaseVehicles();
+            // Add FoeInfos for the second internal lane
+            plan.scans.push_back(LaneScan(lane, 0., 0., true, egoDistToConflictLane, egoConflictLane));
         }
 
     };
@@ -3537,12 +3592,6 @@ MSDevice_SSM::getVehiclesOnJunction(const MSJunction* junction, const MSLane* co
         }
     }
     scanInternalLane(egoJunctionLane);
-
-#ifdef DEBUG_SSM_SURROUNDING
-    if (gDebugFlag3) {
-        std::cout << std::endl;
-    }
-#endif
 }
 
 
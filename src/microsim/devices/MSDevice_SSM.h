@@ -29,6 +29,9 @@
 #include <utils/common/SUMOTime.h>
 #include <utils/iodevices/OutputDevice_File.h>
 #include <utils/geom/Position.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -356,6 +359,35 @@ private:
         const MSLane* egoConflictLane;
     };
 
+    /// @brief A single lane visit of the surrounding vehicle scan
+    /// The lanes to visit only depend on the network and the ego's position, thus they are determined
+    /// before collecting the vehicles and can be reused as long as the ego does not move.
+    struct LaneScan {
+        LaneScan(const MSLane* lane, double minPos, double maxPos, bool overwrite, double egoDistToConflictLane, const MSLane* egoConflictLane) :
+            lane(lane), minPos(minPos), maxPos(maxPos), overwrite(overwrite), egoDistToConflictLane(egoDistToConflictLane), egoConflictLane(egoConflictLane) {};
+        const MSLane* lane;
+        /// @brief vehicles are collected if their front is beyond minPos and their back before maxPos (only for upstream scans)
+        double minPos;
+        double maxPos;
+        /// @brief whether vehicles on the whole lane are collected, replacing earlier findings (junction scans)
+        bool overwrite;
+        double egoDistToConflictLane;
+        const MSLane* egoConflictLane;
+    };
+
+    /// @brief The sequence of lane visits for an ego vehicle and the ego state it was computed for
+    struct ScanPlan {
+        ScanPlan() : lane(nullptr), pos(INVALID_DOUBLE), egoLength(INVALID_DOUBLE), opposite(false) {};
+        /// @brief whether the plan was computed for the current state of the given vehicle
+        bool isValidFor(const MSVehicle& veh) const;
+        const MSLane* lane;
+        double pos;
+        double egoLength;
+        bool opposite;
+        std::vector<MSLane*> bestLanes;
+        std::vector<LaneScan> scans;
+    };
+
     typedef std::priority_queue<Encounter*, std::vector<Encounter*>, Encounter::compare> EncounterQueue;
     typedef std::vector<Encounter*> EncounterVector;
     typedef std::map<const MSVehicle*, FoeInfo*> FoeInfoMap;
@@ -396,6 +428,15 @@ public:
      */
     void updateAndWriteOutput();
 
+    /** @brief Calls updateAndWriteOutput() for all devices.
+     *
+     * If the simulation runs with multiple threads, the encounter updates of the
+     *  devices are computed in parallel (they only read the simulation state and
+     *  modify device local data). The output is written afterwards in the order
+     *  of the device instances.
+     */
+    static void updateAndWriteAllOutputs();
+
     /// @brief try to retrieve the given parameter from this device. Throw exception for unsupported key
     std::string getParameter(const std::string& key) const;
 
@@ -435,13 +476,25 @@ public:
      */
     static void findSurroundingVehicles(const MSVehicle& veh, double range, FoeInfoMap& foeCollector);
 
-    /** @brief Collects all vehicles within range 'range' upstream of the position 'pos' on the edge 'edge' into foeCollector
+    /** @brief Determines the lanes to scan for surrounding vehicles of the given vehicle (@see findSurroundingVehicles)
+     *
+     * @param veh   The ego vehicle, that forms the origin for the scan
+     * @param range The range to be scanned.
+     * @param[out] plan The lane visits in the order they have to be performed
+     */
+    static void buildScanPlan(const MSVehicle& veh, double range, ScanPlan& plan);
+
+    /** @brief Collects the vehicles currently present on the lanes of the given plan into foeCollector
+     */
+    static void collectFoes(const MSVehicle& veh, const ScanPlan& plan, FoeInfoMap& foeCollector);
+
+    /** @brief Adds the lanes within range 'range' upstream of the position 'pos' on the edge 'edge' to the plan
      */
-    static void getUpstreamVehicles(const UpstreamScanStartInfo& scanStart, FoeInfoMap& foeCollector, std::set<const MSLane*>& seenLanes, const std::set<const MSJunction*>& routeJunctions);
+    static void getUpstreamVehicles(const UpstreamScanStartInfo& scanStart, ScanPlan& plan, std::set<const MSLane*>& seenLanes, const std::set<const MSJunction*>& routeJunctions);
 
-    /** @brief Collects all vehicles on the junction into foeCollector
+    /** @brief Adds the lanes on the junction to the plan
      */
-    static void getVehiclesOnJunction(const MSJunction*, const MSLane* egoJunctionLane, double egoDistToConflictLane, const MSLane* const egoConflictLane, FoeInfoMap& foeCollector, std::set<const MSLane*>& seenLanes);
+    static void getVehiclesOnJunction(const MSJunction*, const MSLane* egoJunctionLane, double egoDistToConflictLane, const MSLane* const egoConflictLane, ScanPlan& plan, std::set<const MSLane*>& seenLanes);
 
 
     /// @name Methods called on vehicle movement / state change, overwriting MSDevice
@@ -737,6 +790,9 @@ private:
     MSVehicle* myHolderMS;
     /// @}
 
+    /// @brief The lanes scanned in the last update, reused while the holder stays at the same place
+    ScanPlan myScanPlan;
+
 
     /// @name Internal storage for encounters/conflicts
     /// @{
@@ -801,6 +857,26 @@ private:
 
 
 
+#ifdef HAVE_FOX
+    /**
+     * @class UpdateTask
+     * @brief the task which updates the encounters of a range of devices
+     */
+    class UpdateTask : public MFXWorkerThread::Task {
+    public:
+        UpdateTask(std::vector<MSDevice_SSM*>::const_iterator begin, std::vector<MSDevice_SSM*>::const_iterator end)
+            : myBegin(begin), myEnd(end) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const std::vector<MSDevice_SSM*>::const_iterator myBegin;
+        const std::vector<MSDevice_SSM*>::const_iterator myEnd;
+    private:
+        /// @brief Invalidated assignment operator.
+        UpdateTask& operator=(const UpdateTask&) = delete;
+    };
+#endif
+
+
 private:
     /// @brief Invalidated copy constructor.
     MSDevice_SSM(const MSDevice_SSM&);
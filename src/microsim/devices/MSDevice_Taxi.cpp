@@ -37,6 +37,7 @@
 #include "MSDispatch.h"
 #include "MSDispatch_Greedy.h"
 #include "MSDispatch_GreedyShared.h"
+#include "MSDispatch_Pooling.h"
 #include "MSDispatch_RouteExtension.h"
 #include "MSDispatch_TraCI.h"
 
@@ -79,7 +80,7 @@ MSDevice_Taxi::insertOptions(OptionsCont& oc) {
     insertDefaultAssignmentOptions("taxi", "Taxi Device", oc);
 
     oc.doRegister("device.taxi.dispatch-algorithm", new Option_String("greedy"));
-    oc.addDescription("device.taxi.dispatch-algorithm", "Taxi Device", TL("The dispatch algorithm [greedy|greedyClosest|greedyShared|routeExtension|traci]"));
+    oc.addDescription("device.taxi.dispatch-algorithm", "Taxi Device", TL("The dispatch algorithm [greedy|greedyClosest|greedyShared|routeExtension|matching|pooling|traci]"));
 
     oc.doRegister("device.taxi.dispatch-algorithm.output", new Option_FileName());
     oc.addDescription("device.taxi.dispatch-algorithm.output", "Taxi Device", TL("Write information from the dispatch algorithm to FILE"));
@@ -141,6 +142,10 @@ MSDevice_Taxi::initDispatch() {
         myDispatcher = new MSDispatch_GreedyShared(params.getParametersMap());
     } else if (algo == "routeExtension") {
         myDispatcher = new MSDispatch_RouteExtension(params.getParametersMap());
+    } else if (algo == "matching") {
+        myDispatcher = new MSDispatch_Matching(params.getParametersMap());
+    } else if (algo == "pooling") {
+        myDispatcher = new MSDispatch_Pooling(params.getParametersMap());
     } else if (algo == "traci") {
         myDispatcher = new MSDispatch_TraCI(params.getParametersMap());
     } else {
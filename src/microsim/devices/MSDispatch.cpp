@@ -265,7 +265,7 @@ MSDispatch::computeDetourTime(SUMOTime t, SUMOTime viaTime, const MSDevice_Taxi*
 
 
 int
-MSDispatch::remainingCapacity(const MSDevice_Taxi* taxi, const Reservation* res) {
+MSDispatch::remainingCapacity(const MSDevice_Taxi* taxi, const Reservation* res) const {
     assert(res->persons.size() > 0);
     return ((*res->persons.begin())->isPerson()
             ? taxi->getHolder().getVehicleType().getPersonCapacity()
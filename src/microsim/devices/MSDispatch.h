@@ -173,7 +173,7 @@ protected:
     void servedReservation(const Reservation* res);
 
     /// @brief whether the given taxi has sufficient capacity to serve the reservation
-    int remainingCapacity(const MSDevice_Taxi* taxi, const Reservation* res);
+    int remainingCapacity(const MSDevice_Taxi* taxi, const Reservation* res) const;
 
     // reservations that are currently being served (could still be used during re-dispatch)
     std::set<const Reservation*> myRunningReservations;
@@ -19,9 +19,14 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <algorithm>
 #include <limits>
+#include <queue>
+#include <tuple>
+#include <utils/common/NamedGrid.h>
 #include <microsim/MSNet.h>
 #include <microsim/MSEdge.h>
+#include <microsim/MSLane.h>
 #include <microsim/transportables/MSTransportable.h>
 #include "MSRoutingEngine.h"
 #include "MSDispatch_GreedyShared.h"
@@ -32,6 +37,9 @@
 //#define DEBUG_COND2(obj) (obj->getID() == "p0")
 #define DEBUG_COND2(obj) (true)
 
+// the cell size of the grid for finding the closest taxis
+#define TAXI_GRID_CELLSIZE 1000.
+
 // ===========================================================================
 // MSDispatch_Greedy methods
 // ===========================================================================
@@ -122,6 +130,67 @@ MSDispatch_Greedy::dispatch(MSDevice_Taxi* taxi, std::vector<Reservation*>::iter
 }
 
 
+std::vector<std::vector<int> >
+MSDispatch_Greedy::findCandidates(const std::vector<MSDevice_Taxi*>& taxis, const std::vector<Reservation*>& reservations,
+                                  const int maxCandidates) const {
+    std::vector<std::vector<int> > result(reservations.size());
+    NamedGrid grid(TAXI_GRID_CELLSIZE);
+    std::map<const Named*, int> taxiIndex;
+    if (maxCandidates > 0 && maxCandidates < (int)taxis.size()) {
+        for (int j = 0; j < (int)taxis.size(); j++) {
+            const Position& pos = taxis[j]->getHolder().getPosition();
+            const float cmin[2] = {(float) pos.x(), (float) pos.y()};
+            grid.update(cmin, cmin, taxis[j]);
+            taxiIndex[taxis[j]] = j;
+        }
+    }
+    for (int i = 0; i < (int)reservations.size(); i++) {
+        const Reservation* const res = reservations[i];
+        if (grid.size() == 0) {
+            for (int j = 0; j < (int)taxis.size(); j++) {
+                if (remainingCapacity(taxis[j], res) >= 0 && taxis[j]->compatibleLine(res)) {
+                    result[i].push_back(j);
+                }
+            }
+            continue;
+        }
+        // search with growing radius until enough compatible taxis are within the (circular) radius
+        const Position resPos = res->from->getLanes().front()->geometryPositionAtOffset(res->fromPos);
+        std::vector<std::pair<double, int> > closest;
+        for (double radius = TAXI_GRID_CELLSIZE;; radius *= 2) {
+            const float cmin[2] = {(float)(resPos.x() - radius), (float)(resPos.y() - radius)};
+            const float cmax[2] = {(float)(resPos.x() + radius), (float)(resPos.y() + radius)};
+            std::vector<const Named*> found;
+            grid.search(cmin, cmax, found);
+            closest.clear();
+            int numWithin = 0;
+            for (const Named* const o : found) {
+                const int j = taxiIndex[o];
+                if (remainingCapacity(taxis[j], res) >= 0 && taxis[j]->compatibleLine(res)) {
+                    const double dist = taxis[j]->getHolder().getPosition().distanceTo2D(resPos);
+                    closest.push_back(std::make_pair(dist, j));
+                    if (dist <= radius) {
+                        numWithin++;
+                    }
+                }
+            }
+            if (numWithin >= maxCandidates || (int)found.size() == grid.size()) {
+                break;
+            }
+        }
+        if ((int)closest.size() > maxCandidates) {
+            std::nth_element(closest.begin(), closest.begin() + maxCandidates, closest.end());
+            closest.resize(maxCandidates);
+        }
+        for (const auto& item : closest) {
+            result[i].push_back(item.second);
+        }
+        std::sort(result[i].begin(), result[i].end());
+    }
+    return result;
+}
+
+
 // ===========================================================================
 // MSDispatch_GreedyClosest methods
 // ===========================================================================
@@ -148,51 +217,129 @@ MSDispatch_GreedyClosest::computeDispatch(SUMOTime now, const std::vector<MSDevi
             activeReservations.push_back(res);
         }
     }
-    while (available.size() > 0 && activeReservations.size() > 0) {
-        Reservation* closest = nullptr;
-        MSDevice_Taxi* closestTaxi = nullptr;
-        SUMOTime closestTime = SUMOTime_MAX;
-        for (Reservation* res : activeReservations) {
-            SUMOTime recheck = SUMOTime_MAX;
-            for (auto* taxi : available) {
-                if (remainingCapacity(taxi, res) < 0 || !taxi->compatibleLine(res)) {
-                    continue;
-                }
-                SUMOTime travelTime = computePickupTime(now, taxi, *res, router);
-                SUMOTime taxiWait = res->pickupTime - (now + travelTime);
+    if (available.size() > 0 && activeReservations.size() > 0) {
+        // the traveltimes do not change during dispatch so they are computed only once
+        const std::vector<MSDevice_Taxi*> taxis(available.begin(), available.end());
+        const std::vector<Reservation*> reservations = activeReservations;
+        CandidateTimes candidates;
+        computeCandidateTimes(now, taxis, reservations, router, candidates);
+        // (traveltime, reservation index, taxi index), sorting yields the same tie breaking as searching the closest pair each round
+        std::vector<std::tuple<SUMOTime, int, int> > pairs;
+        for (int i = 0; i < (int)reservations.size(); i++) {
+            for (const auto& item : candidates[i]) {
+                const SUMOTime travelTime = item.second;
+                SUMOTime taxiWait = reservations[i]->pickupTime - (now + travelTime);
 #ifdef DEBUG_TRAVELTIME
-                if (DEBUG_COND2(person)) std::cout << SIMTIME << " taxi=" << taxi->getHolder().getID() << " person=" << toString(res->persons)
+                if (DEBUG_COND2(person)) std::cout << SIMTIME << " taxi=" << taxis[item.first]->getHolder().getID() << " person=" << toString(reservations[i]->persons)
                                                        << " traveltime=" << time2string(travelTime)
-                                                       << " pickupTime=" << time2string(res->pickupTime)
+                                                       << " pickupTime=" << time2string(reservations[i]->pickupTime)
                                                        << " taxiWait=" << time2string(taxiWait) << "\n";
 #endif
-                if (travelTime < closestTime) {
-                    if (taxiWait < myMaximumWaitingTime) {
-                        closestTime = travelTime;
-                        closest = res;
-                        closestTaxi = taxi;
-                    } else {
-                        recheck = MIN2(recheck,
-                                       MAX2(now + myRecheckTime, res->pickupTime - closestTime - myRecheckSafety));
-                    }
+                if (taxiWait < myMaximumWaitingTime) {
+                    pairs.push_back(std::make_tuple(travelTime, i, item.first));
                 }
             }
-            /*
-            if (closestTaxi == nullptr) {
-                // all taxis would arrive to early. postpone recheck
-                res.recheck = recheck;
+        }
+        std::sort(pairs.begin(), pairs.end());
+        std::vector<bool> resDone(reservations.size(), false);
+        std::vector<bool> taxiDone(taxis.size(), false);
+        for (const auto& pair : pairs) {
+            const int resIndex = std::get<1>(pair);
+            const int taxiIndex = std::get<2>(pair);
+            if (resDone[resIndex] || taxiDone[taxiIndex]) {
+                continue;
+            }
+            resDone[resIndex] = true;
+            taxiDone[taxiIndex] = true;
+            auto closeIt = std::find(activeReservations.begin(), activeReservations.end(), reservations[resIndex]);
+            numDispatched += dispatch(taxis[taxiIndex], closeIt, router, activeReservations);
+            available.erase(taxis[taxiIndex]);
+            if (available.size() == 0 || activeReservations.size() == 0) {
+                break;
             }
-            */
         }
-        if (closestTaxi != nullptr) {
-            auto closeIt = std::find(activeReservations.begin(), activeReservations.end(), closest);
-            numDispatched += dispatch(closestTaxi, closeIt, router, activeReservations);
-            available.erase(closestTaxi);
-        } else {
-            // all current reservations are too early or too big
-            havePostponed = true;
-            break;
+        // all remaining reservations are too early or too big
+        havePostponed = available.size() > 0 && activeReservations.size() > 0;
+    }
+    // check if any taxis are able to service the remaining requests
+    myHasServableReservations = getReservations().size() > 0 && (available.size() < fleet.size() || havePostponed || numDispatched > 0);
+#ifdef DEBUG_SERVABLE
+    std::cout << SIMTIME << " reservations=" << getReservations().size() << " avail=" << available.size()
+              << " fleet=" << fleet.size() << " postponed=" << havePostponed << " dispatched=" << numDispatched << "\n";
+#endif
+}
+
+
+void
+MSDispatch_GreedyClosest::computeCandidateTimes(SUMOTime now, const std::vector<MSDevice_Taxi*>& taxis, const std::vector<Reservation*>& reservations,
+        SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, CandidateTimes& into) {
+    // the candidate reservations of each taxi
+    std::vector<std::vector<int> > taxiCandidates(taxis.size());
+    const std::vector<std::vector<int> > resCandidates = findCandidates(taxis, reservations, myMaxCandidates);
+    for (int i = 0; i < (int)reservations.size(); i++) {
+        for (const int j : resCandidates[i]) {
+            taxiCandidates[j].push_back(i);
+        }
+    }
+    into.clear();
+    into.resize(reservations.size());
+    router.setAutoBulkMode(true);
+    for (int j = 0; j < (int)taxis.size(); j++) {
+        for (const int i : taxiCandidates[j]) {
+            into[i].push_back(std::make_pair(j, computePickupTime(now, taxis[j], *reservations[i], router)));
+        }
+    }
+    router.setAutoBulkMode(false);
+}
+
+
+// ===========================================================================
+// MSDispatch_Matching methods
+// ===========================================================================
+
+void
+MSDispatch_Matching::computeDispatch(SUMOTime now, const std::vector<MSDevice_Taxi*>& fleet) {
+    bool havePostponed = false;
+    int numDispatched = 0;
+    // find available vehicles
+    std::set<MSDevice_Taxi*, MSVehicleDevice::ComparatorNumericalVehicleIdLess> available;
+    for (auto* taxi : fleet) {
+        if (taxi->isEmpty()) {
+            available.insert(taxi);
+        }
+    }
+    SUMOAbstractRouter<MSEdge, SUMOVehicle>& router = myRoutingMode == 1 ? MSRoutingEngine::getRouterTT(0, SVC_TAXI) : MSNet::getInstance()->getRouterTT(0);
+    std::vector<Reservation*> activeReservations;
+    for (Reservation* res : getReservations()) {
+        if (res->recheck <= now) {
+            activeReservations.push_back(res);
+        }
+    }
+    if (available.size() > 0 && activeReservations.size() > 0) {
+        const std::vector<MSDevice_Taxi*> taxis(available.begin(), available.end());
+        const std::vector<Reservation*> reservations = activeReservations;
+        CandidateTimes candidates;
+        computeCandidateTimes(now, taxis, reservations, router, candidates);
+        // taxis which would arrive too early are no candidates
+        for (int i = 0; i < (int)reservations.size(); i++) {
+            auto& cand = candidates[i];
+            const SUMOTime latest = reservations[i]->pickupTime - now - myMaximumWaitingTime;
+            cand.erase(std::remove_if(cand.begin(), cand.end(), [latest](const std::pair<int, SUMOTime>& item) {
+                return item.second <= latest;
+            }), cand.end());
+        }
+        const std::vector<int> assignment = computeMatching(candidates, (int)taxis.size());
+        for (int i = 0; i < (int)reservations.size(); i++) {
+            if (assignment[i] >= 0) {
+#ifdef DEBUG_DISPATCH
+                std::cout << SIMTIME << " matching res=" << reservations[i]->getID() << " taxi=" << taxis[assignment[i]]->getHolder().getID() << "\n";
+#endif
+                auto resIt = std::find(activeReservations.begin(), activeReservations.end(), reservations[i]);
+                numDispatched += dispatch(taxis[assignment[i]], resIt, router, activeReservations);
+                available.erase(taxis[assignment[i]]);
+            }
         }
+        havePostponed = available.size() > 0 && activeReservations.size() > 0;
     }
     // check if any taxis are able to service the remaining requests
     myHasServableReservations = getReservations().size() > 0 && (available.size() < fleet.size() || havePostponed || numDispatched > 0);
@@ -203,4 +350,105 @@ MSDispatch_GreedyClosest::computeDispatch(SUMOTime now, const std::vector<MSDevi
 }
 
 
+std::vector<int>
+MSDispatch_Matching::computeMatching(const CandidateTimes& costs, const int numTaxis) {
+    // successive shortest augmenting paths with node potentials (Hungarian method on a sparse graph)
+    const int numRes = (int)costs.size();
+    const double inf = std::numeric_limits<double>::max();
+    std::vector<int> resMatch(numRes, -1);
+    std::vector<double> resMatchCost(numRes, 0.);
+    std::vector<int> taxiMatch(numTaxis, -1);
+    std::vector<double> resPot(numRes, 0.);
+    std::vector<double> taxiPot(numTaxis, 0.);
+    std::vector<double> resDist(numRes);
+    std::vector<double> taxiDist(numTaxis);
+    std::vector<int> taxiPrev(numTaxis);
+    // queue entries are (distance, node) where reservations are encoded as negative numbers (-1 - index)
+    typedef std::pair<double, int> QueueEntry;
+    while (true) {
+        // search from all unassigned reservations at once (their potentials stay 0), so the reservation left
+        // unassigned when there are fewer taxis is the one which makes the total cost minimal
+        std::fill(resDist.begin(), resDist.end(), inf);
+        std::fill(taxiDist.begin(), taxiDist.end(), inf);
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue;
+        for (int res = 0; res < numRes; res++) {
+            if (resMatch[res] < 0 && !costs[res].empty()) {
+                resDist[res] = 0.;
+                queue.push(std::make_pair(0., -1 - res));
+            }
+        }
+        int target = -1;
+        while (!queue.empty()) {
+            const double d = queue.top().first;
+            const int node = queue.top().second;
+            queue.pop();
+            if (node >= 0) {
+                if (d > taxiDist[node]) {
+                    continue;
+                }
+                if (taxiMatch[node] < 0) {
+                    target = node;
+                    break;
+                }
+                // follow the matched edge backwards
+                const int res = taxiMatch[node];
+                const double nd = d - resMatchCost[res] + taxiPot[node] - resPot[res];
+                if (nd < resDist[res]) {
+                    resDist[res] = nd;
+                    queue.push(std::make_pair(nd, -1 - res));
+                }
+            } else {
+                const int res = -1 - node;
+                if (d > resDist[res]) {
+                    continue;
+                }
+                for (const auto& item : costs[res]) {
+                    const int taxi = item.first;
+                    if (taxi == resMatch[res]) {
+                        continue;
+                    }
+                    const double nd = d + STEPS2TIME(item.second) + resPot[res] - taxiPot[taxi];
+                    if (nd < taxiDist[taxi]) {
+                        taxiDist[taxi] = nd;
+                        taxiPrev[taxi] = res;
+                        queue.push(std::make_pair(nd, taxi));
+                    }
+                }
+            }
+        }
+        if (target < 0) {
+            // no augmenting path, the matching is maximal
+            break;
+        }
+        // update the potentials to keep the reduced costs non-negative
+        const double targetDist = taxiDist[target];
+        for (int i = 0; i < numRes; i++) {
+            resPot[i] += MIN2(resDist[i], targetDist);
+        }
+        for (int j = 0; j < numTaxis; j++) {
+            taxiPot[j] += MIN2(taxiDist[j], targetDist);
+        }
+        // augment along the path
+        int taxi = target;
+        while (true) {
+            const int res = taxiPrev[taxi];
+            const int prevTaxi = resMatch[res];
+            for (const auto& item : costs[res]) {
+                if (item.first == taxi) {
+                    resMatchCost[res] = STEPS2TIME(item.second);
+                    break;
+                }
+            }
+            resMatch[res] = taxi;
+            taxiMatch[taxi] = res;
+            if (prevTaxi < 0) {
+                break;
+            }
+            taxi = prevTaxi;
+        }
+    }
+    return resMatch;
+}
+
+
 /****************************************************************************/
@@ -53,6 +53,16 @@ protected:
     /// @brief trigger taxi dispatch. @note: method exists so subclasses can inject code at this point (ride sharing)
     virtual int dispatch(MSDevice_Taxi* taxi, std::vector<Reservation*>::iterator& resIt, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, std::vector<Reservation*>& reservations);
 
+    /** @brief finds the compatible taxis which are closest to the pickup of each reservation
+     *
+     * The taxis are found with a grid and a growing search radius by their air distance to the pickup which
+     *  is a lower bound for the travel distance. If maxCandidates is not positive or not smaller than the
+     *  number of taxis, all compatible taxis are returned.
+     * @return the indices of the candidate taxis for each reservation (in ascending order)
+     */
+    std::vector<std::vector<int> > findCandidates(const std::vector<MSDevice_Taxi*>& taxis, const std::vector<Reservation*>& reservations,
+            const int maxCandidates) const;
+
     /// @brief which router/edge weights to use
     const int myRoutingMode;
 
@@ -77,9 +87,53 @@ private:
 class MSDispatch_GreedyClosest : public MSDispatch_Greedy {
 public:
     MSDispatch_GreedyClosest(const Parameterised::Map& params) :
-        MSDispatch_Greedy(params)
+        MSDispatch_Greedy(params),
+        myMaxCandidates(StringUtils::toInt(getParameter("candidates", "0")))
+    {}
+
+    void computeDispatch(SUMOTime now, const std::vector<MSDevice_Taxi*>& fleet);
+
+protected:
+    /// @brief the pickup times (taxi index, time) of all candidate taxis for each reservation
+    typedef std::vector<std::vector<std::pair<int, SUMOTime> > > CandidateTimes;
+
+    /** @brief computes the pickup times of the candidate taxis for each reservation
+     *
+     * All queries for a single taxi are performed in a row so the router may reuse its search tree (bulk mode).
+     * If myMaxCandidates is positive only this number of compatible taxis (the ones closest by air distance
+     *  which is a lower bound for the travel distance) are considered for each reservation.
+     */
+    void computeCandidateTimes(SUMOTime now, const std::vector<MSDevice_Taxi*>& taxis, const std::vector<Reservation*>& reservations,
+                               SUMOAbstractRouter<MSEdge, SUMOVehicle>& router, CandidateTimes& into);
+
+    /// @brief maximum number of taxis to evaluate for each reservation (0 for all)
+    const int myMaxCandidates;
+
+};
+
+
+/**
+ * @class MSDispatch_Matching
+ * @brief A dispatch algorithm that assigns the available taxis to the reservations minimizing the total traveltime-to-pickup
+ *
+ * The assignment is solved as a bipartite matching (successive shortest paths) over the candidate pairs.
+ */
+class MSDispatch_Matching : public MSDispatch_GreedyClosest {
+public:
+    MSDispatch_Matching(const Parameterised::Map& params) :
+        MSDispatch_GreedyClosest(params)
     {}
 
     void computeDispatch(SUMOTime now, const std::vector<MSDevice_Taxi*>& fleet);
 
+private:
+    /** @brief computes a maximum matching with minimum total cost
+     * @param[in] costs The cost of all possible pairs for each reservation
+     * @param[in] numTaxis The number of taxis
+     * @return the index of the assigned taxi for each reservation (-1 if unassigned)
+     */
+    static std::vector<int> computeMatching(const CandidateTimes& costs, const int numTaxis);
+
+    friend class MSDispatch_MatchingTest;
+
 };
@@ -0,0 +1,415 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSDispatch_Pooling.cpp
+/// @author  agent
+/// @date    2026-10-17
+///
+// An insertion based ride pooling algorithm for the taxi device
+/****************************************************************************/
+#include <config.h>
+
+#include <algorithm>
+#include <limits>
+#include <microsim/MSNet.h>
+#include <microsim/MSEdge.h>
+#include <microsim/MSLane.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/transportables/MSTransportable.h>
+#include "MSRoutingEngine.h"
+#include "MSDispatch_Pooling.h"
+
+//#define DEBUG_DISPATCH
+//#define DEBUG_COND2(obj) (obj->getID() == "p0")
+#define DEBUG_COND2(obj) (true)
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+void
+MSDispatch_Pooling::computeDispatch(SUMOTime now, const std::vector<MSDevice_Taxi*>& fleet) {
+    const double inf = std::numeric_limits<double>::max();
+    int numDispatched = 0;
+    int numPostponed = 0;
+    // forget about taxis which left the simulation or finished their schedule
+    std::vector<MSDevice_Taxi*> taxis(fleet.begin(), fleet.end());
+    std::sort(taxis.begin(), taxis.end(), MSVehicleDevice::ComparatorNumericalVehicleIdLess());
+    const std::set<const MSDevice_Taxi*> active(taxis.begin(), taxis.end());
+    for (MSDevice_Taxi* const taxi : taxis) {
+        if (taxi->isEmpty()) {
+            mySchedules.erase(taxi);
+        }
+    }
+    for (auto it = mySchedules.begin(); it != mySchedules.end();) {
+        if (active.count(it->first) == 0) {
+            for (const ScheduleStop& stop : it->second) {
+                myAssignments.erase(stop.first);
+                myDeadlines.erase(stop.first);
+            }
+            it = mySchedules.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    SUMOAbstractRouter<MSEdge, SUMOVehicle>& router = myRoutingMode == 1 ? MSRoutingEngine::getRouterTT(0, SVC_TAXI) : MSNet::getInstance()->getRouterTT(0);
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+    std::vector<SUMOAbstractRouter<MSEdge, SUMOVehicle>*> routers;
+    for (int i = 0; i < threadPool.size(); i++) {
+        routers.push_back(myRoutingMode == 1 ? &MSRoutingEngine::getRouterTT(i, SVC_TAXI) : &MSNet::getInstance()->getRouterTT(i));
+    }
+#endif
+#endif
+    std::vector<Reservation*> reservations = getReservations();
+    std::sort(reservations.begin(), reservations.end(), time_sorter());
+    const std::vector<std::vector<int> > resCandidates = findCandidates(taxis, reservations, myMaxCandidates);
+    std::vector<MSDevice_Taxi*> candidates;
+    std::vector<Insertion> insertions;
+    for (int r = 0; r < (int)reservations.size(); r++) {
+        Reservation* const res = reservations[r];
+        if (res->recheck > now) {
+            numPostponed++;
+            continue;
+        }
+        // customers waiting longer than maxWait already are served by the best taxi regardless of the delay
+        const double latestPickup = STEPS2TIME(now) > STEPS2TIME(res->pickupTime) + myMaxWait ? inf : STEPS2TIME(res->pickupTime) + myMaxWait;
+        const Deadlines deadlines(latestPickup, inf);
+        const Position resPos = res->from->getLanes().front()->geometryPositionAtOffset(res->fromPos);
+        candidates.clear();
+        for (const int j : resCandidates[r]) {
+            MSDevice_Taxi* const taxi = taxis[j];
+            if (latestPickup != inf) {
+                // the air distance gives a lower bound for the time to reach the customer
+                const double minTime = taxi->getHolder().getPosition().distanceTo2D(resPos) / taxi->getHolder().getMaxSpeed();
+                if (STEPS2TIME(now) + minTime > latestPickup) {
+                    continue;
+                }
+            }
+            candidates.push_back(taxi);
+        }
+        if (candidates.empty()) {
+            numPostponed++;
+            continue;
+        }
+        insertions.assign(candidates.size(), Insertion());
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+        if (routers.size() > 0 && candidates.size() > 1) {
+            const int numTasks = MIN2((int)candidates.size(), 4 * threadPool.size());
+            for (int i = 0; i < numTasks; i++) {
+                const int begin = (int)candidates.size() * i / numTasks;
+                const int end = (int)candidates.size() * (i + 1) / numTasks;
+                threadPool.add(new InsertionTask(*this, res, deadlines, now, *routers[i % routers.size()],
+                                                 candidates.begin() + begin, candidates.begin() + end, insertions.begin() + begin), i % threadPool.size());
+            }
+            threadPool.waitAll();
+        } else {
+#endif
+#endif
+            for (int i = 0; i < (int)candidates.size(); i++) {
+                insertions[i] = evaluateInsertion(candidates[i], res, deadlines, now, router);
+            }
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+        }
+#endif
+#endif
+        int best = -1;
+        for (int i = 0; i < (int)candidates.size(); i++) {
+            if (insertions[i].cost != inf && (best < 0 || insertions[i].cost < insertions[best].cost)) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            // no taxi can serve the customer now
+            numPostponed++;
+            continue;
+        }
+        insert(candidates[best], res, insertions[best], deadlines);
+        numDispatched++;
+    }
+    // check if any taxis are able to service the remaining requests
+    myHasServableReservations = getReservations().size() > 0 && (mySchedules.size() > 0 || numPostponed > 0 || numDispatched > 0);
+}
+
+
+void
+MSDispatch_Pooling::fulfilledReservation(const Reservation* res) {
+    auto it = myAssignments.find(res);
+    if (it != myAssignments.end()) {
+        auto schedIt = mySchedules.find(it->second);
+        if (schedIt != mySchedules.end()) {
+            std::vector<ScheduleStop>& schedule = schedIt->second;
+            schedule.erase(std::remove_if(schedule.begin(), schedule.end(), [res](const ScheduleStop & stop) {
+                return stop.first == res;
+            }), schedule.end());
+            if (schedule.empty()) {
+                mySchedules.erase(schedIt);
+            }
+        }
+        myAssignments.erase(it);
+    }
+    myDeadlines.erase(res);
+    MSDispatch::fulfilledReservation(res);
+}
+
+
+double
+MSDispatch_Pooling::travelTime(const MSDevice_Taxi* taxi, const MSEdge* from, double fromPos, const MSEdge* to, double toPos,
+                               SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router) {
+    ConstMSEdgeVector edges;
+    router.compute(from, fromPos, to, toPos, &taxi->getHolder(), t, edges, true);
+    if (edges.empty()) {
+        return std::numeric_limits<double>::max();
+    }
+    return router.recomputeCosts(edges, &taxi->getHolder(), fromPos, toPos, t);
+}
+
+
+MSDispatch_Pooling::Insertion
+MSDispatch_Pooling::evaluateInsertion(const MSDevice_Taxi* taxi, const Reservation* res, const Deadlines& deadlines,
+                                      SUMOTime now, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router) const {
+    const double inf = std::numeric_limits<double>::max();
+    Insertion result;
+    const SUMOVehicle& veh = taxi->getHolder();
+    const bool isPerson = (*res->persons.begin())->isPerson();
+    const int capacity = remainingCapacity(taxi, res) + (int)res->persons.size();
+    // the remaining stops (the pickup of customers who are on board already is done)
+    std::vector<ScheduleStop> stops;
+    int initialLoad = 0;
+    auto schedIt = mySchedules.find(taxi);
+    if (schedIt != mySchedules.end()) {
+        for (const ScheduleStop& stop : schedIt->second) {
+            if ((*stop.first->persons.begin())->isPerson() != isPerson) {
+                // do not mix persons and containers
+                return result;
+            }
+            if (stop.second && stop.first->state == Reservation::ONBOARD) {
+                initialLoad += (int)stop.first->persons.size();
+            } else {
+                stops.push_back(stop);
+            }
+        }
+    }
+    const int n = (int)stops.size();
+    InsertionTimes times;
+    times.now = STEPS2TIME(now);
+    times.initialLoad = initialLoad;
+    times.capacity = capacity;
+    times.persons = (int)res->persons.size();
+    times.earliestPickup = STEPS2TIME(res->pickupTime - myMaximumWaitingTime);
+    times.desiredPickup = STEPS2TIME(res->pickupTime);
+    times.latestPickup = deadlines.first;
+    std::vector<const MSEdge*> edges{veh.getEdge()};
+    std::vector<double> positions{veh.getPositionOnLane()};
+    for (const ScheduleStop& stop : stops) {
+        edges.push_back(stop.second ? stop.first->from : stop.first->to);
+        positions.push_back(stop.second ? stop.first->fromPos : stop.first->toPos);
+        StopTimes stopTimes;
+        stopTimes.pickup = stop.second;
+        stopTimes.persons = (int)stop.first->persons.size();
+        stopTimes.desiredTime = STEPS2TIME(stop.first->pickupTime);
+        auto it = myDeadlines.find(stop.first);
+        if (it != myDeadlines.end()) {
+            stopTimes.deadline = stop.second ? it->second.first : it->second.second;
+        }
+        times.stops.push_back(stopTimes);
+    }
+    // travel times between consecutive stops and from / to the new pickup and dropoff
+    times.base.assign(n + 1, 0.);
+    times.toPickup.assign(n + 1, inf);
+    times.fromPickup.assign(n + 1, inf);
+    times.toDropoff.assign(n + 1, inf);
+    times.fromDropoff.assign(n + 1, inf);
+    // the ride of the customers without detour (with the vehicle class and speed of this taxi)
+    times.directTime = travelTime(taxi, res->from, res->fromPos, res->to, res->toPos, MAX2(now, res->pickupTime), router);
+    if (times.directTime == inf) {
+        return result;
+    }
+    times.toPickup[0] = travelTime(taxi, edges[0], positions[0], res->from, res->fromPos, now, router);
+    if (times.toPickup[0] == inf) {
+        return result;
+    }
+    for (int k = 1; k <= n; k++) {
+        times.base[k] = travelTime(taxi, edges[k - 1], positions[k - 1], edges[k], positions[k], now, router);
+        times.toPickup[k] = travelTime(taxi, edges[k], positions[k], res->from, res->fromPos, now, router);
+        times.fromPickup[k] = travelTime(taxi, res->from, res->fromPos, edges[k], positions[k], now, router);
+        times.toDropoff[k] = travelTime(taxi, edges[k], positions[k], res->to, res->toPos, now, router);
+        times.fromDropoff[k] = travelTime(taxi, res->to, res->toPos, edges[k], positions[k], now, router);
+    }
+    return cheapestInsertion(times, myMaxDetour);
+}
+
+
+MSDispatch_Pooling::Insertion
+MSDispatch_Pooling::cheapestInsertion(const InsertionTimes& times, const double maxDetour) {
+    const double inf = std::numeric_limits<double>::max();
+    Insertion result;
+    const int n = (int)times.stops.size();
+    // the time needed for the current schedule
+    double oldEnd = times.now;
+    for (int k = 1; k <= n; k++) {
+        oldEnd += times.base[k];
+        if (times.stops[k - 1].pickup) {
+            oldEnd = MAX2(oldEnd, times.stops[k - 1].desiredTime);
+        }
+    }
+    // nodes of the new schedule are the indices of the remaining stops or PICKUP / DROPOFF
+    const int PICKUP = -1;
+    const int DROPOFF = -2;
+    std::vector<int> sequence;
+    for (int i = 0; i <= n; i++) {
+        for (int j = i; j <= n; j++) {
+            sequence.clear();
+            for (int k = 0; k <= n; k++) {
+                if (k > 0) {
+                    sequence.push_back(k);
+                }
+                if (k == i) {
+                    sequence.push_back(PICKUP);
+                }
+                if (k == j) {
+                    sequence.push_back(DROPOFF);
+                }
+            }
+            double t = times.now;
+            double pickupTime = 0.;
+            int load = times.initialLoad;
+            int prev = 0;
+            bool feasible = true;
+            for (const int node : sequence) {
+                if (node == PICKUP) {
+                    t += times.toPickup[prev];
+                    if (t >= inf || times.earliestPickup > t) {
+                        // unreachable or the taxi would arrive too early
+                        feasible = false;
+                        break;
+                    }
+                    t = MAX2(t, times.desiredPickup);
+                    pickupTime = t;
+                    load += times.persons;
+                    if (t > times.latestPickup || load > times.capacity) {
+                        feasible = false;
+                        break;
+                    }
+                } else if (node == DROPOFF) {
+                    t += prev == PICKUP ? times.directTime : times.toDropoff[prev];
+                    load -= times.persons;
+                    if (t >= inf || t - pickupTime > times.directTime * (1 + maxDetour)) {
+                        feasible = false;
+                        break;
+                    }
+                } else {
+                    t += prev == PICKUP ? times.fromPickup[node] : (prev == DROPOFF ? times.fromDropoff[node] : times.base[node]);
+                    if (t >= inf) {
+                        feasible = false;
+                        break;
+                    }
+                    const StopTimes& stop = times.stops[node - 1];
+                    if (stop.pickup) {
+                        t = MAX2(t, stop.desiredTime);
+                        load += stop.persons;
+                        if (t > stop.deadline || load > times.capacity) {
+                            feasible = false;
+                            break;
+                        }
+                    } else {
+                        load -= stop.persons;
+                        if (t > stop.deadline) {
+                            feasible = false;
+                            break;
+                        }
+                    }
+                }
+                prev = node;
+            }
+            if (feasible && t - oldEnd < result.cost) {
+                result.cost = t - oldEnd;
+                result.pickupIndex = i;
+                result.dropoffIndex = j;
+                result.pickupTime = pickupTime;
+                result.directTime = times.directTime;
+            }
+        }
+    }
+    return result;
+}
+
+
+void
+MSDispatch_Pooling::insert(MSDevice_Taxi* taxi, Reservation* res, const Insertion& insertion, const Deadlines& deadlines) {
+    std::vector<ScheduleStop>& schedule = mySchedules[taxi];
+    std::vector<ScheduleStop> newSchedule;
+    int remaining = 0;
+    if (insertion.pickupIndex == 0) {
+        newSchedule.push_back(std::make_pair(res, true));
+    }
+    if (insertion.dropoffIndex == 0) {
+        newSchedule.push_back(std::make_pair(res, false));
+    }
+    for (const ScheduleStop& stop : schedule) {
+        newSchedule.push_back(stop);
+        if (stop.second && stop.first->state == Reservation::ONBOARD) {
+            // completed stops are kept for the taxi but do not count for the insertion
+            continue;
+        }
+        remaining++;
+        if (remaining == insertion.pickupIndex) {
+            newSchedule.push_back(std::make_pair(res, true));
+        }
+        if (remaining == insertion.dropoffIndex) {
+            newSchedule.push_back(std::make_pair(res, false));
+        }
+    }
+    schedule = newSchedule;
+    const double latestPickup = deadlines.first == std::numeric_limits<double>::max() ? insertion.pickupTime + myMaxWait : deadlines.first;
+    myDeadlines[res] = Deadlines(latestPickup, latestPickup + insertion.directTime * (1 + myMaxDetour));
+    myAssignments[res] = taxi;
+    std::vector<const Reservation*> sequence;
+    for (const ScheduleStop& stop : schedule) {
+        sequence.push_back(stop.first);
+    }
+#ifdef DEBUG_DISPATCH
+    if (DEBUG_COND2(person)) std::cout << SIMTIME << " dispatch taxi=" << taxi->getHolder().getID() << " person=" << toString(res->persons)
+                                           << " cost=" << insertion.cost << " sequence=" << toString(sequence) << "\n";
+#endif
+    taxi->dispatchShared(sequence);
+    if (myOutput != nullptr && sequence.size() > 2) {
+        myOutput->writeXMLHeader("DispatchInfo_Pooling", "");
+        myOutput->openTag("dispatchShared");
+        myOutput->writeAttr("time", time2string(SIMSTEP));
+        myOutput->writeAttr("id", taxi->getHolder().getID());
+        myOutput->writeAttr("persons", toString(res->persons));
+        myOutput->writeAttr("sharingPersons", toString(sequence));
+        myOutput->writeAttr("type", "pooling");
+        myOutput->writeAttr("cost", insertion.cost);
+        myOutput->closeTag();
+    }
+    servedReservation(res); // moving res to the running reservations
+}
+
+
+#ifdef HAVE_FOX
+void
+MSDispatch_Pooling::InsertionTask::run(MFXWorkerThread* /*context*/) {
+    std::vector<Insertion>::iterator into = myInto;
+    for (auto it = myTaxiBegin; it != myTaxiEnd; ++it) {
+        *into++ = myDispatch.evaluateInsertion(*it, myRes, myDeadlines, myNow, myRouter);
+    }
+}
+#endif
+
+
+/****************************************************************************/
@@ -0,0 +1,196 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSDispatch_Pooling.h
+/// @author  agent
+/// @date    2026-10-17
+///
+// An insertion based ride pooling algorithm for the taxi device
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <limits>
+#include <map>
+#include <vector>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
+#include "MSDispatch_Greedy.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSDispatch_Pooling
+ * @brief A dispatch algorithm that inserts the pickup and dropoff of each reservation (in reservation order)
+ *  at the cheapest feasible position into the schedule of any taxi (empty or already serving customers)
+ *
+ * An insertion is feasible if the taxi capacity is never exceeded, all customers of the taxi are picked up
+ *  at most maxWait seconds after their desired pickup time and their ride does not take longer than
+ *  (1 + maxDetour) times the direct travel time. The cost of an insertion is the additional time needed
+ *  to serve all stops of the taxi. Only the taxis closest to the pickup by air distance (parameter
+ *  'candidates') are evaluated. If multiple simulation threads are used, the candidate taxis
+ *  of each reservation are evaluated in parallel.
+ */
+class MSDispatch_Pooling : public MSDispatch_Greedy {
+public:
+    MSDispatch_Pooling(const Parameterised::Map& params) :
+        MSDispatch_Greedy(params),
+        myMaxWait(StringUtils::toDouble(getParameter("maxWait", "300"))),
+        myMaxDetour(StringUtils::toDouble(getParameter("maxDetour", "0.5"))),
+        myMaxCandidates(StringUtils::toInt(getParameter("candidates", "10")))
+    {}
+
+    void computeDispatch(SUMOTime now, const std::vector<MSDevice_Taxi*>& fleet);
+
+    /// @brief erase reservation from storage
+    void fulfilledReservation(const Reservation* res);
+
+    /// @brief a planned stop of a taxi (the reservation and whether it is the pickup)
+    typedef std::pair<const Reservation*, bool> ScheduleStop;
+
+    /// @brief the best insertion of a reservation into the schedule of a single taxi
+    struct Insertion {
+        /// @brief the additional time needed to serve all stops of the taxi (infinite if infeasible)
+        double cost = std::numeric_limits<double>::max();
+        /// @brief the number of remaining stops before the pickup
+        int pickupIndex = -1;
+        /// @brief the number of remaining stops before the dropoff (not counting the pickup)
+        int dropoffIndex = -1;
+        /// @brief the time at which the customers will be picked up
+        double pickupTime = 0.;
+        /// @brief the travel time of the taxi from the pickup to the dropoff
+        double directTime = 0.;
+    };
+
+    /// @brief a remaining stop of a taxi schedule as needed for evaluating insertions
+    struct StopTimes {
+        /// @brief whether the customers are picked up (or dropped off)
+        bool pickup = false;
+        /// @brief the number of customers
+        int persons = 0;
+        /// @brief the desired pickup time (for pickups)
+        double desiredTime = 0.;
+        /// @brief the latest time at which the stop must be reached
+        double deadline = std::numeric_limits<double>::max();
+    };
+
+    /// @brief the travel times and constraints for inserting a reservation into the schedule of a single taxi
+    struct InsertionTimes {
+        /// @brief the current time
+        double now = 0.;
+        /// @brief the number of customers on board
+        int initialLoad = 0;
+        /// @brief the maximum number of customers on board
+        int capacity = 0;
+        /// @brief the number of customers of the new reservation
+        int persons = 0;
+        /// @brief the earliest time at which the taxi may arrive at the pickup
+        double earliestPickup = 0.;
+        /// @brief the desired pickup time
+        double desiredPickup = 0.;
+        /// @brief the latest pickup time
+        double latestPickup = std::numeric_limits<double>::max();
+        /// @brief the travel time from the pickup to the dropoff
+        double directTime = 0.;
+        /// @brief the remaining stops of the taxi
+        std::vector<StopTimes> stops;
+        /// @brief the travel times to each stop from the previous one (index 0 is the taxi position)
+        std::vector<double> base;
+        /// @brief the travel times from the taxi position and each stop to the pickup
+        std::vector<double> toPickup;
+        /// @brief the travel times from the pickup to each stop
+        std::vector<double> fromPickup;
+        /// @brief the travel times from the taxi position and each stop to the dropoff
+        std::vector<double> toDropoff;
+        /// @brief the travel times from the dropoff to each stop
+        std::vector<double> fromDropoff;
+    };
+
+private:
+    /// @brief the latest times at which the customers of a reservation must be picked up and dropped off
+    typedef std::pair<double, double> Deadlines;
+
+    /** @brief finds the cheapest feasible positions for the pickup and the dropoff within the remaining stops
+     * @param[in] times The travel times and constraints of the schedule
+     * @param[in] maxDetour The maximum relative prolongation of a ride compared to the direct travel time
+     */
+    static Insertion cheapestInsertion(const InsertionTimes& times, const double maxDetour);
+
+    /// @brief computes the travel time between two positions (infinite if there is no route)
+    static double travelTime(const MSDevice_Taxi* taxi, const MSEdge* from, double fromPos, const MSEdge* to, double toPos,
+                             SUMOTime t, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router);
+
+    /** @brief finds the cheapest feasible insertion of the reservation into the schedule of the taxi
+     * @note does not modify the dispatcher and may be called from multiple threads
+     */
+    Insertion evaluateInsertion(const MSDevice_Taxi* taxi, const Reservation* res, const Deadlines& deadlines,
+                                SUMOTime now, SUMOAbstractRouter<MSEdge, SUMOVehicle>& router) const;
+
+    /// @brief assigns the reservation to the taxi and sends the taxi its new schedule
+    void insert(MSDevice_Taxi* taxi, Reservation* res, const Insertion& insertion, const Deadlines& deadlines);
+
+#ifdef HAVE_FOX
+    /// @brief evaluates the insertion of a reservation for a range of taxis
+    class InsertionTask : public MFXWorkerThread::Task {
+    public:
+        InsertionTask(const MSDispatch_Pooling& dispatch, const Reservation* res, const Deadlines& deadlines, SUMOTime now,
+                      SUMOAbstractRouter<MSEdge, SUMOVehicle>& router,
+                      std::vector<MSDevice_Taxi*>::const_iterator taxiBegin, std::vector<MSDevice_Taxi*>::const_iterator taxiEnd,
+                      std::vector<Insertion>::iterator into) :
+            myDispatch(dispatch), myRes(res), myDeadlines(deadlines), myNow(now), myRouter(router),
+            myTaxiBegin(taxiBegin), myTaxiEnd(taxiEnd), myInto(into) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const MSDispatch_Pooling& myDispatch;
+        const Reservation* const myRes;
+        const Deadlines myDeadlines;
+        const SUMOTime myNow;
+        SUMOAbstractRouter<MSEdge, SUMOVehicle>& myRouter;
+        const std::vector<MSDevice_Taxi*>::const_iterator myTaxiBegin;
+        const std::vector<MSDevice_Taxi*>::const_iterator myTaxiEnd;
+        const std::vector<Insertion>::iterator myInto;
+    private:
+        /// @brief Invalidated assignment operator.
+        InsertionTask& operator=(const InsertionTask&) = delete;
+    };
+#endif
+
+private:
+    /// @brief maximum time in s a customer waits after the desired pickup time
+    const double myMaxWait;
+
+    /// @brief maximum relative prolongation of a ride compared to the direct travel time
+    const double myMaxDetour;
+
+    /// @brief maximum number of taxis to evaluate for each reservation (0 for all)
+    const int myMaxCandidates;
+
+    /// @brief the remaining stops of all taxis which are serving customers
+    std::map<const MSDevice_Taxi*, std::vector<ScheduleStop> > mySchedules;
+
+    /// @brief the taxi serving each running reservation
+    std::map<const Reservation*, const MSDevice_Taxi*> myAssignments;
+
+    /// @brief the deadlines of each running reservation
+    std::map<const Reservation*, Deadlines> myDeadlines;
+
+private:
+    /// @brief Invalidated assignment operator.
+    MSDispatch_Pooling& operator=(const MSDispatch_Pooling&) = delete;
+
+    friend class MSDispatch_PoolingTest;
+
+};
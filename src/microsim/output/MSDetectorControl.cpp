@@ -28,6 +28,11 @@
 #include <utils/options/OptionsCont.h>
 #include <utils/options/Option.h>
 #include <utils/common/MsgHandler.h>
+#include <utils/iodevices/OutputDevice_String.h>
+#include <microsim/MSEdge.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/MSGlobals.h>
+#include <microsim/MSNet.h>
 #include "MSMeanData_Emissions.h"
 #include "MSMeanData_Net.h"
 #include "MSDetectorControl.h"
@@ -57,6 +62,14 @@ void
 MSDetectorControl::close(SUMOTime step) {
     // flush the last values
     writeOutput(step, true);
+    for (const auto& i : myIntervals) {
+        for (const auto& j : i.second) {
+            MSMeanData* const md = dynamic_cast<MSMeanData*>(j.first);
+            if (md != nullptr) {
+                md->writeIncompleteCoarseIntervals(*j.second, step);
+            }
+        }
+    }
     // [...] files are closed on another place [...]
     myIntervals.clear();
 }
@@ -116,11 +129,40 @@ MSDetectorControl::getTypedDetectors(SumoXMLTag type) const {
 
 void
 MSDetectorControl::updateDetectors(const SUMOTime step) {
-    for (const auto& i : myDetectors) {
-        for (const auto& j : getTypedDetectors(i.first)) {
-            j.second->detectorUpdate(step);
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1 && getTypedDetectors(SUMO_TAG_LANE_AREA_DETECTOR).size() > 1) {
+        // lane area detectors only touch their own data and are the most expensive ones
+        MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+        std::vector<MSDetectorFileOutput*> e2;
+        for (const auto& j : getTypedDetectors(SUMO_TAG_LANE_AREA_DETECTOR)) {
+            e2.push_back(j.second);
+        }
+        const int numChunks = MIN2((int)e2.size(), 4 * threadPool.size());
+        for (int i = 0; i < numChunks; i++) {
+            threadPool.add(new UpdateTask(e2.begin() + i * e2.size() / numChunks, e2.begin() + (i + 1) * e2.size() / numChunks, step), i % threadPool.size());
+        }
+        threadPool.waitAll();
+        for (const auto& i : myDetectors) {
+            if (i.first != SUMO_TAG_LANE_AREA_DETECTOR) {
+                for (const auto& j : getTypedDetectors(i.first)) {
+                    j.second->detectorUpdate(step);
+                }
+            }
+        }
+    } else {
+#endif
+#endif
+        for (const auto& i : myDetectors) {
+            for (const auto& j : getTypedDetectors(i.first)) {
+                j.second->detectorUpdate(step);
+            }
         }
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
     }
+#endif
+#endif
     for (auto item : myMeanData) {
         for (MSMeanData* md : item.second) {
             md->detectorUpdate(step);
@@ -136,6 +178,39 @@ MSDetectorControl::writeOutput(SUMOTime step, bool closing) {
         if (myLastCalls[interval] + interval.first <= step || (closing && myLastCalls[interval] < step)) {
             DetectorFileVec dfVec = (*i).second;
             SUMOTime startTime = myLastCalls[interval];
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+            if (MSGlobals::gNumSimThreads > 1 && dfVec.size() > 1) {
+                // lane area detectors write into buffers in parallel, all others are written serially
+                MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+                std::vector<OutputDevice_String*> buffers(dfVec.size(), nullptr);
+                int numTasks = 0;
+                for (int index = 0; index < (int)dfVec.size(); index++) {
+                    MSDetectorFileOutput* det = dfVec[index].first;
+                    if (dynamic_cast<MSE2Collector*>(det) != nullptr) {
+                        // the intervals are written below the root element
+                        buffers[index] = new OutputDevice_String(1);
+                        buffers[index]->setPrecision(dfVec[index].second->getPrecision());
+                        threadPool.add(new WriteTask(det, *buffers[index], startTime, step), numTasks++ % threadPool.size());
+                    }
+                }
+                threadPool.waitAll();
+                for (int index = 0; index < (int)dfVec.size(); index++) {
+                    if (buffers[index] != nullptr) {
+                        const std::string content = buffers[index]->getString();
+                        if (!content.empty()) {
+                            dfVec[index].second->writePreformattedTag(content);
+                        }
+                        delete buffers[index];
+                    } else {
+                        dfVec[index].first->writeXMLOutput(*dfVec[index].second, startTime, step);
+                    }
+                }
+                myLastCalls[interval] = step;
+                continue;
+            }
+#endif
+#endif
             // check whether at the end the output was already generated
             for (DetectorFileVec::iterator it = dfVec.begin(); it != dfVec.end(); ++it) {
                 MSDetectorFileOutput* det = it->first;
@@ -147,6 +222,22 @@ MSDetectorControl::writeOutput(SUMOTime step, bool closing) {
 }
 
 
+#ifdef HAVE_FOX
+void
+MSDetectorControl::UpdateTask::run(MFXWorkerThread* /*context*/) {
+    for (std::vector<MSDetectorFileOutput*>::const_iterator it = myBegin; it != myEnd; ++it) {
+        (*it)->detectorUpdate(myStep);
+    }
+}
+
+
+void
+MSDetectorControl::WriteTask::run(MFXWorkerThread* /*context*/) {
+    myDetector->writeXMLOutput(myInto, myStartTime, myStopTime);
+}
+#endif
+
+
 void
 MSDetectorControl::addDetectorAndInterval(MSDetectorFileOutput* det,
         OutputDevice* device,
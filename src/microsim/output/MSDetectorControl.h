@@ -32,6 +32,9 @@
 #include <microsim/output/MSE3Collector.h>
 #include <microsim/output/MSInductLoop.h>
 #include <microsim/output/MSRouteProbe.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -158,7 +161,8 @@ public:
      * Some detectors need to be touched each time step in order to compute
      *  values from the vehicles stored in their containers. This method
      *  goes through all of these detectors and forces a recomputation of
-     *  the values.
+     *  the values. If multiple simulation threads are used, the lane area
+     *  detectors are updated in parallel.
      * @param[in] step The current time step
      */
     void updateDetectors(const SUMOTime step);
@@ -169,7 +173,9 @@ public:
      * Goes through the list of intervals. If one interval has ended within the
      *  given step or if the closing-flag is set and the output was not
      *  written in this step already, the writeXMLOutput method is called
-     *  for all MSDetectorFileOutputs within this interval.
+     *  for all MSDetectorFileOutputs within this interval. If multiple simulation
+     *  threads are used, the lane area detectors write into separate buffers in
+     *  parallel which are appended to their devices in the original order.
      *
      * @param[in] step The current time step
      * @param[in] closing Whether the device is closed
@@ -213,6 +219,39 @@ protected:
     /// @brief An empty container to return in getTypedDetectors() if no detectors of the asked type exist
     NamedObjectCont< MSDetectorFileOutput*> myEmptyContainer;
 
+#ifdef HAVE_FOX
+    /// @brief updates a range of detectors
+    class UpdateTask : public MFXWorkerThread::Task {
+    public:
+        UpdateTask(std::vector<MSDetectorFileOutput*>::const_iterator begin, std::vector<MSDetectorFileOutput*>::const_iterator end, SUMOTime step) :
+            myBegin(begin), myEnd(end), myStep(step) {}
+        void run(MFXWorkerThread* context);
+    private:
+        const std::vector<MSDetectorFileOutput*>::const_iterator myBegin;
+        const std::vector<MSDetectorFileOutput*>::const_iterator myEnd;
+        const SUMOTime myStep;
+    private:
+        /// @brief Invalidated assignment operator.
+        UpdateTask& operator=(const UpdateTask&) = delete;
+    };
+
+    /// @brief writes the interval output of a single detector into a buffer
+    class WriteTask : public MFXWorkerThread::Task {
+    public:
+        WriteTask(MSDetectorFileOutput* det, OutputDevice& into, SUMOTime startTime, SUMOTime stopTime) :
+            myDetector(det), myInto(into), myStartTime(startTime), myStopTime(stopTime) {}
+        void run(MFXWorkerThread* context);
+    private:
+        MSDetectorFileOutput* const myDetector;
+        OutputDevice& myInto;
+        const SUMOTime myStartTime;
+        const SUMOTime myStopTime;
+    private:
+        /// @brief Invalidated assignment operator.
+        WriteTask& operator=(const WriteTask&) = delete;
+    };
+#endif
+
 
 private:
     /// @brief Invalidated copy constructor.
@@ -932,7 +932,19 @@ MSE2Collector::detectorUpdate(const SUMOTime /* step */) {
 
 // sort myMoveNotifications (required for jam processing) ascendingly according to vehicle's distance to the detector end
 // (min = myMoveNotifications[0].distToDetectorEnd)
-    std::sort(myMoveNotifications.begin(), myMoveNotifications.end(), compareMoveNotification);
+    // the notifications arrive almost sorted (lane by lane), a stable insertion sort needs no temporary buffer
+    for (int i = 1; i < (int)myMoveNotifications.size(); i++) {
+        if (!compareMoveNotification(myMoveNotifications[i], myMoveNotifications[i - 1])) {
+            continue;
+        }
+        MoveNotificationInfo current = std::move(myMoveNotifications[i]);
+        int j = i;
+        while (j > 0 && compareMoveNotification(current, myMoveNotifications[j - 1])) {
+            myMoveNotifications[j] = std::move(myMoveNotifications[j - 1]);
+            j--;
+        }
+        myMoveNotifications[j] = std::move(current);
+    }
 
     // reset values concerning current time step (these are updated in integrateMoveNotification() and aggregateOutputValues())
     myCurrentVehicleSamples = 0;
@@ -941,38 +953,40 @@ MSE2Collector::detectorUpdate(const SUMOTime /* step */) {
     myCurrentStartedHalts = 0;
     myCurrentHaltingsNumber = 0;
 
-    JamInfo* currentJam = nullptr;
-    std::vector<JamInfo*> jams;
-    std::map<std::string, SUMOTime> haltingVehicles;
-    std::map<std::string, SUMOTime> intervalHaltingVehicles;
+    bool jamIsOpen = false;
+    myNextHaltingVehicles.clear();
 
     // go through the list of vehicles positioned on the detector
-    for (std::vector<MoveNotificationInfo*>::iterator i = myMoveNotifications.begin(); i != myMoveNotifications.end(); ++i) {
+    for (int i = 0; i < (int)myMoveNotifications.size(); i++) {
         // The ID of the vehicle that has sent this notification in the last step
-        const std::string& vehID = (*i)->id;
+        const std::string& vehID = myMoveNotifications[i].id;
         VehicleInfoMap::iterator vi = myVehicleInfos.find(vehID);
 
         if (vi == myVehicleInfos.end()) {
             // The vehicle has already left the detector by lanechange, teleport, etc. (not longitudinal)
-            integrateMoveNotification(nullptr, *i);
+            integrateMoveNotification(nullptr, &myMoveNotifications[i]);
         } else {
             // Add move notification infos to detector values and VehicleInfo
-            integrateMoveNotification(vi->second, *i);
+            integrateMoveNotification(vi->second, &myMoveNotifications[i]);
         }
         // construct jam structure
-        bool isInJam = checkJam(i, haltingVehicles, intervalHaltingVehicles);
-        buildJam(isInJam, i, currentJam, jams);
+        bool isInJam = checkJam(i);
+        buildJam(isInJam, i, jamIsOpen);
     }
 
     // extract some aggregated values from the jam structure
-    processJams(jams, currentJam);
+    processJams();
 
     // Aggregate and normalize values for the detector output
     aggregateOutputValues();
 
-    // save information about halting vehicles
-    myHaltingVehicleDurations = haltingVehicles;
-    myIntervalHaltingVehicleDurations = intervalHaltingVehicles;
+    // save information about halting vehicles (vehicles which did not notify are forgotten)
+    std::sort(myNextHaltingVehicles.begin(), myNextHaltingVehicles.end());
+    myNextHaltingVehicles.erase(std::unique(myNextHaltingVehicles.begin(), myNextHaltingVehicles.end(),
+    [](const HaltingInfo & a, const HaltingInfo & b) {
+        return a.id == b.id;
+    }), myNextHaltingVehicles.end());
+    myHaltingVehicles.swap(myNextHaltingVehicles);
 
 #ifdef DEBUG_E2_DETECTOR_UPDATE
     if (DEBUG_COND) {
@@ -1012,9 +1026,6 @@ MSE2Collector::detectorUpdate(const SUMOTime /* step */) {
     myLeftVehicles.clear();
 
     // reset move notifications
-    for (std::vector<MoveNotificationInfo*>::iterator j = myMoveNotifications.begin(); j != myMoveNotifications.end(); ++j) {
-        delete *j;
-    }
     myMoveNotifications.clear();
 }
 
@@ -1080,7 +1091,7 @@ MSE2Collector::integrateMoveNotification(VehicleInfo* vi, const MoveNotification
 
 
 
-MSE2Collector::MoveNotificationInfo*
+MSE2Collector::MoveNotificationInfo
 MSE2Collector::makeMoveNotification(const SUMOTrafficObject& veh, double oldPos, double newPos, double newSpeed, const VehicleInfo& vehInfo) const {
 #ifdef DEBUG_E2_NOTIFY_MOVE
     if (DEBUG_COND) {
@@ -1121,116 +1132,107 @@ MSE2Collector::makeMoveNotification(const SUMOTrafficObject& veh, double oldPos,
 #endif
 
     /* Store new infos */
-    return new MoveNotificationInfo(veh.getID(), oldPos, newPos, newSpeed, veh.getAcceleration(),
-                                    myDetectorLength - (vehInfo.entryOffset + newPos),
-                                    timeOnDetector, lengthOnDetector, timeLoss, stillOnDetector);
+    return MoveNotificationInfo(veh.getID(), veh.isPerson() ? -1 - veh.getNumericalID() : veh.getNumericalID(),
+                                oldPos, newPos, newSpeed, veh.getAcceleration(),
+                                myDetectorLength - (vehInfo.entryOffset + newPos),
+                                timeOnDetector, lengthOnDetector, timeLoss, stillOnDetector);
 }
 
 void
-MSE2Collector::buildJam(bool isInJam, std::vector<MoveNotificationInfo*>::const_iterator mni, JamInfo*& currentJam, std::vector<JamInfo*>& jams) {
+MSE2Collector::buildJam(bool isInJam, int mni, bool& jamIsOpen) {
 #ifdef DEBUG_E2_JAMS
     if (DEBUG_COND) {
-        std::cout << SIMTIME << " buildJam() for vehicle '" << (*mni)->id << "'" << std::endl;
+        std::cout << SIMTIME << " buildJam() for vehicle '" << myMoveNotifications[mni].id << "'" << std::endl;
     }
 #endif
     if (isInJam) {
         // The vehicle is in a jam;
         //  it may be a new one or already an existing one
-        if (currentJam == nullptr) {
+        if (!jamIsOpen) {
 #ifdef DEBUG_E2_JAMS
             if (DEBUG_COND) {
-                std::cout << SIMTIME << " vehicle '" << (*mni)->id << "' forms the start of the first jam" << std::endl;
+                std::cout << SIMTIME << " vehicle '" << myMoveNotifications[mni].id << "' forms the start of the first jam" << std::endl;
             }
 #endif
             // the vehicle is the first vehicle in a jam
-            currentJam = new JamInfo();
-            currentJam->firstStandingVehicle = mni;
+            myJams.push_back({mni, mni});
+            jamIsOpen = true;
         } else {
             // ok, we have a jam already. But - maybe it is too far away
             //  ... honestly, I can hardly find a reason for doing this,
             //  but jams were defined this way in an earlier version...
-            MoveNotificationInfo* lastVeh = *currentJam->lastStandingVehicle;
-            MoveNotificationInfo* currVeh = *mni;
-            if (lastVeh->distToDetectorEnd - currVeh->distToDetectorEnd > myJamDistanceThreshold) {
+            const MoveNotificationInfo& lastVeh = myMoveNotifications[myJams.back().lastStandingVehicle];
+            const MoveNotificationInfo& currVeh = myMoveNotifications[mni];
+            if (lastVeh.distToDetectorEnd - currVeh.distToDetectorEnd > myJamDistanceThreshold) {
 #ifdef DEBUG_E2_JAMS
                 if (DEBUG_COND) {
-                    std::cout << SIMTIME << " vehicle '" << (*mni)->id << "' forms the start of a new jam" << std::endl;
+                    std::cout << SIMTIME << " vehicle '" << myMoveNotifications[mni].id << "' forms the start of a new jam" << std::endl;
                 }
 #endif
                 // yep, yep, yep - it's a new one...
                 //  close the frist, build a new
-                jams.push_back(currentJam);
-                currentJam = new JamInfo();
-                currentJam->firstStandingVehicle = mni;
+                myJams.push_back({mni, mni});
             }
         }
-        currentJam->lastStandingVehicle = mni;
+        myJams.back().lastStandingVehicle = mni;
     } else {
         // the vehicle is not part of a jam...
         //  maybe we have to close an already computed jam
-        if (currentJam != nullptr) {
 #ifdef DEBUG_E2_JAMS
-            if (DEBUG_COND) {
-                std::cout << SIMTIME << " Closing current jam." << std::endl;
-            }
-#endif
-            jams.push_back(currentJam);
-            currentJam = nullptr;
+        if (DEBUG_COND && jamIsOpen) {
+            std::cout << SIMTIME << " Closing current jam." << std::endl;
         }
+#endif
+        jamIsOpen = false;
     }
 }
 
 
 bool
-MSE2Collector::checkJam(std::vector<MoveNotificationInfo*>::const_iterator mni, std::map<std::string, SUMOTime>& haltingVehicles, std::map<std::string, SUMOTime>& intervalHaltingVehicles) {
+MSE2Collector::checkJam(int mni) {
+    const MoveNotificationInfo& info = myMoveNotifications[mni];
 #ifdef DEBUG_E2_JAMS
     if (DEBUG_COND) {
-        std::cout << SIMTIME << " CheckJam() for vehicle '" << (*mni)->id << "'" << std::endl;
+        std::cout << SIMTIME << " CheckJam() for vehicle '" << info.id << "'" << std::endl;
     }
 #endif
     // jam-checking begins
     bool isInJam = false;
+    // look up whether it was halting before
+    HaltingInfo halting = {info.numericalID, DELTA_T, DELTA_T};
+    std::vector<HaltingInfo>::const_iterator previous = std::lower_bound(myHaltingVehicles.begin(), myHaltingVehicles.end(), halting);
+    const bool wasHalting = previous != myHaltingVehicles.end() && previous->id == info.numericalID;
     // first, check whether the vehicle is slow enough to be counted as halting
-    if ((*mni)->speed < myJamHaltingSpeedThreshold) {
+    if (info.speed < myJamHaltingSpeedThreshold) {
         myCurrentHaltingsNumber++;
         // we have to track the time it was halting;
-        // so let's look up whether it was halting before and compute the overall halting time
-        bool wasHalting = myHaltingVehicleDurations.count((*mni)->id) > 0;
+        // so compute the overall halting time
         if (wasHalting) {
-            haltingVehicles[(*mni)->id] = myHaltingVehicleDurations[(*mni)->id] + DELTA_T;
-            intervalHaltingVehicles[(*mni)->id] = myIntervalHaltingVehicleDurations[(*mni)->id] + DELTA_T;
+            halting.duration = previous->duration + DELTA_T;
+            halting.intervalDuration = previous->intervalDuration + DELTA_T;
         } else {
 #ifdef DEBUG_E2_JAMS
             if (DEBUG_COND) {
-                std::cout << SIMTIME << " vehicle '" << (*mni)->id << "' starts halting." << std::endl;
+                std::cout << SIMTIME << " vehicle '" << info.id << "' starts halting." << std::endl;
             }
 #endif
-            haltingVehicles[(*mni)->id] = DELTA_T;
-            intervalHaltingVehicles[(*mni)->id] = DELTA_T;
             myCurrentStartedHalts++;
             myStartedHalts++;
         }
+        myNextHaltingVehicles.push_back(halting);
         // we now check whether the halting time is large enough
-        if (haltingVehicles[(*mni)->id] > myJamHaltingTimeThreshold) {
+        if (halting.duration > myJamHaltingTimeThreshold) {
             // yep --> the vehicle is a part of a jam
             isInJam = true;
         }
-    } else {
+    } else if (wasHalting) {
         // is not standing anymore; keep duration information
-        std::map<std::string, SUMOTime>::iterator v = myHaltingVehicleDurations.find((*mni)->id);
-        if (v != myHaltingVehicleDurations.end()) {
-            myPastStandingDurations.push_back(v->second);
-            myHaltingVehicleDurations.erase(v);
-        }
-        v = myIntervalHaltingVehicleDurations.find((*mni)->id);
-        if (v != myIntervalHaltingVehicleDurations.end()) {
-            myPastIntervalStandingDurations.push_back((*v).second);
-            myIntervalHaltingVehicleDurations.erase(v);
-        }
+        myPastStandingDurations.push_back(previous->duration);
+        myPastIntervalStandingDurations.push_back(previous->intervalDuration);
     }
 #ifdef DEBUG_E2_JAMS
     if (DEBUG_COND) {
-        std::cout << SIMTIME << " vehicle '" << (*mni)->id << "'" << (isInJam ? "is jammed." : "is not jammed.") << std::endl;
+        std::cout << SIMTIME << " vehicle '" << info.id << "'" << (isInJam ? "is jammed." : "is not jammed.") << std::endl;
     }
 #endif
     return isInJam;
@@ -1238,17 +1240,11 @@ MSE2Collector::checkJam(std::vector<MoveNotificationInfo*>::const_iterator mni,
 
 
 void
-MSE2Collector::processJams(std::vector<JamInfo*>& jams, JamInfo* currentJam) {
-    // push last jam
-    if (currentJam != nullptr) {
-        jams.push_back(currentJam);
-        currentJam = nullptr;
-    }
-
+MSE2Collector::processJams() {
 #ifdef DEBUG_E2_JAMS
     if (DEBUG_COND) {
         std::cout << "\n" << SIMTIME << " processJams()"
-                  << "\nNumber of jams: " << jams.size() << std::endl;
+                  << "\nNumber of jams: " << myJams.size() << std::endl;
     }
 #endif
 
@@ -1257,14 +1253,14 @@ MSE2Collector::processJams(std::vector<JamInfo*>& jams, JamInfo* currentJam) {
     myCurrentMaxJamLengthInVehicles = 0;
     myCurrentJamLengthInMeters = 0;
     myCurrentJamLengthInVehicles = 0;
-    for (std::vector<JamInfo*>::const_iterator i = jams.begin(); i != jams.end(); ++i) {
+    for (const JamInfo& jam : myJams) {
         // compute current jam's values
-        MoveNotificationInfo* lastVeh = *((*i)->lastStandingVehicle);
-        MoveNotificationInfo* firstVeh = *((*i)->firstStandingVehicle);
-        const double jamLengthInMeters = MAX2(lastVeh->distToDetectorEnd, 0.) -
-                                         MAX2(firstVeh->distToDetectorEnd, 0.) +
-                                         lastVeh->lengthOnDetector;
-        const int jamLengthInVehicles = (int) distance((*i)->firstStandingVehicle, (*i)->lastStandingVehicle) + 1;
+        const MoveNotificationInfo& lastVeh = myMoveNotifications[jam.lastStandingVehicle];
+        const MoveNotificationInfo& firstVeh = myMoveNotifications[jam.firstStandingVehicle];
+        const double jamLengthInMeters = MAX2(lastVeh.distToDetectorEnd, 0.) -
+                                         MAX2(firstVeh.distToDetectorEnd, 0.) +
+                                         lastVeh.lengthOnDetector;
+        const int jamLengthInVehicles = jam.lastStandingVehicle - jam.firstStandingVehicle + 1;
         // apply them to the statistics
         myCurrentMaxJamLengthInMeters = MAX2(myCurrentMaxJamLengthInMeters, jamLengthInMeters);
         myCurrentMaxJamLengthInVehicles = MAX2(myCurrentMaxJamLengthInVehicles, jamLengthInVehicles);
@@ -1274,19 +1270,15 @@ MSE2Collector::processJams(std::vector<JamInfo*>& jams, JamInfo* currentJam) {
         myCurrentJamLengthInVehicles += jamLengthInVehicles;
 #ifdef DEBUG_E2_JAMS
         if (DEBUG_COND) {
-            std::cout << SIMTIME << " processing jam nr." << ((int) distance((std::vector<JamInfo*>::const_iterator) jams.begin(), i) + 1)
+            std::cout << SIMTIME << " processing jam"
                       << "\njamLengthInMeters = " << jamLengthInMeters
                       << " jamLengthInVehicles = " << jamLengthInVehicles
                       << std::endl;
         }
 #endif
     }
-    myCurrentJamNo = (int) jams.size();
-
-    // clean up jam structure
-    for (std::vector<JamInfo*>::iterator i = jams.begin(); i != jams.end(); ++i) {
-        delete *i;
-    }
+    myCurrentJamNo = (int)myJams.size();
+    myJams.clear();
 }
 
 void
@@ -1377,9 +1369,9 @@ MSE2Collector::writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime st
         maxHaltingDuration = MAX2(maxHaltingDuration, (*i));
         haltingNo++;
     }
-    for (std::map<std::string, SUMOTime> ::iterator i = myHaltingVehicleDurations.begin(); i != myHaltingVehicleDurations.end(); ++i) {
-        haltingDurationSum += (*i).second;
-        maxHaltingDuration = MAX2(maxHaltingDuration, (*i).second);
+    for (const HaltingInfo& halting : myHaltingVehicles) {
+        haltingDurationSum += halting.duration;
+        maxHaltingDuration = MAX2(maxHaltingDuration, halting.duration);
         haltingNo++;
     }
     const SUMOTime meanHaltingDuration = haltingNo != 0 ? haltingDurationSum / haltingNo : 0;
@@ -1392,9 +1384,9 @@ MSE2Collector::writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime st
         intervalMaxHaltingDuration = MAX2(intervalMaxHaltingDuration, (*i));
         intervalHaltingNo++;
     }
-    for (std::map<std::string, SUMOTime> ::iterator i = myIntervalHaltingVehicleDurations.begin(); i != myIntervalHaltingVehicleDurations.end(); ++i) {
-        intervalHaltingDurationSum += (*i).second;
-        intervalMaxHaltingDuration = MAX2(intervalMaxHaltingDuration, (*i).second);
+    for (const HaltingInfo& halting : myHaltingVehicles) {
+        intervalHaltingDurationSum += halting.intervalDuration;
+        intervalMaxHaltingDuration = MAX2(intervalMaxHaltingDuration, halting.intervalDuration);
         intervalHaltingNo++;
     }
     const SUMOTime intervalMeanHaltingDuration = intervalHaltingNo != 0 ? intervalHaltingDurationSum / intervalHaltingNo : 0;
@@ -1467,8 +1459,8 @@ MSE2Collector::reset() {
     myMaxJamInMeters = 0;
     myTimeSamples = 0;
     myMeanVehicleNumber = 0;
-    for (std::map<std::string, SUMOTime>::iterator i = myIntervalHaltingVehicleDurations.begin(); i != myIntervalHaltingVehicleDurations.end(); ++i) {
-        (*i).second = 0;
+    for (HaltingInfo& halting : myHaltingVehicles) {
+        halting.intervalDuration = 0;
     }
     myPastStandingDurations.clear();
     myPastIntervalStandingDurations.clear();
@@ -1590,9 +1582,6 @@ MSE2Collector::getEstimateQueueLength() const {
 
 void
 MSE2Collector::clearState(SUMOTime /* step */) {
-    for (std::vector<MoveNotificationInfo*>::iterator j = myMoveNotifications.begin(); j != myMoveNotifications.end(); ++j) {
-        delete *j;
-    }
     myMoveNotifications.clear();
 
     // clear vehicle infos
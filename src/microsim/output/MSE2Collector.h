@@ -157,8 +157,9 @@ private:
      *          temporarily stored in myMoveNotifications for each step.
     */
     struct MoveNotificationInfo {
-        MoveNotificationInfo(std::string _vehID, double _oldPos, double _newPos, double _speed, double _accel, double _distToDetectorEnd, double _timeOnDetector, double _lengthOnDetector, double _timeLoss, bool _onDetector) :
+        MoveNotificationInfo(std::string _vehID, long long int _numericalID, double _oldPos, double _newPos, double _speed, double _accel, double _distToDetectorEnd, double _timeOnDetector, double _lengthOnDetector, double _timeLoss, bool _onDetector) :
             id(_vehID),
+            numericalID(_numericalID),
             oldPos(_oldPos),
             newPos(_newPos),
             speed(_speed),
@@ -169,10 +170,10 @@ private:
             timeLoss(_timeLoss),
             onDetector(_onDetector) {}
 
-        virtual ~MoveNotificationInfo() {};
-
         /// Vehicle's id
         std::string id;
+        /// Vehicle's numerical id (negative for persons to avoid clashes with vehicles)
+        long long int numericalID;
         /// Position before the last integration step (relative to the vehicle's entry lane on the detector)
         double oldPos;
         /// Position after the last integration step (relative to the vehicle's entry lane on the detector)
@@ -201,11 +202,31 @@ private:
      *  begin and end positions (as vehicles) of a jam.
      */
     struct JamInfo {
-        /// @brief The first standing vehicle
-        std::vector<MoveNotificationInfo*>::const_iterator firstStandingVehicle;
+        /// @brief The index of the first standing vehicle in myMoveNotifications
+        int firstStandingVehicle;
+
+        /// @brief The index of the last standing vehicle in myMoveNotifications
+        int lastStandingVehicle;
+    };
+
+
+    /** @brief The halting durations of a vehicle which is currently halting
+     *
+     * These are kept in a vector sorted by the numerical id to avoid string keyed maps.
+     */
+    struct HaltingInfo {
+        /// @brief The numerical id of the vehicle (negative for persons to avoid clashes with vehicles)
+        long long int id;
+
+        /// @brief The duration of the current halt
+        SUMOTime duration;
+
+        /// @brief The duration of the current halt within the current interval
+        SUMOTime intervalDuration;
 
-        /// @brief The last standing vehicle
-        std::vector<MoveNotificationInfo*>::const_iterator lastStandingVehicle;
+        bool operator<(const HaltingInfo& other) const {
+            return id < other.id;
+        }
     };
 
 
@@ -566,29 +587,26 @@ private:
 
     /** @brief checks whether the vehicle stands in a jam
      *
-     * @param[in] mni
-     * @param[in/out] haltingVehicles
-     * @param[in/out] intervalHaltingVehicles
+     * The halting durations of halting vehicles are added to myNextHaltingVehicles,
+     *  the durations of ended halts to the past standing durations.
+     * @param[in] mni The index of the vehicle in myMoveNotifications
      * @return Whether vehicle is in a jam.
      */
-    bool checkJam(std::vector<MoveNotificationInfo*>::const_iterator mni, std::map<std::string, SUMOTime>& haltingVehicles, std::map<std::string, SUMOTime>& intervalHaltingVehicles);
+    bool checkJam(int mni);
 
 
     /** @brief Either adds the vehicle to the end of an existing jam, or closes the last jam, and/or creates a new jam
      *
      * @param isInJam
-     * @param mni
-     * @param[in/out] currentJam
-     * @param[in/out] jams
+     * @param mni The index of the vehicle in myMoveNotifications
+     * @param[in/out] jamIsOpen Whether the last jam in myJams may be extended
      */
-    void buildJam(bool isInJam, std::vector<MoveNotificationInfo*>::const_iterator mni, JamInfo*& currentJam, std::vector<JamInfo*>& jams);
+    void buildJam(bool isInJam, int mni, bool& jamIsOpen);
 
 
-    /** @brief Calculates aggregated values from the given jam structure, deletes all jam-pointers
-     *
-     * @param jams
+    /** @brief Calculates aggregated values from the jams in myJams and clears them
      */
-    void processJams(std::vector<JamInfo*>& jams, JamInfo* currentJam);
+    void processJams();
 
     /** @brief Calculates the time spent on the detector in the last step and the timeloss suffered in the last step for the given vehicle
      *
@@ -661,7 +679,7 @@ private:
      * @param vehInfo Info on the detector's memory of the vehicle
      * @return A MoveNotificationInfo containing quantities of interest for the detector
      */
-    MoveNotificationInfo* makeMoveNotification(const SUMOTrafficObject& veh, double oldPos, double newPos, double newSpeed, const VehicleInfo& vehInfo) const;
+    MoveNotificationInfo makeMoveNotification(const SUMOTrafficObject& veh, double oldPos, double newPos, double newSpeed, const VehicleInfo& vehInfo) const;
 
     /** @brief Creates and returns a VehicleInfo (called at the vehicle's entry)
      *
@@ -683,8 +701,8 @@ private:
 
     /** brief returns true if the vehicle corresponding to mni1 is closer to the detector end than the vehicle corresponding to mni2
      */
-    static bool compareMoveNotification(MoveNotificationInfo* mni1, MoveNotificationInfo* mni2) {
-        return mni1->distToDetectorEnd < mni2->distToDetectorEnd;
+    static bool compareMoveNotification(const MoveNotificationInfo& mni1, const MoveNotificationInfo& mni2) {
+        return mni1.distToDetectorEnd < mni2.distToDetectorEnd;
     }
 
     void notifyMovePerson(MSTransportable* p, int dir, double pos);
@@ -729,18 +747,21 @@ private:
 
     /// @brief Temporal storage for notifications from vehicles that did call the
     ///        detector's notifyMove() in the last time step.
-    std::vector<MoveNotificationInfo*> myMoveNotifications;
+    std::vector<MoveNotificationInfo> myMoveNotifications;
 
     /// @brief Keep track of vehicles that left the detector by a regular move along a junction (not lanechange, teleport, etc.)
     ///        and should be removed from myVehicleInfos after taking into account their movement. Non-longitudinal exits
     ///        are processed immediately in notifyLeave()
     std::set<std::string> myLeftVehicles;
 
-    /// @brief Storage for halting durations of known vehicles (for halting vehicles)
-    std::map<std::string, SUMOTime> myHaltingVehicleDurations;
+    /// @brief Storage for halting durations of the currently halting vehicles (sorted by id)
+    std::vector<HaltingInfo> myHaltingVehicles;
+
+    /// @brief Temporal storage for the halting durations of the vehicles halting in the current step (reused to avoid allocations)
+    std::vector<HaltingInfo> myNextHaltingVehicles;
 
-    /// @brief Storage for halting durations of known vehicles (current interval)
-    std::map<std::string, SUMOTime> myIntervalHaltingVehicleDurations;
+    /// @brief Temporal storage for the jams of the current step (reused to avoid allocations)
+    std::vector<JamInfo> myJams;
 
     /// @brief Halting durations of ended halts [s]
     std::vector<SUMOTime> myPastStandingDurations;
@@ -23,6 +23,7 @@
 #include <config.h>
 
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/OutputDevice_String.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/geom/GeoConvHelper.h>
 #include <utils/geom/GeomHelper.h>
@@ -51,156 +52,249 @@ MSFCDExport::write(OutputDevice& of, SUMOTime timestep, bool elevation) {
     const OptionsCont& oc = OptionsCont::getOptions();
     const SUMOTime period = string2time(oc.getString("device.fcd.period"));
     const SUMOTime begin = string2time(oc.getString("device.fcd.begin"));
-    if ((period > 0 && (timestep - begin) % period != 0) || timestep < begin) {
+    if (timestep < begin) {
         return;
     }
-    const long long int mask = MSDevice_FCD::getWrittenAttributes();
+    // devices with their own period may need to write in between the global periods
+    const bool globalStep = period <= 0 || (timestep - begin) % period == 0;
+    if (!globalStep && !MSDevice_FCD::hasCustomPeriods()) {
+        return;
+    }
+    WriteOptions wo;
+    wo.mask = MSDevice_FCD::getWrittenAttributes();
     const bool maskSet = oc.isSet("fcd-output.attributes");
-    const bool useGeo = oc.getBool("fcd-output.geo");
-    const bool signals = oc.getBool("fcd-output.signals") || (maskSet && of.useAttribute(SUMO_ATTR_SIGNALS, mask));
-    const bool writeAccel = oc.getBool("fcd-output.acceleration") || (maskSet && of.useAttribute(SUMO_ATTR_ACCELERATION, mask));
-    const bool writeDistance = oc.getBool("fcd-output.distance") || (maskSet && of.useAttribute(SUMO_ATTR_DISTANCE, mask));
-    const double maxLeaderDistance = oc.getFloat("fcd-output.max-leader-distance");
-    std::vector<std::string> params = oc.getStringVector("fcd-output.params");
+    wo.useGeo = oc.getBool("fcd-output.geo");
+    wo.elevation = elevation;
+    wo.signals = oc.getBool("fcd-output.signals") || (maskSet && of.useAttribute(SUMO_ATTR_SIGNALS, wo.mask));
+    wo.writeAccel = oc.getBool("fcd-output.acceleration") || (maskSet && of.useAttribute(SUMO_ATTR_ACCELERATION, wo.mask));
+    wo.writeDistance = oc.getBool("fcd-output.distance") || (maskSet && of.useAttribute(SUMO_ATTR_DISTANCE, wo.mask));
+    wo.maxLeaderDistance = oc.getFloat("fcd-output.max-leader-distance");
+    wo.params = oc.getStringVector("fcd-output.params");
+    wo.transportables = globalStep;
     MSNet* net = MSNet::getInstance();
     MSVehicleControl& vc = net->getVehicleControl();
     const double radius = oc.getFloat("device.fcd.radius");
     const bool filter = MSDevice_FCD::getEdgeFilter().size() > 0;
     const bool shapeFilter = MSDevice_FCD::hasShapeFilter();
     std::set<const Named*> inRadius;
-    if (radius > 0) {
+    if (radius > 0 && globalStep) {
         // collect all vehicles in radius around equipped vehicles
+        std::vector<Position> equipped;
         for (MSVehicleControl::constVehIt it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
             const SUMOVehicle* veh = it->second;
             if (isVisible(veh) && hasOwnOutput(veh, filter, shapeFilter)) {
-                PositionVector shape;
-                shape.push_back(veh->getPosition());
-                libsumo::Helper::collectObjectsInRange(libsumo::CMD_GET_VEHICLE_VARIABLE, shape, radius, inRadius);
-                libsumo::Helper::collectObjectsInRange(libsumo::CMD_GET_PERSON_VARIABLE, shape, radius, inRadius);
+                equipped.push_back(veh->getPosition());
             }
         }
+        libsumo::Helper::TrafficObjectIndexScope indexScope(2 * (int)equipped.size());
+        for (const Position& pos : equipped) {
+            PositionVector shape;
+            shape.push_back(pos);
+            libsumo::Helper::collectObjectsInRange(libsumo::CMD_GET_VEHICLE_VARIABLE, shape, radius, inRadius);
+            libsumo::Helper::collectObjectsInRange(libsumo::CMD_GET_PERSON_VARIABLE, shape, radius, inRadius);
+        }
     }
 
-    of.openTag("timestep").writeAttr(SUMO_ATTR_TIME, time2string(timestep));
+    // decide which vehicles are written (the transportables inside vehicles are only written at global steps)
+    std::vector<Record> records;
     for (MSVehicleControl::constVehIt it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
         const SUMOVehicle* veh = it->second;
-        const MSVehicle* microVeh = dynamic_cast<const MSVehicle*>(veh);
-        const MSBaseVehicle* baseVeh = dynamic_cast<const MSBaseVehicle*>(veh);
-        if (isVisible(veh)) {
-            const bool hasOutput = hasOwnOutput(veh, filter, shapeFilter, (radius > 0 && inRadius.count(veh) > 0));
-            if (hasOutput) {
-                Position pos = veh->getPosition();
-                if (useGeo) {
-                    of.setPrecision(gPrecisionGeo);
-                    GeoConvHelper::getFinal().cartesian2geo(pos);
-                }
-                of.openTag(SUMO_TAG_VEHICLE);
-                of.writeAttr(SUMO_ATTR_ID, veh->getID());
-                of.writeOptionalAttr(SUMO_ATTR_X, pos.x(), mask);
-                of.writeOptionalAttr(SUMO_ATTR_Y, pos.y(), mask);
-                of.setPrecision(gPrecision);
-                if (elevation) {
-                    of.writeOptionalAttr(SUMO_ATTR_Z, pos.z(), mask);
-                }
-                of.writeOptionalAttr(SUMO_ATTR_ANGLE, GeomHelper::naviDegree(veh->getAngle()), mask);
-                of.writeOptionalAttr(SUMO_ATTR_TYPE, veh->getVehicleType().getID(), mask);
-                of.writeOptionalAttr(SUMO_ATTR_SPEED, veh->getSpeed(), mask);
-                of.writeOptionalAttr(SUMO_ATTR_POSITION, veh->getPositionOnLane(), mask);
-                if (microVeh != nullptr) {
-                    of.writeOptionalAttr(SUMO_ATTR_LANE, microVeh->getLane()->getID(), mask);
-                } else {
-                    of.writeOptionalAttr(SUMO_ATTR_EDGE, veh->getEdge()->getID(), mask);
-                }
-                of.writeOptionalAttr(SUMO_ATTR_SLOPE, veh->getSlope(), mask);
-                if (microVeh != nullptr) {
-                    if (signals) {
-                        of.writeOptionalAttr(SUMO_ATTR_SIGNALS, toString(microVeh->getSignals()), mask);
-                    }
-                    if (writeAccel) {
-                        of.writeOptionalAttr(SUMO_ATTR_ACCELERATION, toString(microVeh->getAcceleration()), mask);
-                        if (MSGlobals::gSublane) {
-                            of.writeOptionalAttr(SUMO_ATTR_ACCELERATION_LAT, microVeh->getLaneChangeModel().getAccelerationLat(), mask);
-                        }
-                    }
-                }
-                if (writeDistance) {
-                    double lanePos = veh->getPositionOnLane();
-                    if (microVeh != nullptr && microVeh->getLane()->isInternal()) {
-                        lanePos = microVeh->getRoute().getDistanceBetween(0, lanePos, microVeh->getEdge(), &microVeh->getLane()->getEdge(),
-                                  true, microVeh->getRoutePosition());
-                    }
-                    of.writeOptionalAttr(SUMO_ATTR_DISTANCE, veh->getEdge()->getDistanceAt(lanePos), mask);
-                }
-                of.writeOptionalAttr(SUMO_ATTR_ODOMETER, veh->getOdometer(), mask);
-                of.writeOptionalAttr(SUMO_ATTR_POSITION_LAT, veh->getLateralPositionOnLane(), mask);
-                if (microVeh != nullptr) {
-                    of.writeOptionalAttr(SUMO_ATTR_SPEED_LAT, microVeh->getLaneChangeModel().getSpeedLat(), mask);
-                }
-                if (maxLeaderDistance >= 0 && microVeh != nullptr) {
-                    std::pair<const MSVehicle* const, double> leader = microVeh->getLeader(maxLeaderDistance);
-                    if (leader.first != nullptr) {
-                        of.writeOptionalAttr(SUMO_ATTR_LEADER_ID, toString(leader.first->getID()), mask);
-                        of.writeOptionalAttr(SUMO_ATTR_LEADER_SPEED, toString(leader.first->getSpeed()), mask);
-                        of.writeOptionalAttr(SUMO_ATTR_LEADER_GAP, toString(leader.second + microVeh->getVehicleType().getMinGap()), mask);
-                    } else {
-                        of.writeOptionalAttr(SUMO_ATTR_LEADER_ID, "", mask);
-                        of.writeOptionalAttr(SUMO_ATTR_LEADER_SPEED, -1, mask);
-                        of.writeOptionalAttr(SUMO_ATTR_LEADER_GAP, -1, mask);
-                    }
-                }
-                for (const std::string& key : params) {
-                    std::string error;
-                    const std::string value = baseVeh->getPrefixedParameter(key, error);
-                    if (value != "") {
-                        of.writeAttr(StringUtils::escapeXML(key), StringUtils::escapeXML(value));
-                    }
-                }
-                of.closeTag();
+        if (!isVisible(veh)) {
+            continue;
+        }
+        bool writeVeh = false;
+        if (hasOwnOutput(veh, filter, shapeFilter, (radius > 0 && inRadius.count(veh) > 0))) {
+            MSDevice_FCD* device = static_cast<MSDevice_FCD*>(veh->getDevice(typeid(MSDevice_FCD)));
+            if (device == nullptr) {
+                writeVeh = globalStep;
+            } else {
+                writeVeh = device->isDue(timestep, begin) && device->checkChange(veh->getPosition(), veh->getSpeed());
             }
-            // write persons and containers
-            const MSEdge* edge = microVeh == nullptr ? veh->getEdge() : &veh->getLane()->getEdge();
+        }
+        if (writeVeh || (globalStep && (!veh->getPersons().empty() || !veh->getContainers().empty()))) {
+            records.push_back(Record(veh, writeVeh));
+        }
+    }
+    if (!globalStep && records.empty()) {
+        return;
+    }
 
-            const std::vector<MSTransportable*>& persons = veh->getPersons();
-            for (MSTransportable* person : persons) {
-                writeTransportable(of, edge, person, veh, filter, shapeFilter, inRadius.count(person) > 0, SUMO_TAG_PERSON, useGeo, elevation, mask);
-            }
-            const std::vector<MSTransportable*>& containers = veh->getContainers();
-            for (MSTransportable* container : containers) {
-                writeTransportable(of, edge, container, veh, filter, shapeFilter, inRadius.count(container) > 0, SUMO_TAG_CONTAINER, useGeo, elevation, mask);
+    of.openTag("timestep").writeAttr(SUMO_ATTR_TIME, time2string(timestep));
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    // leader and parameter retrieval, the lazily built shape filter and the geo projection are not safe for concurrent use
+    if (MSGlobals::gNumSimThreads > 1 && records.size() > 1 && wo.maxLeaderDistance < 0 && wo.params.empty() && !shapeFilter && !wo.useGeo) {
+        MFXWorkerThread::Pool& threadPool = net->getEdgeControl().getThreadPool();
+        // contiguous chunks of the vehicle list are written into separate buffers and concatenated in order
+        const int numChunks = MIN2((int)records.size(), 4 * threadPool.size());
+        std::vector<OutputDevice_String*> buffers;
+        for (int i = 0; i < numChunks; i++) {
+            // vehicles are written below the root and the timestep element
+            buffers.push_back(new OutputDevice_String(2));
+            threadPool.add(new WriteTask(*buffers.back(), records.begin() + i * records.size() / numChunks,
+                                         records.begin() + (i + 1) * records.size() / numChunks,
+                                         filter, shapeFilter, radius > 0 ? &inRadius : nullptr, wo), i % threadPool.size());
+        }
+        threadPool.waitAll();
+        for (OutputDevice_String* buffer : buffers) {
+            const std::string content = buffer->getString();
+            if (!content.empty()) {
+                // an empty buffer would turn the empty timestep element into an opening and a closing tag
+                of.writePreformattedTag(content);
             }
+            delete buffer;
         }
+    } else {
+#endif
+#endif
+        writeRecords(of, records.begin(), records.end(), filter, shapeFilter, radius > 0 ? &inRadius : nullptr, wo);
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
     }
-    if (net->hasPersons() && net->getPersonControl().hasTransportables()) {
+#endif
+#endif
+    if (globalStep && net->hasPersons() && net->getPersonControl().hasTransportables()) {
         // write persons
         MSEdgeControl& ec = net->getEdgeControl();
         const MSEdgeVector& edges = ec.getEdges();
         for (MSEdgeVector::const_iterator e = edges.begin(); e != edges.end(); ++e) {
-            if (filter && MSDevice_FCD::getEdgeFilter().count(*e) == 0) {
+            if (!MSDevice_FCD::passesEdgeFilter(*e)) {
                 continue;
             }
             const std::vector<MSTransportable*>& persons = (*e)->getSortedPersons(timestep);
             for (MSTransportable* person : persons) {
-                writeTransportable(of, *e, person, nullptr, filter, shapeFilter, inRadius.count(person) > 0, SUMO_TAG_PERSON, useGeo, elevation, mask);
+                writeTransportable(of, *e, person, nullptr, filter, shapeFilter, inRadius.count(person) > 0, SUMO_TAG_PERSON, wo);
             }
         }
     }
-    if (net->hasContainers() && net->getContainerControl().hasTransportables()) {
+    if (globalStep && net->hasContainers() && net->getContainerControl().hasTransportables()) {
         // write containers
         MSEdgeControl& ec = net->getEdgeControl();
         const std::vector<MSEdge*>& edges = ec.getEdges();
         for (std::vector<MSEdge*>::const_iterator e = edges.begin(); e != edges.end(); ++e) {
-            if (filter && MSDevice_FCD::getEdgeFilter().count(*e) == 0) {
+            if (!MSDevice_FCD::passesEdgeFilter(*e)) {
                 continue;
             }
             const std::vector<MSTransportable*>& containers = (*e)->getSortedContainers(timestep);
             for (MSTransportable* container : containers) {
-                writeTransportable(of, *e, container, nullptr, filter, shapeFilter, inRadius.count(container) > 0, SUMO_TAG_CONTAINER, useGeo, elevation, mask);
+                writeTransportable(of, *e, container, nullptr, filter, shapeFilter, inRadius.count(container) > 0, SUMO_TAG_CONTAINER, wo);
+            }
+        }
+    }
+    of.closeTag();
+}
+
+
+void
+MSFCDExport::writeRecords(OutputDevice& of, std::vector<Record>::const_iterator begin, std::vector<Record>::const_iterator end,
+                          bool filter, bool shapeFilter, const std::set<const Named*>* inRadius, const WriteOptions& wo) {
+    for (std::vector<Record>::const_iterator it = begin; it != end; ++it) {
+        const SUMOVehicle* veh = it->first;
+        if (it->second) {
+            writeVehicle(of, veh, wo);
+        }
+        if (!wo.transportables) {
+            continue;
+        }
+        // write persons and containers
+        const MSVehicle* microVeh = dynamic_cast<const MSVehicle*>(veh);
+        const MSEdge* edge = microVeh == nullptr ? veh->getEdge() : &veh->getLane()->getEdge();
+
+        const std::vector<MSTransportable*>& persons = veh->getPersons();
+        for (MSTransportable* person : persons) {
+            writeTransportable(of, edge, person, veh, filter, shapeFilter, inRadius != nullptr && inRadius->count(person) > 0, SUMO_TAG_PERSON, wo);
+        }
+        const std::vector<MSTransportable*>& containers = veh->getContainers();
+        for (MSTransportable* container : containers) {
+            writeTransportable(of, edge, container, veh, filter, shapeFilter, inRadius != nullptr && inRadius->count(container) > 0, SUMO_TAG_CONTAINER, wo);
+        }
+    }
+}
+
+
+void
+MSFCDExport::writeVehicle(OutputDevice& of, const SUMOVehicle* veh, const WriteOptions& wo) {
+    const long long int mask = wo.mask;
+    const MSVehicle* microVeh = dynamic_cast<const MSVehicle*>(veh);
+    const MSBaseVehicle* baseVeh = dynamic_cast<const MSBaseVehicle*>(veh);
+    Position pos = veh->getPosition();
+    if (wo.useGeo) {
+        of.setPrecision(gPrecisionGeo);
+        GeoConvHelper::getFinal().cartesian2geo(pos);
+    }
+    of.openTag(SUMO_TAG_VEHICLE);
+    of.writeAttr(SUMO_ATTR_ID, veh->getID());
+    of.writeOptionalAttr(SUMO_ATTR_X, pos.x(), mask);
+    of.writeOptionalAttr(SUMO_ATTR_Y, pos.y(), mask);
+    of.setPrecision(gPrecision);
+    if (wo.elevation) {
+        of.writeOptionalAttr(SUMO_ATTR_Z, pos.z(), mask);
+    }
+    of.writeOptionalAttr(SUMO_ATTR_ANGLE, GeomHelper::naviDegree(veh->getAngle()), mask);
+    of.writeOptionalAttr(SUMO_ATTR_TYPE, veh->getVehicleType().getID(), mask);
+    of.writeOptionalAttr(SUMO_ATTR_SPEED, veh->getSpeed(), mask);
+    of.writeOptionalAttr(SUMO_ATTR_POSITION, veh->getPositionOnLane(), mask);
+    if (microVeh != nullptr) {
+        of.writeOptionalAttr(SUMO_ATTR_LANE, microVeh->getLane()->getID(), mask);
+    } else {
+        of.writeOptionalAttr(SUMO_ATTR_EDGE, veh->getEdge()->getID(), mask);
+    }
+    of.writeOptionalAttr(SUMO_ATTR_SLOPE, veh->getSlope(), mask);
+    if (microVeh != nullptr) {
+        if (wo.signals) {
+            of.writeOptionalAttr(SUMO_ATTR_SIGNALS, toString(microVeh->getSignals()), mask);
+        }
+        if (wo.writeAccel) {
+            of.writeOptionalAttr(SUMO_ATTR_ACCELERATION, toString(microVeh->getAcceleration()), mask);
+            if (MSGlobals::gSublane) {
+                of.writeOptionalAttr(SUMO_ATTR_ACCELERATION_LAT, microVeh->getLaneChangeModel().getAccelerationLat(), mask);
             }
         }
     }
+    if (wo.writeDistance) {
+        double lanePos = veh->getPositionOnLane();
+        if (microVeh != nullptr && microVeh->getLane()->isInternal()) {
+            lanePos = microVeh->getRoute().getDistanceBetween(0, lanePos, microVeh->getEdge(), &microVeh->getLane()->getEdge(),
+                      true, microVeh->getRoutePosition());
+        }
+        of.writeOptionalAttr(SUMO_ATTR_DISTANCE, veh->getEdge()->getDistanceAt(lanePos), mask);
+    }
+    of.writeOptionalAttr(SUMO_ATTR_ODOMETER, veh->getOdometer(), mask);
+    of.writeOptionalAttr(SUMO_ATTR_POSITION_LAT, veh->getLateralPositionOnLane(), mask);
+    if (microVeh != nullptr) {
+        of.writeOptionalAttr(SUMO_ATTR_SPEED_LAT, microVeh->getLaneChangeModel().getSpeedLat(), mask);
+    }
+    if (wo.maxLeaderDistance >= 0 && microVeh != nullptr) {
+        std::pair<const MSVehicle* const, double> leader = microVeh->getLeader(wo.maxLeaderDistance);
+        if (leader.first != nullptr) {
+            of.writeOptionalAttr(SUMO_ATTR_LEADER_ID, toString(leader.first->getID()), mask);
+            of.writeOptionalAttr(SUMO_ATTR_LEADER_SPEED, toString(leader.first->getSpeed()), mask);
+            of.writeOptionalAttr(SUMO_ATTR_LEADER_GAP, toString(leader.second + microVeh->getVehicleType().getMinGap()), mask);
+        } else {
+            of.writeOptionalAttr(SUMO_ATTR_LEADER_ID, "", mask);
+            of.writeOptionalAttr(SUMO_ATTR_LEADER_SPEED, -1, mask);
+            of.writeOptionalAttr(SUMO_ATTR_LEADER_GAP, -1, mask);
+        }
+    }
+    for (const std::string& key : wo.params) {
+        std::string error;
+        const std::string value = baseVeh->getPrefixedParameter(key, error);
+        if (value != "") {
+            of.writeAttr(StringUtils::escapeXML(key), StringUtils::escapeXML(value));
+        }
+    }
     of.closeTag();
 }
 
+
+#ifdef HAVE_FOX
+void
+MSFCDExport::WriteTask::run(MFXWorkerThread* /*context*/) {
+    writeRecords(myInto, myBegin, myEnd, myFilter, myShapeFilter, myInRadius, myOptions);
+}
+#endif
+
+
 bool
 MSFCDExport::isVisible(const SUMOVehicle* veh) {
     return veh->isOnRoad() || veh->isParking() || veh->isRemoteControlled();
@@ -208,14 +302,14 @@ MSFCDExport::isVisible(const SUMOVehicle* veh) {
 
 bool
 MSFCDExport::hasOwnOutput(const SUMOVehicle* veh, bool filter, bool shapeFilter, bool isInRadius) {
-    return ((!filter || MSDevice_FCD::getEdgeFilter().count(veh->getEdge()) > 0)
+    return ((!filter || MSDevice_FCD::passesEdgeFilter(veh->getEdge()))
             && (!shapeFilter || MSDevice_FCD::shapeFilter(veh))
             && ((veh->getDevice(typeid(MSDevice_FCD)) != nullptr) || isInRadius));
 }
 
 bool
 MSFCDExport::hasOwnOutput(const MSTransportable* p, bool filter, bool shapeFilter, bool isInRadius) {
-    return ((!filter || MSDevice_FCD::getEdgeFilter().count(p->getEdge()) > 0)
+    return ((!filter || MSDevice_FCD::passesEdgeFilter(p->getEdge()))
             && (!shapeFilter || MSDevice_FCD::shapeFilter(p))
             && ((p->getDevice(typeid(MSTransportableDevice_FCD)) != nullptr) || isInRadius));
 }
@@ -223,12 +317,13 @@ MSFCDExport::hasOwnOutput(const MSTransportable* p, bool filter, bool shapeFilte
 void
 MSFCDExport::writeTransportable(OutputDevice& of, const MSEdge* e, MSTransportable* p, const SUMOVehicle* v,
                                 bool filter, bool shapeFilter, bool inRadius,
-                                SumoXMLTag tag, bool useGeo, bool elevation, long long int mask) {
+                                SumoXMLTag tag, const WriteOptions& wo) {
     if (!hasOwnOutput(p, filter, shapeFilter, inRadius)) {
         return;
     }
+    const long long int mask = wo.mask;
     Position pos = p->getPosition();
-    if (useGeo) {
+    if (wo.useGeo) {
         of.setPrecision(gPrecisionGeo);
         GeoConvHelper::getFinal().cartesian2geo(pos);
     }
@@ -236,7 +331,7 @@ MSFCDExport::writeTransportable(OutputDevice& of, const MSEdge* e, MSTransportab
     of.writeAttr(SUMO_ATTR_ID, p->getID());
     of.writeOptionalAttr(SUMO_ATTR_X, pos.x(), mask);
     of.writeOptionalAttr(SUMO_ATTR_Y, pos.y(), mask);
-    if (elevation) {
+    if (wo.elevation) {
         of.writeOptionalAttr(SUMO_ATTR_Z, pos.z(), mask);
     }
     of.writeOptionalAttr(SUMO_ATTR_ANGLE, GeomHelper::naviDegree(p->getAngle()), mask);
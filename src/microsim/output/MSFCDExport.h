@@ -20,7 +20,14 @@
 #pragma once
 #include <config.h>
 
+#include <set>
+#include <string>
+#include <vector>
 #include <utils/common/SUMOTime.h>
+#include <utils/xml/SUMOXMLDefinitions.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -30,6 +37,9 @@ class OutputDevice;
 class MSEdgeControl;
 class MSEdge;
 class MSLane;
+class MSTransportable;
+class Named;
+class SUMOVehicle;
 
 
 // ===========================================================================
@@ -49,6 +59,9 @@ public:
     /** @brief Writes the position and the angle of each vehicle into the given device
      *
      *  Opens the current time step and export the values vehicle id, position and angle
+     *  Vehicles with an FCD device are written according to the device period and
+     *  the change thresholds of the device. If multiple simulation threads are used,
+     *  the vehicles are formatted in parallel into separate buffers.
      *
      * @param[in] of The output device to use
      * @param[in] timestep The current time step
@@ -58,15 +71,61 @@ public:
     static void write(OutputDevice& of, SUMOTime timestep, bool elevation);
 
 private:
+    /// @brief the settings which are the same for all written objects of a time step
+    struct WriteOptions {
+        long long int mask = 0;
+        bool useGeo = false;
+        bool elevation = false;
+        bool signals = false;
+        bool writeAccel = false;
+        bool writeDistance = false;
+        double maxLeaderDistance = -1;
+        std::vector<std::string> params;
+        /// @brief whether the transportables inside the vehicles shall be written
+        bool transportables = true;
+    };
+
+    /// @brief a visible vehicle and whether the vehicle itself shall be written
+    typedef std::pair<const SUMOVehicle*, bool> Record;
+
+    /// @brief write the given vehicles and the transportables inside them
+    static void writeRecords(OutputDevice& of, std::vector<Record>::const_iterator begin, std::vector<Record>::const_iterator end,
+                             bool filter, bool shapeFilter, const std::set<const Named*>* inRadius, const WriteOptions& wo);
+
+    /// @brief write vehicle
+    static void writeVehicle(OutputDevice& of, const SUMOVehicle* veh, const WriteOptions& wo);
+
     /// @brief write transportable
     static void writeTransportable(OutputDevice& of, const MSEdge* e, MSTransportable* p, const SUMOVehicle* v,
                                    bool filter, bool shapeFilter, bool inRadius,
-                                   SumoXMLTag tag, bool useGeo, bool elevation, long long int mask);
+                                   SumoXMLTag tag, const WriteOptions& wo);
 
     static bool isVisible(const SUMOVehicle* veh);
     static bool hasOwnOutput(const SUMOVehicle* veh, bool filter, bool shapeFilter, bool isInRadius = false);
     static bool hasOwnOutput(const MSTransportable* p, bool filter, bool shapeFilter, bool isInRadius = false);
 
+#ifdef HAVE_FOX
+    /// @brief writes a range of vehicles into a separate buffer
+    class WriteTask : public MFXWorkerThread::Task {
+    public:
+        WriteTask(OutputDevice& into, std::vector<Record>::const_iterator begin, std::vector<Record>::const_iterator end,
+                  bool filter, bool shapeFilter, const std::set<const Named*>* inRadius, const WriteOptions& wo) :
+            myInto(into), myBegin(begin), myEnd(end), myFilter(filter), myShapeFilter(shapeFilter), myInRadius(inRadius), myOptions(wo) {}
+        void run(MFXWorkerThread* context);
+    private:
+        OutputDevice& myInto;
+        const std::vector<Record>::const_iterator myBegin;
+        const std::vector<Record>::const_iterator myEnd;
+        const bool myFilter;
+        const bool myShapeFilter;
+        const std::set<const Named*>* const myInRadius;
+        const WriteOptions& myOptions;
+    private:
+        /// @brief Invalidated assignment operator.
+        WriteTask& operator=(const WriteTask&) = delete;
+    };
+#endif
+
 private:
     /// @brief Invalidated copy constructor.
     MSFCDExport(const MSFCDExport&);
@@ -114,6 +114,7 @@ MSInductLoop::notifyEnter(SUMOTrafficObject& veh, Notification reason, const MSL
 #endif
             myVehiclesOnDet[&veh] = SIMTIME;
             myEnteredVehicleNumber++;
+            notifyEntryListeners();
         }
     }
     return true;
@@ -144,6 +145,7 @@ MSInductLoop::notifyMove(SUMOTrafficObject& veh, double oldPos,
         const double timeBeforeEnter = MSCFModel::passingTime(oldPos, myPosition, newPos, oldSpeed, newSpeed);
         myVehiclesOnDet[&veh] = SIMTIME + timeBeforeEnter;
         myEnteredVehicleNumber++;
+        notifyEntryListeners();
 #ifdef DEBUG_E1_NOTIFY_MOVE
         if (DEBUG_COND) {
             std::cout << SIMTIME << " det=" << getID() << " enteredVeh=" << veh.getID() << "\n";
@@ -369,6 +371,7 @@ MSInductLoop::overrideTimeSinceDetection(double time) {
             myOverrideEntryTime = entryTime;
         }
     }
+    notifyEntryListeners();
 }
 
 void
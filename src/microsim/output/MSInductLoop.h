@@ -27,6 +27,7 @@
 #include <string>
 #include <deque>
 #include <map>
+#include <vector>
 #include <functional>
 #include <microsim/MSMoveReminder.h>
 #include <microsim/output/MSDetectorFileOutput.h>
@@ -245,6 +246,26 @@ public:
      */
     void overrideTimeSinceDetection(double time);
 
+
+    /**
+     * @class EntryListener
+     * @brief Interface for objects which need to know when the detector gets occupied
+     */
+    class EntryListener {
+    public:
+        virtual ~EntryListener() {}
+
+        /** @brief Called whenever a vehicle enters the detector or the detection time is overridden
+         * @note may be called from multiple threads
+         */
+        virtual void vehicleEntered(const MSInductLoop& loop) = 0;
+    };
+
+    /// @brief Adds a listener to be informed about entering vehicles
+    void addEntryListener(EntryListener* listener) {
+        myEntryListeners.push_back(listener);
+    }
+
     /// @name Methods inherited from MSDetectorFileOutput.
     /// @{
 
@@ -346,6 +367,13 @@ protected:
     /// @brief helper function for mapping person movement
     void notifyMovePerson(MSTransportable* p, int dir, double pos);
 
+    /// @brief informs the entry listeners (to be called with the notification mutex locked)
+    void notifyEntryListeners() const {
+        for (EntryListener* const listener : myEntryListeners) {
+            listener->vehicleEntered(*this);
+        }
+    }
+
 protected:
     /// @brief detecto name
     std::string myName;
@@ -386,6 +414,9 @@ protected:
     SUMOTime myLastIntervalEnd;
     SUMOTime myLastIntervalBegin;
 
+    /// @brief The objects to inform about entering vehicles
+    std::vector<EntryListener*> myEntryListeners;
+
 private:
     /// @brief Invalidated copy constructor.
     MSInductLoop(const MSInductLoop&);
@@ -23,6 +23,7 @@
 /****************************************************************************/
 #include <config.h>
 
+#include <algorithm>
 #include <limits>
 #ifdef HAVE_FOX
 #include <utils/common/ScopedLocker.h>
@@ -31,6 +32,7 @@
 #include <utils/common/ToString.h>
 #include <utils/common/StringTokenizer.h>
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/OutputDevice_String.h>
 #include <microsim/MSEdgeControl.h>
 #include <microsim/MSEdge.h>
 #include <microsim/MSLane.h>
@@ -64,7 +66,9 @@ MSMeanData::MeanDataValues::MeanDataValues(
     myParent(parent),
     myLaneLength(length),
     sampleSeconds(0),
-    travelledDistance(0) {}
+    travelledDistance(0),
+    myEdgeIndex(-1),
+    myAmActive(false) {}
 
 
 MSMeanData::MeanDataValues::~MeanDataValues() {
@@ -251,6 +255,7 @@ MSMeanData::MeanDataValues::notifyMove(SUMOTrafficObject& veh, double oldPos, do
 #ifdef HAVE_FOX
     ScopedLocker<> lock(myNotificationMutex, MSGlobals::gNumSimThreads > 1);
 #endif
+    markActive();
     notifyMoveInternal(veh, frontOnLane, timeOnLane, (enterSpeed + leaveSpeedFront) / 2., (enterSpeed + leaveSpeed) / 2., travelledDistanceFrontOnLane, travelledDistanceVehicleOnLane, meanLengthOnLane);
     return ret;
 }
@@ -435,7 +440,8 @@ MSMeanData::MSMeanData(const std::string& id,
     myDumpInternal(withInternal),
     myTrackVehicles(trackVehicles),
     myWrittenAttributes(initWrittenAttributes(writeAttributes, id)),
-    myAggregate(aggregate)
+    myAggregate(aggregate),
+    myTrackActive(false)
 { }
 
 
@@ -451,6 +457,10 @@ MSMeanData::init() {
             }
         }
     }
+    myTrackActive = !MSGlobals::gUseMesoSim && !myTrackVehicles;
+    if (myTrackActive) {
+        myEdgeActive.resize(myEdges.size(), false);
+    }
     int index = 0;
     for (MSEdge* edge : myEdges) {
         myMeasures.push_back(std::vector<MeanDataValues*>());
@@ -502,6 +512,7 @@ MSMeanData::init() {
                 }
             } else {
                 myMeasures.back().push_back(createValues(lane, lane->getLength(), true));
+                myMeasures.back().back()->setEdgeIndex(index - 1);
             }
         }
     }
@@ -514,6 +525,129 @@ MSMeanData::~MSMeanData() {
             delete *j;
         }
     }
+    for (const CoarseInterval& coarse : myCoarseIntervals) {
+        for (const std::vector<MeanDataValues*>& edgeValues : coarse.measures) {
+            for (MeanDataValues* const values : edgeValues) {
+                delete values;
+            }
+        }
+    }
+}
+
+
+void
+MSMeanData::setCoarsePeriods(const std::vector<SUMOTime>& periods) {
+    for (const SUMOTime period : periods) {
+        CoarseInterval coarse;
+        coarse.period = period;
+        coarse.begin = -1;
+        myCoarseIntervals.push_back(coarse);
+    }
+}
+
+
+void
+MSMeanData::markActive(const int edgeIndex) const {
+#ifdef HAVE_FOX
+    ScopedLocker<> lock(myActiveMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+    if (!myEdgeActive[edgeIndex]) {
+        myEdgeActive[edgeIndex] = true;
+        myActiveEdges.push_back(edgeIndex);
+    }
+}
+
+
+void
+MSMeanData::clearActive() {
+    for (const int edgeIndex : myActiveEdges) {
+        for (MeanDataValues* const values : myMeasures[edgeIndex]) {
+            values->clearActive();
+        }
+        myEdgeActive[edgeIndex] = false;
+    }
+    myActiveEdges.clear();
+}
+
+
+std::vector<int>
+MSMeanData::getEdgesToWrite(const std::vector<int>& activeEdges) const {
+    std::vector<int> result;
+    if (myTrackActive && !myDumpEmpty) {
+        // the edges without data would not be written anyway
+        result = activeEdges;
+        std::sort(result.begin(), result.end());
+    } else {
+        for (int i = 0; i < (int)myEdges.size(); i++) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+
+std::vector<MSMeanData::MeanDataValues*>&
+MSMeanData::getCoarseValues(CoarseInterval& coarse, const int edgeIndex) {
+    if (coarse.measures.empty()) {
+        coarse.measures.resize(myEdges.size());
+        coarse.edgeActive.resize(myEdges.size(), false);
+    }
+    std::vector<MeanDataValues*>& edgeValues = coarse.measures[edgeIndex];
+    if (edgeValues.empty()) {
+        for (MSLane* const lane : myEdges[edgeIndex]->getLanes()) {
+            edgeValues.push_back(createValues(lane, lane->getLength(), false));
+        }
+    }
+    return edgeValues;
+}
+
+
+void
+MSMeanData::addToCoarseIntervals(const SUMOTime startTime) {
+    for (CoarseInterval& coarse : myCoarseIntervals) {
+        if (coarse.begin < 0) {
+            coarse.begin = startTime;
+        }
+        for (const int edgeIndex : myActiveEdges) {
+            std::vector<MeanDataValues*>& edgeValues = getCoarseValues(coarse, edgeIndex);
+            for (int i = 0; i < (int)edgeValues.size(); i++) {
+                myMeasures[edgeIndex][i]->addTo(*edgeValues[i]);
+            }
+            if (!coarse.edgeActive[edgeIndex]) {
+                coarse.edgeActive[edgeIndex] = true;
+                coarse.activeEdges.push_back(edgeIndex);
+            }
+        }
+    }
+}
+
+
+void
+MSMeanData::writeCoarseIntervals(OutputDevice& dev, const SUMOTime stopTime, const bool closing) {
+    for (CoarseInterval& coarse : myCoarseIntervals) {
+        if (coarse.begin < 0 || stopTime - coarse.begin < (closing ? 1 : coarse.period)) {
+            continue;
+        }
+        const std::vector<int> edgeIndices = getEdgesToWrite(coarse.activeEdges);
+        for (const int edgeIndex : edgeIndices) {
+            getCoarseValues(coarse, edgeIndex);
+        }
+        openInterval(dev, coarse.begin, stopTime, myID + "_" + time2string(coarse.period));
+        writeEdges(dev, coarse.measures, edgeIndices, coarse.begin, stopTime);
+        dev.closeTag();
+        for (const int edgeIndex : coarse.activeEdges) {
+            coarse.edgeActive[edgeIndex] = false;
+        }
+        coarse.activeEdges.clear();
+        coarse.begin = -1;
+    }
+}
+
+
+void
+MSMeanData::writeIncompleteCoarseIntervals(OutputDevice& dev, const SUMOTime stopTime) {
+    writeCoarseIntervals(dev, stopTime, true);
+    dev.flush();
 }
 
 
@@ -534,6 +668,16 @@ MSMeanData::resetOnly(SUMOTime stopTime) {
         }
         return;
     }
+    if (myTrackActive) {
+        // all other edges are still empty
+        for (const int edgeIndex : myActiveEdges) {
+            for (MeanDataValues* const values : myMeasures[edgeIndex]) {
+                values->reset();
+            }
+        }
+        clearActive();
+        return;
+    }
     for (std::vector<std::vector<MeanDataValues*> >::const_iterator i = myMeasures.begin(); i != myMeasures.end(); ++i) {
         for (std::vector<MeanDataValues*>::const_iterator j = (*i).begin(); j != (*i).end(); ++j) {
             (*j)->reset();
@@ -677,9 +821,9 @@ MSMeanData::writeEdge(OutputDevice& dev,
 
 
 void
-MSMeanData::openInterval(OutputDevice& dev, const SUMOTime startTime, const SUMOTime stopTime) {
+MSMeanData::openInterval(OutputDevice& dev, const SUMOTime startTime, const SUMOTime stopTime, const std::string& id) {
     dev.openTag(SUMO_TAG_INTERVAL).writeAttr(SUMO_ATTR_BEGIN, time2string(startTime)).writeAttr(SUMO_ATTR_END, time2string(stopTime));
-    dev.writeAttr(SUMO_ATTR_ID, myID);
+    dev.writeAttr(SUMO_ATTR_ID, id);
 }
 
 
@@ -728,22 +872,70 @@ MSMeanData::writeXMLOutput(OutputDevice& dev,
             stopTime = myPendingIntervals.front().second;
             myPendingIntervals.pop_front();
         }
-        openInterval(dev, startTime, stopTime);
+        openInterval(dev, startTime, stopTime, myID);
         if (myAggregate) {
             writeAggregated(dev, startTime, stopTime);
         } else {
-            MSEdgeVector::const_iterator edge = myEdges.begin();
-            for (const std::vector<MeanDataValues*>& measures : myMeasures) {
-                writeEdge(dev, measures, *edge, startTime, stopTime);
-                ++edge;
+            if (myTrackActive) {
+                addToCoarseIntervals(startTime);
             }
+            writeEdges(dev, myMeasures, getEdgesToWrite(myActiveEdges), startTime, stopTime);
+        }
+        if (myTrackActive) {
+            clearActive();
         }
         dev.closeTag();
+        writeCoarseIntervals(dev, stopTime, false);
     }
     dev.flush();
 }
 
 
+void
+MSMeanData::writeEdges(OutputDevice& dev, const std::vector<std::vector<MeanDataValues*> >& measures,
+                       const std::vector<int>& edgeIndices, SUMOTime startTime, SUMOTime stopTime) {
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1 && !MSGlobals::gUseMesoSim && edgeIndices.size() > 1) {
+        MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+        const int numEdges = (int)edgeIndices.size();
+        const int numChunks = MIN2(numEdges, 4 * threadPool.size());
+        std::vector<OutputDevice_String*> buffers;
+        for (int i = 0; i < numChunks; i++) {
+            // the edges are written below the root and the interval element
+            buffers.push_back(new OutputDevice_String(2));
+            buffers.back()->setPrecision(dev.getPrecision());
+            threadPool.add(new WriteTask(*this, *buffers.back(), measures, edgeIndices.begin() + i * numEdges / numChunks,
+                                         edgeIndices.begin() + (i + 1) * numEdges / numChunks, startTime, stopTime), i % threadPool.size());
+        }
+        threadPool.waitAll();
+        for (OutputDevice_String* const buffer : buffers) {
+            const std::string content = buffer->getString();
+            if (!content.empty()) {
+                dev.writePreformattedTag(content);
+            }
+            delete buffer;
+        }
+        return;
+    }
+#endif
+#endif
+    for (const int edgeIndex : edgeIndices) {
+        writeEdge(dev, measures[edgeIndex], myEdges[edgeIndex], startTime, stopTime);
+    }
+}
+
+
+#ifdef HAVE_FOX
+void
+MSMeanData::WriteTask::run(MFXWorkerThread* /*context*/) {
+    for (std::vector<int>::const_iterator it = myBegin; it != myEnd; ++it) {
+        myMeanData.writeEdge(myInto, myMeasures[*it], myMeanData.myEdges[*it], myStartTime, myStopTime);
+    }
+}
+#endif
+
+
 void
 MSMeanData::writeXMLDetectorProlog(OutputDevice& dev) const {
     dev.writeXMLHeader("meandata", "meandata_file.xsd");
@@ -28,6 +28,9 @@
 #include <microsim/output/MSDetectorFileOutput.h>
 #include <microsim/MSMoveReminder.h>
 #include <utils/common/SUMOTime.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 
 
 // ===========================================================================
@@ -166,6 +169,27 @@ public:
             return 0;
         }
 
+        /// @brief sets the index of the edge in the parent which is reported on the first data of each interval
+        void setEdgeIndex(const int index) {
+            myEdgeIndex = index;
+        }
+
+        /// @brief forgets that data was collected in the current interval (after writing or resetting)
+        void clearActive() {
+            myAmActive = false;
+        }
+
+    protected:
+        /** @brief Reports the first data of the current interval to the parent
+         * @note the caller must hold the notification lock
+         */
+        void markActive() {
+            if (!myAmActive && myEdgeIndex >= 0) {
+                myAmActive = true;
+                myParent->markActive(myEdgeIndex);
+            }
+        }
+
     protected:
         /// @brief The meandata parent
         const MSMeanData* const myParent;
@@ -182,6 +206,13 @@ public:
         double travelledDistance;
         //@}
 
+    private:
+        /// @brief The index of the edge in the parent (-1 if the parent does not keep track of active edges)
+        int myEdgeIndex;
+
+        /// @brief Whether data was collected (and reported to the parent) in the current interval
+        bool myAmActive;
+
     };
 
 
@@ -329,6 +360,32 @@ public:
      */
     void init();
 
+    /** @brief Sets additional (longer) aggregation periods
+     *
+     * The data of each written interval is added to the values of the
+     *  additional periods which are written to the same device whenever such a
+     *  period is complete, so there is only one set of move reminders per lane.
+     * @param[in] periods The additional periods, each a multiple of the detector period
+     */
+    void setCoarsePeriods(const std::vector<SUMOTime>& periods);
+
+    /** @brief Writes the additional aggregation periods which are not complete at the end of the simulation
+     *
+     * The intervals get the id of the detector with the period appended.
+     * @param[in] dev The output device to write the data into
+     * @param[in] stopTime The end of the simulation
+     */
+    void writeIncompleteCoarseIntervals(OutputDevice& dev, const SUMOTime stopTime);
+
+    /** @brief Reports that the given edge received data in the current interval
+     *
+     * Only the edges reported here are written (unless empty edges are written)
+     *  and reset after each interval which makes the output cost proportional
+     *  to the number of edges used instead of the network size.
+     * @param[in] edgeIndex The index of the edge in myEdges
+     */
+    void markActive(const int edgeIndex) const;
+
     /// @name Methods inherited from MSDetectorFileOutput.
     /// @{
 
@@ -337,7 +394,11 @@ public:
      * At first, it is checked whether the values for the current interval shall be written.
      *  If not, a reset is performed, only, using "resetOnly". Otherwise,
      *  both the list of single-lane edges and the list of multi-lane edges
-     *  are gone through and each edge is written using "writeEdge".
+     *  are gone through and each edge is written using "writeEdge". Unless
+     *  empty edges shall be written, only the edges which received data are visited.
+     *  If multiple simulation threads are used (and the simulation is not
+     *  mesoscopic), contiguous ranges of edges are written into separate
+     *  buffers in parallel which are then appended in edge order.
      *
      * @param[in] dev The output device to write the data into
      * @param[in] startTime First time step the data were gathered
@@ -423,6 +484,17 @@ protected:
     void writeEdge(OutputDevice& dev, const std::vector<MeanDataValues*>& edgeValues,
                    const MSEdge* const edge, SUMOTime startTime, SUMOTime stopTime);
 
+    /** @brief Writes the values of the given edges (in parallel if multiple simulation threads are used)
+     *
+     * @param[in] dev The output device to write the data into
+     * @param[in] measures The values to write (indexed like myEdges)
+     * @param[in] edgeIndices The (sorted) indices of the edges to write
+     * @param[in] startTime First time step the data were gathered
+     * @param[in] stopTime Last time step the data were gathered
+     */
+    void writeEdges(OutputDevice& dev, const std::vector<std::vector<MeanDataValues*> >& measures,
+                    const std::vector<int>& edgeIndices, SUMOTime startTime, SUMOTime stopTime);
+
 
     /** @brief Writes aggregate of all edge values into the given stream
      *
@@ -442,8 +514,9 @@ protected:
      * @param[in] dev The output device to write the data into
      * @param[in] startTime First time step the data were gathered
      * @param[in] stopTime Last time step the data were gathered
+     * @param[in] id The id of the interval
      */
-    virtual void openInterval(OutputDevice& dev, const SUMOTime startTime, const SUMOTime stopTime);
+    virtual void openInterval(OutputDevice& dev, const SUMOTime startTime, const SUMOTime stopTime, const std::string& id);
 
     /** @brief Checks for emptiness and writes prefix into the given stream
      *
@@ -510,6 +583,74 @@ private:
     /// @brief The intervals for which output still has to be generated (only in the tracking case)
     std::list< std::pair<SUMOTime, SUMOTime> > myPendingIntervals;
 
+    /// @brief Whether the edges receiving data are recorded (microsim without vehicle tracking only)
+    bool myTrackActive;
+
+    /// @brief The indices of the edges which received data in the current interval (unsorted)
+    mutable std::vector<int> myActiveEdges;
+
+    /// @brief Whether the edge with the given index is contained in myActiveEdges
+    mutable std::vector<bool> myEdgeActive;
+
+#ifdef HAVE_FOX
+    /// @brief the mutex for access to the active edges
+    mutable FXMutex myActiveMutex;
+#endif
+
+    /// @brief The values of an additional aggregation period
+    struct CoarseInterval {
+        /// @brief the length of the period
+        SUMOTime period;
+        /// @brief the begin of the current period (-1 if no data was added yet)
+        SUMOTime begin;
+        /// @brief the values of each edge (built on first use, indexed like myEdges)
+        std::vector<std::vector<MeanDataValues*> > measures;
+        /// @brief The indices of the edges which received data in the current period (unsorted)
+        std::vector<int> activeEdges;
+        /// @brief Whether the edge with the given index is contained in activeEdges
+        std::vector<bool> edgeActive;
+    };
+
+    /// @brief The additional aggregation periods
+    std::vector<CoarseInterval> myCoarseIntervals;
+
+    /// @brief Returns the (sorted) indices of the edges to write for the given active set
+    std::vector<int> getEdgesToWrite(const std::vector<int>& activeEdges) const;
+
+    /// @brief Forgets the edges which received data in the current interval
+    void clearActive();
+
+    /// @brief Adds the data of the active edges to the additional aggregation periods (before they are reset)
+    void addToCoarseIntervals(const SUMOTime startTime);
+
+    /// @brief Writes the additional aggregation periods which are complete (or all which received data when closing)
+    void writeCoarseIntervals(OutputDevice& dev, const SUMOTime stopTime, const bool closing);
+
+    /// @brief Returns the values of an additional aggregation period for the given edge
+    std::vector<MeanDataValues*>& getCoarseValues(CoarseInterval& coarse, const int edgeIndex);
+
+#ifdef HAVE_FOX
+    /// @brief writes a range of edges into a buffer
+    class WriteTask : public MFXWorkerThread::Task {
+    public:
+        WriteTask(MSMeanData& meanData, OutputDevice& into, const std::vector<std::vector<MeanDataValues*> >& measures,
+                  std::vector<int>::const_iterator begin, std::vector<int>::const_iterator end, SUMOTime startTime, SUMOTime stopTime) :
+            myMeanData(meanData), myInto(into), myMeasures(measures), myBegin(begin), myEnd(end), myStartTime(startTime), myStopTime(stopTime) {}
+        void run(MFXWorkerThread* context);
+    private:
+        MSMeanData& myMeanData;
+        OutputDevice& myInto;
+        const std::vector<std::vector<MeanDataValues*> >& myMeasures;
+        const std::vector<int>::const_iterator myBegin;
+        const std::vector<int>::const_iterator myEnd;
+        const SUMOTime myStartTime;
+        const SUMOTime myStopTime;
+    private:
+        /// @brief Invalidated assignment operator.
+        WriteTask& operator=(const WriteTask&) = delete;
+    };
+#endif
+
 private:
     /// @brief Invalidated copy constructor.
     MSMeanData(const MSMeanData&);
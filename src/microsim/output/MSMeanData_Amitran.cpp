@@ -24,6 +24,8 @@
 #include <microsim/MSEdge.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSVehicle.h>
+#include <microsim/MSGlobals.h>
+#include <utils/common/ScopedLocker.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/ToString.h>
 #include <utils/iodevices/OutputDevice.h>
@@ -89,6 +91,10 @@ MSMeanData_Amitran::MSLaneMeanDataValues::notifyEnter(SUMOTrafficObject& veh, MS
     if (myParent->vehicleApplies(veh)) {
         if (getLane() == nullptr || getLane() == static_cast<MSVehicle&>(veh).getLane()) {
             if (reason == MSMoveReminder::NOTIFICATION_DEPARTED || reason == MSMoveReminder::NOTIFICATION_JUNCTION) {
+#ifdef HAVE_FOX
+                ScopedLocker<> lock(myNotificationMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+                markActive();
                 ++amount;
                 typedAmount[&veh.getVehicleType()]++;
             }
@@ -171,9 +177,10 @@ MSMeanData_Amitran::getEdgeID(const MSEdge* const edge) {
 
 
 void
-MSMeanData_Amitran::openInterval(OutputDevice& dev, const SUMOTime startTime, const SUMOTime stopTime) {
+MSMeanData_Amitran::openInterval(OutputDevice& dev, const SUMOTime startTime, const SUMOTime stopTime, const std::string& id) {
     const int duration = int(1000 * STEPS2TIME(stopTime - startTime) + 0.5);
     dev.openTag(SUMO_TAG_TIMESLICE).writeAttr(SUMO_ATTR_STARTTIME, int(1000 * STEPS2TIME(startTime) + 0.5)).writeAttr(SUMO_ATTR_DURATION, duration);
+    dev.writeAttr(SUMO_ATTR_ID, id);
 }
 
 
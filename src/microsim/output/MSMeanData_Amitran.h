@@ -192,8 +192,9 @@ public:
      * @param[in] dev The output device to write the data into
      * @param[in] startTime First time step the data were gathered
      * @param[in] stopTime Last time step the data were gathered
+     * @param[in] id The id of the interval
      */
-    virtual void openInterval(OutputDevice& dev, const SUMOTime startTime, const SUMOTime stopTime);
+    virtual void openInterval(OutputDevice& dev, const SUMOTime startTime, const SUMOTime stopTime, const std::string& id);
 
     /** @brief Checks for emptiness and writes prefix into the given stream
      *
@@ -59,6 +59,8 @@ const std::vector<std::string> MSActuatedTrafficLightLogic::OPERATOR_PRECEDENCE(
 #define DEFAULT_DETECTOR_GAP "2.0"
 #define DEFAULT_INACTIVE_THRESHOLD "180"
 #define DEFAULT_CURRENT_PRIORITY 10
+// idle logics are checked anyway after this time (which limits the lifetime of descheduled switch commands)
+#define IDLE_RECHECK_INTERVAL TIME2STEPS(60)
 
 #define DEFAULT_LENGTH_WITH_GAP 7.5
 #define DEFAULT_BIKE_LENGTH_WITH_GAP (getDefaultVehicleLength(SVC_BICYCLE) + 0.5)
@@ -85,6 +87,8 @@ MSActuatedTrafficLightLogic::MSActuatedTrafficLightLogic(MSTLLogicControl& tlcon
     myAssignments(assignments),
     myFunctions(functions),
     myTraCISwitch(false),
+    myIdleSince(-1),
+    myIdleColoring(false),
     myDetectorPrefix(id + "_" + programID + "_") {
     myMaxGap = StringUtils::toDouble(getParameter("max-gap", DEFAULT_MAX_GAP));
     myJamThreshold = StringUtils::toDouble(getParameter("jam-threshold", OptionsCont::getOptions().getValueString("tls.actuated.jam-threshold")));
@@ -475,6 +479,9 @@ MSActuatedTrafficLightLogic::init(NLDetectorBuilder& nb) {
         myLinkRedTimes = std::vector<SUMOTime>(myNumLinks, 0);
     }
     //std::cout << SIMTIME << " linkMaxGreenTimes=" << toString(myLinkMaxGreenTimes) << "\n";
+    for (InductLoopInfo& loopInfo : myInductLoops) {
+        loopInfo.loop->addEntryListener(this);
+    }
 }
 
 SUMOTime
@@ -633,6 +640,7 @@ MSActuatedTrafficLightLogic::deactivateProgram() {
 void
 MSActuatedTrafficLightLogic::changeStepAndDuration(MSTLLogicControl& tlcontrol,
         SUMOTime simStep, int step, SUMOTime stepDuration) {
+    wakeUp(tlcontrol);
     // do not change timing if the phase changes
     if (step >= 0 && step != myStep) {
         myStep = step;
@@ -652,6 +660,7 @@ MSActuatedTrafficLightLogic::changeStepAndDuration(MSTLLogicControl& tlcontrol,
 
 void
 MSActuatedTrafficLightLogic::loadState(MSTLLogicControl& tlcontrol, SUMOTime t, int step, SUMOTime spentDuration) {
+    myIdleSince = -1;
     const SUMOTime lastSwitch = t - spentDuration;
     myStep = step;
     myPhases[myStep]->myLastSwitch = lastSwitch;
@@ -670,26 +679,12 @@ MSActuatedTrafficLightLogic::trySwitch() {
     // @note any vehicles which arrived during the previous phases which are now waiting between the detector and the stop line are not
     // considere here. RiLSA recommends to set minDuration in a way that lets all vehicles pass the detector
     SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
-    executeAssignments(myAssignments, myConditions);
-
-    if (myLinkGreenTimes.size() > 0) {
-        // constraints exist, record green time durations for each link
-        const std::string& state = getCurrentPhaseDef().getState();
-        SUMOTime lastDuration = SIMSTEP - myLastTrySwitchTime;
-        for (int i = 0; i < myNumLinks; i++) {
-            if (state[i] == 'G' || state[i] == 'g') {
-                myLinkGreenTimes[i] += lastDuration;
-            } else {
-                myLinkGreenTimes[i] = 0;
-            }
-            if (state[i] == 'r' || state[i] == 'u') {
-                myLinkRedTimes[i] += lastDuration;
-            } else {
-                myLinkRedTimes[i] = 0;
-            }
-        }
+    if (myIdleSince >= 0) {
+        // regular check while idle
+        resumeFromIdle(now - TIME2STEPS(1));
     }
-    myLastTrySwitchTime = now;
+    executeAssignments(myAssignments, myConditions);
+    recordLinkDurations(now);
     // decide the next phase
     const bool multiTarget = myPhases[myStep]->nextPhases.size() > 1 && myPhases[myStep]->nextPhases.front() >= 0;
     const int origStep = myStep;
@@ -763,7 +758,109 @@ MSActuatedTrafficLightLogic::trySwitch() {
     }
 #endif
     SUMOTime minRetry = myStep != origStep ? 0 : TIME2STEPS(1);
-    return MAX3(minRetry, getMinDur() - actDuration, getEarliest(prevStart));
+    const SUMOTime next = MAX3(minRetry, getMinDur() - actDuration, getEarliest(prevStart));
+    if (next == TIME2STEPS(1) && myStep == origStep && canBeIdle()) {
+        // skip the checks until a vehicle enters a detector
+        myIdleSince = now;
+        myIdleColoring = (myShowDetectors || myHasMultiTarget) && getCurrentPhaseDef().isGreenPhase();
+        return IDLE_RECHECK_INTERVAL;
+    }
+    return next;
+}
+
+
+void
+MSActuatedTrafficLightLogic::recordLinkDurations(SUMOTime t) {
+    if (myLinkGreenTimes.size() > 0) {
+        // constraints exist, record green time durations for each link
+        const std::string& state = getCurrentPhaseDef().getState();
+        SUMOTime lastDuration = t - myLastTrySwitchTime;
+        for (int i = 0; i < myNumLinks; i++) {
+            if (state[i] == 'G' || state[i] == 'g') {
+                myLinkGreenTimes[i] += lastDuration;
+            } else {
+                myLinkGreenTimes[i] = 0;
+            }
+            if (state[i] == 'r' || state[i] == 'u') {
+                myLinkRedTimes[i] += lastDuration;
+            } else {
+                myLinkRedTimes[i] = 0;
+            }
+        }
+    }
+    myLastTrySwitchTime = t;
+}
+
+
+// ------------ idle logic methods
+bool
+MSActuatedTrafficLightLogic::canBeIdle() const {
+    // the skipped checks must take place at the begin of a step and must not depend on time or custom expressions
+    if (MSGlobals::gUseMesoSim || TIME2STEPS(1) % DELTA_T != 0 || SIMSTEP != MSTrafficLightLogic::getNextSwitchTime()
+            || !myConditions.empty() || !myAssignments.empty() || mySwitchingRules[myStep].enabled
+            || getEarliestEnd() != MSPhaseDefinition::UNSPECIFIED_DURATION) {
+        return false;
+    }
+    // no detector may give priority to any phase until a vehicle enters it
+    for (const InductLoopInfo& loopInfo : myInductLoops) {
+        const double gap = loopInfo.loop->getTimeSinceLastDetection();
+        if (loopInfo.loop->getOverrideTime() >= 0 || gap == 0 || gap < loopInfo.maxGap
+                || loopInfo.lastGreenTime < loopInfo.loop->getLastDetectionTime()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+SUMOTime
+MSActuatedTrafficLightLogic::getNextIdleCheck() const {
+    const SUMOTime period = TIME2STEPS(1);
+    // the checks of the current step are over once the switch commands were executed
+    const SUMOTime earliest = SIMSTEP + (MSNet::getInstance()->getTLSControl().switchCommandsExecuted(SIMSTEP) ? DELTA_T : 0);
+    return myIdleSince + MAX2(SUMOTime(1), (earliest - myIdleSince + period - 1) / period) * period;
+}
+
+
+void
+MSActuatedTrafficLightLogic::resumeFromIdle(SUMOTime lastSkipped) {
+    if (lastSkipped > myIdleSince) {
+        recordLinkDurations(lastSkipped);
+        if (myIdleColoring) {
+            for (InductLoopInfo* loopInfo : myInductLoopsForPhase[myStep]) {
+                loopInfo->lastGreenTime = lastSkipped;
+            }
+        }
+    }
+    myIdleSince = -1;
+}
+
+
+void
+MSActuatedTrafficLightLogic::wakeUp(MSTLLogicControl& tlcontrol) {
+    if (myIdleSince >= 0) {
+        const SUMOTime next = getNextIdleCheck();
+        resumeFromIdle(next - TIME2STEPS(1));
+        if (next != MSTrafficLightLogic::getNextSwitchTime()) {
+            mySwitchCommand->deschedule(this);
+            mySwitchCommand = new SwitchCommand(tlcontrol, this, next);
+            MSNet::getInstance()->getBeginOfTimestepEvents()->addEvent(mySwitchCommand, next);
+        }
+    }
+}
+
+
+SUMOTime
+MSActuatedTrafficLightLogic::getNextSwitchTime() const {
+    return myIdleSince >= 0 ? getNextIdleCheck() : MSSimpleTrafficLightLogic::getNextSwitchTime();
+}
+
+
+void
+MSActuatedTrafficLightLogic::vehicleEntered(const MSInductLoop& /* loop */) {
+    if (myIdleSince >= 0) {
+        MSNet::getInstance()->getTLSControl().requestWakeUp(this);
+    }
 }
 
 
@@ -1337,6 +1434,7 @@ MSActuatedTrafficLightLogic::getParameter(const std::string& key, const std::str
 
 void
 MSActuatedTrafficLightLogic::setParameter(const std::string& key, const std::string& value) {
+    wakeUp(MSNet::getInstance()->getTLSControl());
     // some pre-defined parameters can be updated at runtime
     if (key == "detector-gap" || key == "passing-time" || key == "file" || key == "freq" || key == "vTypes"
             || StringUtils::startsWith(key, "linkMaxDur")
@@ -44,8 +44,13 @@ class NLDetectorBuilder;
 /**
  * @class MSActuatedTrafficLightLogic
  * @brief An actuated (adaptive) traffic light logic
+ *
+ * If the current phase is kept while no detector is occupied or recently passed,
+ *  the outcome of the following switch checks cannot change until a vehicle enters a detector.
+ *  These checks are skipped (the logic is idle) and the detectors wake up the logic at its
+ *  next regular check instead.
  */
-class MSActuatedTrafficLightLogic : public MSSimpleTrafficLightLogic {
+class MSActuatedTrafficLightLogic : public MSSimpleTrafficLightLogic, public MSInductLoop::EntryListener {
 public:
 
     typedef Parameterised::Map ConditionMap;
@@ -103,8 +108,17 @@ public:
      * @see MSTrafficLightLogic::trySwitch
      */
     SUMOTime trySwitch() override;
+
+    /// @brief resumes the switch checks if the logic is idle
+    void wakeUp(MSTLLogicControl& tlcontrol) override;
     /// @}
 
+    /// @brief returns the time of the next switch check (also while idle)
+    SUMOTime getNextSwitchTime() const override;
+
+    /// @brief requests a wake up if the logic is idle
+    void vehicleEntered(const MSInductLoop& loop) override;
+
     SUMOTime getMinDur(int step = -1) const override;
     SUMOTime getMaxDur(int step = -1) const override;
     SUMOTime getEarliestEnd(int step = -1) const override;
@@ -237,6 +251,18 @@ protected:
     /// @brief the minimum duratin for keeping the current phase due to linkMinDur constraints
     SUMOTime getLinkMinDuration(int target) const;
 
+    /// @brief adds the time since the last switch check to the green and red durations of the links
+    void recordLinkDurations(SUMOTime t);
+
+    /// @brief whether the current phase is kept by all switch checks until a vehicle enters a detector
+    bool canBeIdle() const;
+
+    /// @brief the first switch check skipped while idle which has not taken place yet
+    SUMOTime getNextIdleCheck() const;
+
+    /// @brief applies the effects of the switch checks skipped while idle up to the given time
+    void resumeFromIdle(SUMOTime lastSkipped);
+
     template<typename T, SumoXMLTag Tag>
     const T* retrieveDetExpression(const std::string& arg, const std::string& expr, bool tryPrefix) const {
         const T* det = dynamic_cast<const T*>(
@@ -323,6 +349,12 @@ protected:
     /// @brief whether the next switch time was requested via TraCI
     bool myTraCISwitch;
 
+    /// @brief the time of the last switch check before becoming idle (-1 if not idle)
+    SUMOTime myIdleSince;
+
+    /// @brief whether the skipped switch checks update the green times of the detectors
+    bool myIdleColoring;
+
     struct SwitchingRules {
         bool enabled = false;
     };
@@ -39,6 +39,8 @@
 #include <utils/common/StringUtils.h>
 #include <utils/common/ToString.h>
 #include <utils/common/MsgHandler.h>
+#include <utils/common/ScopedLocker.h>
+#include <microsim/MSGlobals.h>
 
 #define TRACI_PROGRAM "online"
 
@@ -517,7 +519,7 @@ MSTLLogicControl::WAUTSwitchProcedure_Stretch::stretchLogic(SUMOTime step, SUMOT
  * method definitions for MSTLLogicControl
  * ----------------------------------------------------------------------- */
 MSTLLogicControl::MSTLLogicControl()
-    : myNetWasLoaded(false) {}
+    : myNetWasLoaded(false), myLastSwitchCheck(-1) {}
 
 
 MSTLLogicControl::~MSTLLogicControl() {
@@ -799,6 +801,7 @@ MSTLLogicControl::initWautSwitch(MSTLLogicControl::SwitchInitCommand& cmd) {
 
 void
 MSTLLogicControl::check2Switch(SUMOTime step) {
+    myLastSwitchCheck = step;
     for (std::vector<WAUTSwitchProcess>::iterator i = myCurrentlySwitched.begin(); i != myCurrentlySwitched.end();) {
         const WAUTSwitchProcess& proc = *i;
         if (proc.proc->trySwitch(step)) {
@@ -815,6 +818,24 @@ MSTLLogicControl::check2Switch(SUMOTime step) {
 }
 
 
+void
+MSTLLogicControl::requestWakeUp(MSTrafficLightLogic* tl) {
+#ifdef HAVE_FOX
+    ScopedLocker<> lock(myWakeUpMutex, MSGlobals::gNumSimThreads > 1);
+#endif
+    myWakeUpRequests.push_back(tl);
+}
+
+
+void
+MSTLLogicControl::wakeUpIdle() {
+    for (MSTrafficLightLogic* const tl : myWakeUpRequests) {
+        tl->wakeUp(*this);
+    }
+    myWakeUpRequests.clear();
+}
+
+
 std::pair<SUMOTime, MSPhaseDefinition>
 MSTLLogicControl::getPhaseDef(const std::string& tlid) const {
     MSTrafficLightLogic* tl = getActive(tlid);
@@ -842,6 +863,7 @@ MSTLLogicControl::saveState(OutputDevice& out) {
 void
 MSTLLogicControl::clearState(SUMOTime time, bool quickReload) {
     MSRailSignalConstraint::clearState();
+    myWakeUpRequests.clear();
     if (quickReload) {
         for (const auto& variants : myLogics) {
             for (auto& logic : variants.second->getAllLogics()) {
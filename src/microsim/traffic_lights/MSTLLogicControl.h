@@ -29,6 +29,9 @@
 #include <utils/common/Command.h>
 #include <utils/common/StdDefs.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/fxheader.h>
+#endif
 
 
 // ===========================================================================
@@ -344,6 +347,27 @@ public:
     void check2Switch(SUMOTime step);
 
 
+    /** @brief Requests that an idle logic resumes its switch checks
+     *
+     * May be called from multiple threads (by detectors), the requests are served by wakeUpIdle
+     * @param[in] tl The logic to wake up
+     */
+    void requestWakeUp(MSTrafficLightLogic* tl);
+
+
+    /** @brief Lets all logics which requested it resume their switch checks
+     *
+     * Called from MSNet::simulationStep before the switch commands of the step are executed
+     */
+    void wakeUpIdle();
+
+
+    /// @brief Returns whether the switch commands of the given step were already executed
+    bool switchCommandsExecuted(SUMOTime step) const {
+        return myLastSwitchCheck >= step;
+    }
+
+
     /** @brief return the complete phase definition for a named traffic lights logic
      *
      * The phase definition will be the current of the currently active program of
@@ -753,6 +777,17 @@ protected:
     /// @brief Information whether the net was completely loaded
     bool myNetWasLoaded;
 
+    /// @brief The last step for which check2Switch was called
+    SUMOTime myLastSwitchCheck;
+
+    /// @brief The idle logics which shall resume their switch checks
+    std::vector<MSTrafficLightLogic*> myWakeUpRequests;
+
+#ifdef HAVE_FOX
+    /// @brief The mutex for myWakeUpRequests
+    FXMutex myWakeUpMutex;
+#endif
+
 
 private:
     /// @brief Invalidated copy constructor.
@@ -155,6 +155,11 @@ public:
      */
     virtual SUMOTime trySwitch() = 0;
 
+    /** @brief Lets a logic which skips its switch checks while idle resume them
+     * @param[in] tlcontrol The responsible traffic lights control
+     */
+    virtual void wakeUp(MSTLLogicControl& /*tlcontrol*/) {}
+
     /// @brief called when switching programs
     virtual void activateProgram();
     virtual void deactivateProgram();
@@ -295,7 +300,7 @@ public:
      * The time may change in case of adaptive/actuated traffic lights.
      * @return The assumed next switch time (simulation time)
      */
-    SUMOTime getNextSwitchTime() const;
+    virtual SUMOTime getNextSwitchTime() const;
 
 
     /** @brief Returns the duration spent in the current phase
@@ -0,0 +1,410 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSPModel_Grid.cpp
+/// @author  agent
+/// @date    2026-10-17
+///
+// A cellular pedestrian model on a grid over sidewalks, crossings and walkingareas
+/****************************************************************************/
+#include <config.h>
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <utils/common/RandHelper.h>
+#include <utils/options/OptionsCont.h>
+#include <microsim/MSNet.h>
+#include <microsim/MSEdge.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/MSLane.h>
+#include <microsim/MSLink.h>
+#include <microsim/MSStoppingPlace.h>
+#include <microsim/MSVehicle.h>
+#include <microsim/MSGlobals.h>
+#include <microsim/transportables/MSStage.h>
+#include <microsim/transportables/MSTransportableControl.h>
+#include "MSPModel_Grid.h"
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSPModel_Grid::MSPModel_Grid(const OptionsCont& oc, MSNet* net) :
+    MSPModel_Striping(oc, net) {
+}
+
+
+MSPModel_Grid::~MSPModel_Grid() {
+}
+
+
+void
+MSPModel_Grid::moveAll(SUMOTime currentTime) {
+    // the occupancy of the lane entries is the only information used across lanes while moving
+    LaneEndOccupancy laneEnds;
+    std::vector<std::pair<const MSLane*, Pedestrians*> > lanes;
+    for (auto& item : myActiveLanes) {
+        const MSLane* const lane = item.first;
+        if (item.second.empty()) {
+            continue;
+        }
+        lanes.push_back(std::make_pair(lane, &item.second));
+        if (!lane->getEdge().isWalkingArea()) {
+            const int stripes = numStripes(lane);
+            LaneEnds& ends = laneEnds[lane];
+            ends.atBegin.assign(stripes, false);
+            ends.atEnd.assign(stripes, false);
+            for (const PState* const p : item.second) {
+                if (!p->myWaitingToEnter && !p->myAmJammed) {
+                    if (p->getMinX(false) < stripeWidth) {
+                        ends.atBegin[p->stripe()] = true;
+                    }
+                    if (p->getMaxX(false) > lane->getLength() - stripeWidth) {
+                        ends.atEnd[p->stripe()] = true;
+                    }
+                }
+            }
+        }
+    }
+    std::vector<LaneResult> results(lanes.size());
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1 && lanes.size() > 1) {
+        MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+        // lanes sharing a random number generator must be moved by the same thread
+        std::vector<MoveLanesTask*> tasks;
+        for (int i = 0; i < threadPool.size(); i++) {
+            tasks.push_back(new MoveLanesTask(lanes, laneEnds, results, currentTime));
+        }
+        for (int i = 0; i < (int)lanes.size(); i++) {
+            tasks[lanes[i].first->getRNGIndex() % threadPool.size()]->add(i);
+        }
+        for (int i = 0; i < threadPool.size(); i++) {
+            threadPool.add(tasks[i], i);
+        }
+        threadPool.waitAll();
+    } else {
+#endif
+#endif
+        for (int i = 0; i < (int)lanes.size(); i++) {
+            moveOnLane(lanes[i].first, *lanes[i].second, laneEnds, currentTime, results[i]);
+        }
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    }
+#endif
+#endif
+    processLaneResults(results, currentTime);
+    std::set<MSPerson*> changedLane;
+    for (auto& item : lanes) {
+        arriveAndAdvance(*item.second, currentTime, changedLane, FORWARD);
+        arriveAndAdvance(*item.second, currentTime, changedLane, BACKWARD);
+    }
+}
+
+
+void
+MSPModel_Grid::moveOnLane(const MSLane* lane, Pedestrians& pedestrians, const LaneEndOccupancy& laneEnds,
+                          SUMOTime currentTime, LaneResult& result) {
+    Occupancy occupancy;
+    occupancy.reserve(2 * pedestrians.size());
+    for (const PState* const p : pedestrians) {
+        if (!p->myWaitingToEnter && !p->myAmJammed) {
+            occupancy[cellKey(*p, p->myRelX, p->myRelY)] = p;
+        }
+    }
+    if (lane->getEdge().isWalkingArea()) {
+        blockVehicleCells(lane, occupancy);
+    }
+    const int stripes = numStripes(lane);
+    Obstacles crossingVehsFwd(stripes, Obstacle(FORWARD));
+    Obstacles crossingVehsBwd(stripes, Obstacle(BACKWARD));
+    bool hasCrossingVehsFwd = false;
+    bool hasCrossingVehsBwd = false;
+    if (lane->getEdge().isCrossing()) {
+        // assume that vehicles will brake when already on the crossing
+        hasCrossingVehsFwd = addCrossingVehs(lane, stripes, 0, FORWARD, crossingVehsFwd, true);
+        hasCrossingVehsBwd = addCrossingVehs(lane, stripes, 0, BACKWARD, crossingVehsBwd, true);
+    }
+    // the pedestrians closest to the end of the lane move first
+    std::vector<std::pair<double, PState*> > order;
+    order.reserve(pedestrians.size());
+    for (PState* const p : pedestrians) {
+        order.push_back(std::make_pair(p->distToLaneEnd(), p));
+    }
+    std::sort(order.begin(), order.end(), [](const std::pair<double, PState*>& a, const std::pair<double, PState*>& b) {
+        return a.first < b.first || (a.first == b.first && a.second->getID() < b.second->getID());
+    });
+    for (const auto& item : order) {
+        PState& p = *item.second;
+        if (p.myRemoteXYPos != Position::INVALID) {
+            continue;
+        }
+        const Obstacles* crossingVehs = nullptr;
+        if (p.myDir == FORWARD && hasCrossingVehsFwd) {
+            crossingVehs = &crossingVehsFwd;
+        } else if (p.myDir == BACKWARD && hasCrossingVehsBwd) {
+            crossingVehs = &crossingVehsBwd;
+        }
+        movePedestrian(p, lane, occupancy, laneEnds, crossingVehs, currentTime, result);
+    }
+}
+
+
+void
+MSPModel_Grid::movePedestrian(PState& p, const MSLane* lane, Occupancy& occupancy, const LaneEndOccupancy& laneEnds,
+                              const Obstacles* crossingVehs, SUMOTime currentTime, LaneResult& result) {
+    const int stripes = numStripes(lane);
+    const int current = p.stripe();
+    const double vMax = (p.myStage->getConfiguredSpeed() >= 0
+                         ? p.myStage->getConfiguredSpeed()
+                         : (lane->isNormal() || lane->isInternal()
+                            ? lane->getVehicleMaxSpeed(p.myPerson)
+                            : p.myStage->getMaxSpeed(p.myPerson)));
+    const double dawdle = RandHelper::rand(lane->getRNG()) * vMax * dawdling;
+    double maxDist = SPEED2DIST(MAX2(0., vMax - dawdle));
+    const double dist = p.distToLaneEnd();
+    // check link state
+    const MSLink* const link = p.myNLI.link;
+    const double speed = p.myStage->getMaxSpeed(p.myPerson);
+    if (link != nullptr && dist - p.getMinGap() < LOOKAHEAD_SAMEDIR * speed) {
+        // time gap to pass the intersection ahead of a vehicle.
+        const double passingClearanceTime = 2;
+        const double passingLength = p.getLength() + passingClearanceTime * speed;
+        // persons move before vehicles so we subtract DELTA_TO because they cannot rely on vehicles having passed the intersection in the current time step
+        if (!link->opened(currentTime - DELTA_T, speed, speed, passingLength, p.getImpatience(currentTime), speed, 0, 0, nullptr, p.ignoreRed(link), p.myPerson)) {
+            maxDist = MIN2(maxDist, MAX2(0., dist - NUMERICAL_EPS));
+            if (p.myWalkingAreaPath != nullptr) {
+                // consider rerouting over another crossing
+                result.reroute.push_back(&p);
+            }
+        }
+    }
+    // wait in front of a full stopping place
+    const MSStoppingPlace* const stop = p.myStage->getDestinationStop();
+    if (&lane->getEdge() == p.myStage->getDestination() && stop != nullptr && stop->getWaitingCapacity() <= stop->getNumWaitingPersons()) {
+        maxDist = MIN2(maxDist, MAX2(0., p.myDir * (p.myStage->getArrivalPos() - p.myRelX) - p.getMinGap()));
+    }
+    // wait in front of a full lane
+    if (dist < maxDist && p.myNLI.lane != nullptr && entryBlocked(p, laneEnds)) {
+        maxDist = MAX2(0., dist - NUMERICAL_EPS);
+    }
+    if (p.myAmJammed) {
+        const PState* blocker = nullptr;
+        if (freeDistance(p, occupancy, current, maxDist, blocker) < MIN_STARTUP_DIST) {
+            // squeeze through the other pedestrians
+            p.mySpeed = vMax / 4;
+            p.mySpeedLat = 0;
+            p.myRelX += SPEED2DIST(p.mySpeed * p.myDir);
+            p.myWaitingToEnter = false;
+            p.myWaitingTime = 0;
+            p.myAngle = std::numeric_limits<double>::max();
+            return;
+        }
+        p.myAmJammed = false;
+    }
+    Obstacles vehObs;
+    if (lane->getVehicleNumberWithPartials() > 0) {
+        // react to vehicles on the same lane
+        vehObs = getVehicleObstacles(lane, p.myDir, &p);
+    }
+    const bool onJunction = lane->getEdge().isWalkingArea() || lane->getEdge().isCrossing();
+    const int reserved = getReserved(stripes, (onJunction ? RESERVE_FOR_ONCOMING_FACTOR_JUNCTIONS : RESERVE_FOR_ONCOMING_FACTOR));
+    int chosen = -1;
+    double chosenDist = 0;
+    double bestUtility = -std::numeric_limits<double>::max();
+    const PState* chosenBlocker = nullptr;
+    for (int s = MAX2(0, current - 1); s <= MIN2(stripes - 1, current + 1); s++) {
+        if (s != current || p.myWaitingToEnter) {
+            // the pedestrian must be able to step into the stripe
+            const auto it = occupancy.find(cellKey(p, p.myRelX, s * stripeWidth));
+            if (it != occupancy.end() && it->second != &p) {
+                continue;
+            }
+        }
+        double limit = maxDist;
+        if (vehObs.size() > 0) {
+            limit = MIN2(limit, vehicleLimit(p, vehObs[s]));
+        }
+        if (crossingVehs != nullptr) {
+            limit = MIN2(limit, vehicleLimit(p, (*crossingVehs)[s]));
+        }
+        const PState* blocker = nullptr;
+        const double free = freeDistance(p, occupancy, s, limit, blocker);
+        double utility = free;
+        if (s != current) {
+            // keep the stripe unless there is a clear advantage
+            utility -= 0.5 * stripeWidth;
+        }
+        if (blocker != nullptr && blocker->myDir != p.myDir) {
+            // avoid oncoming pedestrians
+            utility -= stripeWidth;
+        }
+        if ((p.myDir == FORWARD && s < reserved) || (p.myDir == BACKWARD && s >= stripes - reserved)) {
+            utility -= stripeWidth;
+        }
+        if (utility > bestUtility) {
+            bestUtility = utility;
+            chosen = s;
+            chosenDist = free;
+            chosenBlocker = blocker;
+        }
+    }
+    if (chosen < 0) {
+        chosen = current;
+        chosenDist = 0;
+    } else if (p.mySpeed == 0 && chosenBlocker != nullptr && chosenDist < MIN_STARTUP_DIST) {
+        chosenDist = 0;
+    }
+    const bool moving = !p.myWaitingToEnter || chosenDist > 0 || chosen != current;
+    const long long int oldKey = cellKey(p, p.myRelX, p.myRelY);
+    const double newRelY = chosen * stripeWidth;
+    p.myRelX += p.myDir * chosenDist;
+    p.mySpeed = DIST2SPEED(chosenDist);
+    p.mySpeedLat = DIST2SPEED(newRelY - p.myRelY);
+    p.myRelY = newRelY;
+    if (moving) {
+        const auto it = occupancy.find(oldKey);
+        if (it != occupancy.end() && it->second == &p) {
+            occupancy.erase(it);
+        }
+        occupancy[cellKey(p, p.myRelX, p.myRelY)] = &p;
+    }
+    if (p.mySpeed >= SUMO_const_haltingSpeed) {
+        p.myWaitingToEnter = false;
+        p.myWaitingTime = 0;
+    } else {
+        p.myWaitingTime += DELTA_T;
+        const bool narrowOncoming = stripes == 1 && chosenBlocker != nullptr && chosenBlocker->myDir != p.myDir;
+        if (p.myWaitingTime > (lane->getEdge().isCrossing() ? jamTimeCrossing : jamTime)
+                || (narrowOncoming && p.myWaitingTime > jamTimeNarrow)) {
+            p.myAmJammed = true;
+            result.jammed.push_back(&p);
+            const auto it = occupancy.find(cellKey(p, p.myRelX, p.myRelY));
+            if (it != occupancy.end() && it->second == &p) {
+                occupancy.erase(it);
+            }
+        }
+    }
+    p.myAngle = std::numeric_limits<double>::max(); // set on first access or via remote control
+}
+
+
+double
+MSPModel_Grid::freeDistance(const PState& p, const Occupancy& occupancy, int stripe, double maxDist, const PState*& blocker) {
+    // sample with half the cell size to visit every cell on walkingareas as well
+    const double step = 0.5 * stripeWidth;
+    const double relY = stripe * stripeWidth;
+    double dist = 0;
+    while (dist < maxDist) {
+        const double next = MIN2(dist + step, maxDist);
+        const auto it = occupancy.find(cellKey(p, p.myRelX + p.myDir * next, relY));
+        if (it != occupancy.end() && it->second != &p) {
+            blocker = it->second;
+            return dist;
+        }
+        dist = next;
+    }
+    return maxDist;
+}
+
+
+double
+MSPModel_Grid::vehicleLimit(const PState& p, const Obstacle& obstacle) {
+    const double dist = p.distanceTo(obstacle, false);
+    return dist == DIST_OVERLAP ? 0. : MAX2(0., dist);
+}
+
+
+long long int
+MSPModel_Grid::cellKey(const PState& p, double relX, double relY) {
+    const WalkingAreaPath* const path = p.myWalkingAreaPath;
+    if (path != nullptr) {
+        const double lateral_offset = relY + (stripeWidth - p.myLane->getWidth()) * 0.5;
+        if (path->angleOverride == INVALID_DOUBLE) {
+            return netCellKey(path->shape.positionAtOffset(relX, lateral_offset));
+        }
+        const double rotationOffset = p.myDir == FORWARD ? 0 : DEG2RAD(180);
+        return netCellKey(path->shape.sidePositionAtAngle(relX, lateral_offset, path->angleOverride + rotationOffset));
+    }
+    const int x = (int)floor(relX / stripeWidth);
+    const int y = PState::stripe(relY);
+    return (long long int)(((unsigned long long int)(unsigned int)x << 32) | (unsigned int)y);
+}
+
+
+long long int
+MSPModel_Grid::netCellKey(const Position& pos) {
+    const int x = (int)floor(pos.x() / stripeWidth);
+    const int y = (int)floor(pos.y() / stripeWidth);
+    return (long long int)(((unsigned long long int)(unsigned int)x << 32) | (unsigned int)y);
+}
+
+
+void
+MSPModel_Grid::blockVehicleCells(const MSLane* walkingArea, Occupancy& occupancy) {
+    const auto itFoe = myWalkingAreaFoes.find(&walkingArea->getEdge());
+    if (itFoe == myWalkingAreaFoes.end()) {
+        return;
+    }
+    const double step = 0.5 * stripeWidth;
+    for (const MSLane* const foeLane : itFoe->second) {
+        for (auto itVeh = foeLane->anyVehiclesBegin(); itVeh != foeLane->anyVehiclesEnd(); ++itVeh) {
+            const MSVehicle* const veh = *itVeh;
+            const Position front = veh->getPosition();
+            const Position back = veh->getBackPosition();
+            const double length = front.distanceTo2D(back);
+            if (length < NUMERICAL_EPS) {
+                continue;
+            }
+            const double dx = (front.x() - back.x()) / length;
+            const double dy = (front.y() - back.y()) / length;
+            // persons should require less gap than the vehicles to prevent getting stuck when a vehicle moves towards them
+            const double halfWidth = 0.5 * (veh->getVehicleType().getWidth() + SAFETY_GAP);
+            for (double along = 0; along <= length + step; along += step) {
+                const double a = MIN2(along, length);
+                for (double side = -halfWidth; side <= halfWidth + step; side += step) {
+                    const double b = MIN2(side, halfWidth);
+                    // blocked cells do not replace pedestrians which are already there
+                    occupancy.insert(std::make_pair(netCellKey(Position(back.x() + a * dx - b * dy, back.y() + a * dy + b * dx)), nullptr));
+                }
+            }
+        }
+    }
+}
+
+
+bool
+MSPModel_Grid::entryBlocked(const PState& p, const LaneEndOccupancy& laneEnds) {
+    const auto it = laneEnds.find(p.myNLI.lane);
+    if (it == laneEnds.end()) {
+        // empty lane or walkingarea
+        return false;
+    }
+    const std::vector<bool>& entry = p.myNLI.dir == FORWARD ? it->second.atBegin : it->second.atEnd;
+    return std::find(entry.begin(), entry.end(), false) == entry.end();
+}
+
+
+#ifdef HAVE_FOX
+void
+MSPModel_Grid::MoveLanesTask::run(MFXWorkerThread* /*context*/) {
+    for (const int index : myIndices) {
+        moveOnLane(myLanes[index].first, *myLanes[index].second, myLaneEnds, myTime, myResults[index]);
+    }
+}
+#endif
+
+
+/****************************************************************************/
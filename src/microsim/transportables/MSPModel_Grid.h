@@ -0,0 +1,132 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSPModel_Grid.h
+/// @author  agent
+/// @date    2026-10-17
+///
+// A cellular pedestrian model on a grid over sidewalks, crossings and walkingareas
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <unordered_map>
+#include <vector>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
+#include "MSPModel_Striping.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSPModel_Grid
+ * @brief A cellular automaton for pedestrians
+ *
+ * Every lane used by pedestrians is covered by square cells whose size equals the stripe width.
+ *  On sidewalks and crossings the cells are aligned with the lane, on walkingareas they are aligned
+ *  with the network coordinates, so pedestrians on different walkingarea paths block each other
+ *  without any coordinate transformations. Each cell holds at most one pedestrian.
+ *
+ * In every step the pedestrians of a lane move in the order of their distance to the end of the lane
+ *  (the static floor field) and choose among their current and the two neighboring stripes the one
+ *  which lets them advance furthest. Vehicles, closed links and full stopping places limit the
+ *  advance like in the striping model. The lanes do not influence each other within a step (a lane is
+ *  only entered if it had a free stripe at its entry at the start of the step), so they are moved in
+ *  parallel if multiple simulation threads are used. The advancement to the next lane is done serially.
+ *
+ * Walkingarea paths, routing across intersections, the interaction with vehicles and the queries
+ *  by vehicles (blockedAtDist, nextBlocking, hasPedestrians) are shared with MSPModel_Striping.
+ */
+class MSPModel_Grid : public MSPModel_Striping {
+
+    friend class MSPModel_GridTest;
+
+public:
+    /// @brief Constructor (it should not be necessary to construct more than one instance)
+    MSPModel_Grid(const OptionsCont& oc, MSNet* net);
+
+    ~MSPModel_Grid();
+
+protected:
+    /// @brief move all pedestrians and advance them to their next lanes
+    void moveAll(SUMOTime currentTime);
+
+private:
+    /// @brief the stripes of a lane which are occupied close to its begin and its end
+    struct LaneEnds {
+        std::vector<bool> atBegin;
+        std::vector<bool> atEnd;
+    };
+    typedef std::map<const MSLane*, LaneEnds, lane_by_numid_sorter> LaneEndOccupancy;
+
+    /// @brief the occupied cells of a lane (nullptr denotes a cell blocked by a vehicle)
+    typedef std::unordered_map<long long int, const PState*> Occupancy;
+
+    /// @brief moves the pedestrians of a single lane
+    static void moveOnLane(const MSLane* lane, Pedestrians& pedestrians, const LaneEndOccupancy& laneEnds,
+                           SUMOTime currentTime, LaneResult& result);
+
+    /// @brief moves a single pedestrian and updates the occupancy
+    static void movePedestrian(PState& p, const MSLane* lane, Occupancy& occupancy, const LaneEndOccupancy& laneEnds,
+                               const Obstacles* crossingVehs, SUMOTime currentTime, LaneResult& result);
+
+    /// @brief returns the distance the pedestrian may walk on the given stripe before reaching an occupied cell
+    static double freeDistance(const PState& p, const Occupancy& occupancy, int stripe, double maxDist, const PState*& blocker);
+
+    /// @brief returns the cell containing the given position of the pedestrian
+    static long long int cellKey(const PState& p, double relX, double relY);
+
+    /// @brief returns the cell of a walkingarea containing the given network position
+    static long long int netCellKey(const Position& pos);
+
+    /// @brief returns the distance the pedestrian may walk before reaching the given vehicle obstacle
+    static double vehicleLimit(const PState& p, const Obstacle& obstacle);
+
+    /// @brief marks the cells covered by vehicles on the foe lanes of the walkingarea as blocked
+    static void blockVehicleCells(const MSLane* walkingArea, Occupancy& occupancy);
+
+    /// @brief whether all stripes at the entry of the next lane are occupied
+    static bool entryBlocked(const PState& p, const LaneEndOccupancy& laneEnds);
+
+#ifdef HAVE_FOX
+    /// @brief moves the pedestrians of some lanes (all lanes using the same random number generator are moved by one task)
+    class MoveLanesTask : public MFXWorkerThread::Task {
+    public:
+        MoveLanesTask(std::vector<std::pair<const MSLane*, Pedestrians*> >& lanes, const LaneEndOccupancy& laneEnds,
+                      std::vector<LaneResult>& results, SUMOTime currentTime) :
+            myLanes(lanes), myLaneEnds(laneEnds), myResults(results), myTime(currentTime) {}
+        void run(MFXWorkerThread* context);
+        /// @brief adds the index of a lane to move
+        void add(int index) {
+            myIndices.push_back(index);
+        }
+    private:
+        std::vector<std::pair<const MSLane*, Pedestrians*> >& myLanes;
+        const LaneEndOccupancy& myLaneEnds;
+        std::vector<LaneResult>& myResults;
+        const SUMOTime myTime;
+        std::vector<int> myIndices;
+    private:
+        /// @brief Invalidated assignment operator.
+        MoveLanesTask& operator=(const MoveLanesTask&) = delete;
+    };
+#endif
+
+private:
+    /// @brief Invalidated assignment operator.
+    MSPModel_Grid& operator=(const MSPModel_Grid&) = delete;
+
+};
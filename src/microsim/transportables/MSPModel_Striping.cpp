@@ -28,6 +28,7 @@
 #include <utils/router/PedestrianRouter.h>
 #include <microsim/MSNet.h>
 #include <microsim/MSEdge.h>
+#include <microsim/MSEdgeControl.h>
 #include <microsim/MSEventControl.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSLink.h>
@@ -114,7 +115,9 @@ const double MSPModel_Striping::MIN_STARTUP_DIST(0.4); // meters
 
 MSPModel_Striping::MSPModel_Striping(const OptionsCont& oc, MSNet* net) :
     myNumActivePedestrians(0),
-    myAmActive(false) {
+    myAmActive(false),
+    myMoveInParallel(false),
+    myAllowParallel(oc.getBool("pedestrian.striping.parallel")) {
     myWalkingAreaDetail = oc.getInt("pedestrian.striping.walkingarea-detail");
     initWalkingAreaPaths(net);
     // configurable parameters
@@ -831,7 +834,16 @@ MSPModel_Striping::getNextLaneObstacles(NextLanesObstacles& nextLanesObs, const
                 }
             }
         }
-        Pedestrians& pedestrians = getPedestrians(nextLane);
+        // when moving in parallel the pedestrians on the next lane are taken as they were before moving in this direction
+        // (and copied because they get sorted)
+        Pedestrians snapshot;
+        if (myMoveInParallel) {
+            const auto itSnapshot = myNextLaneSnapshot.find(nextLane);
+            if (itSnapshot != myNextLaneSnapshot.end()) {
+                snapshot = itSnapshot->second;
+            }
+        }
+        Pedestrians& pedestrians = myMoveInParallel ? snapshot : getPedestrians(nextLane);
         if (nextLane->getEdge().isWalkingArea()) {
             transformToCurrentLanePositions(obs, currentDir, nextDir, currentLength, nextLength);
             // complex transformation into the coordinate system of the current lane
@@ -843,7 +855,7 @@ MSPModel_Striping::getNextLaneObstacles(NextLanesObstacles& nextLanesObs, const
             nextDir = currentDir;
             // transform pedestrians into the current coordinate system
             for (int ii = 0; ii < (int)pedestrians.size(); ++ii) {
-                PState& p = *pedestrians[ii];
+                const PState& p = *pedestrians[ii];
                 if (p.myWaitingToEnter || p.myAmJammed) {
                     continue;
                 }
@@ -936,152 +948,209 @@ MSPModel_Striping::addCloserObstacle(Obstacles& obs, double x, int stripe, int n
 
 void
 MSPModel_Striping::moveInDirection(SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    if (myAllowParallel && MSGlobals::gNumSimThreads > 1 && myActiveLanes.size() > 1) {
+        moveInDirectionParallel(currentTime, changedLane, dir);
+        return;
+    }
+#endif
+#endif
     for (ActiveLanes::iterator it_lane = myActiveLanes.begin(); it_lane != myActiveLanes.end(); ++it_lane) {
-        const MSLane* lane = it_lane->first;
-        Pedestrians& pedestrians = it_lane->second;
-        if (pedestrians.size() == 0) {
-            continue;
+        if (it_lane->second.size() > 0) {
+            moveLaneInDirection(it_lane->first, it_lane->second, currentTime, changedLane, dir, nullptr);
         }
-        //std::cout << SIMTIME << ">>> lane=" << lane->getID() << " numPeds=" << pedestrians.size() << "\n";
-        if (lane->getEdge().isWalkingArea()) {
-            const double lateral_offset = (lane->getWidth() - stripeWidth) * 0.5;
-            const double minY = stripeWidth * - 0.5 + NUMERICAL_EPS;
-            const double maxY = stripeWidth * (numStripes(lane) - 0.5) - NUMERICAL_EPS;
-            const WalkingAreaPath* debugPath = nullptr;
-            // need to handle each walkingAreaPath separately and transform
-            // coordinates beforehand
-            std::set<const WalkingAreaPath*, walkingarea_path_sorter> paths;
-            for (Pedestrians::iterator it = pedestrians.begin(); it != pedestrians.end(); ++it) {
-                const PState* p = *it;
-                assert(p->myWalkingAreaPath != 0);
-                if (p->myDir == dir) {
-                    paths.insert(p->myWalkingAreaPath);
-                    if DEBUGCOND(*p) {
-                        debugPath = p->myWalkingAreaPath;
-                        std::cout << SIMTIME << " debugging WalkingAreaPath from=" << debugPath->from->getID() << " to=" << debugPath->to->getID() << " minY=" << minY << " maxY=" << maxY << " latOffset=" << lateral_offset << "\n";
-                    }
+    }
+}
+
+
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+void
+MSPModel_Striping::moveInDirectionParallel(SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
+    updateNextLaneSnapshot(dir);
+    std::vector<std::pair<const MSLane*, Pedestrians*> > lanes;
+    for (auto& item : myActiveLanes) {
+        if (item.second.size() > 0) {
+            lanes.push_back(std::make_pair(item.first, &item.second));
+        }
+    }
+    std::vector<LaneResult> results(lanes.size());
+    MFXWorkerThread::Pool& threadPool = MSNet::getInstance()->getEdgeControl().getThreadPool();
+    // lanes sharing a random number generator must be moved by the same thread
+    std::vector<MoveInDirectionTask*> tasks;
+    for (int i = 0; i < threadPool.size(); i++) {
+        tasks.push_back(new MoveInDirectionTask(*this, lanes, results, changedLane, currentTime, dir));
+    }
+    for (int i = 0; i < (int)lanes.size(); i++) {
+        tasks[lanes[i].first->getRNGIndex() % threadPool.size()]->add(i);
+    }
+    myMoveInParallel = true;
+    for (int i = 0; i < threadPool.size(); i++) {
+        threadPool.add(tasks[i], i);
+    }
+    threadPool.waitAll();
+    myMoveInParallel = false;
+    clearNextLaneSnapshot();
+    processLaneResults(results, currentTime);
+    for (const LaneResult& result : results) {
+        advance(result.departing, currentTime, changedLane, dir);
+    }
+}
+#endif
+#endif
+
+
+void
+MSPModel_Striping::moveLaneInDirection(const MSLane* lane, Pedestrians& pedestrians, SUMOTime currentTime,
+                                       std::set<MSPerson*>& changedLane, int dir, LaneResult* result) {
+    //std::cout << SIMTIME << ">>> lane=" << lane->getID() << " numPeds=" << pedestrians.size() << "\n";
+    if (lane->getEdge().isWalkingArea()) {
+        const double lateral_offset = (lane->getWidth() - stripeWidth) * 0.5;
+        const double minY = stripeWidth * - 0.5 + NUMERICAL_EPS;
+        const double maxY = stripeWidth * (numStripes(lane) - 0.5) - NUMERICAL_EPS;
+        const WalkingAreaPath* debugPath = nullptr;
+        // need to handle each walkingAreaPath separately and transform
+        // coordinates beforehand
+        std::set<const WalkingAreaPath*, walkingarea_path_sorter> paths;
+        for (Pedestrians::iterator it = pedestrians.begin(); it != pedestrians.end(); ++it) {
+            const PState* p = *it;
+            assert(p->myWalkingAreaPath != 0);
+            if (p->myDir == dir) {
+                paths.insert(p->myWalkingAreaPath);
+                if DEBUGCOND(*p) {
+                    debugPath = p->myWalkingAreaPath;
+                    std::cout << SIMTIME << " debugging WalkingAreaPath from=" << debugPath->from->getID() << " to=" << debugPath->to->getID() << " minY=" << minY << " maxY=" << maxY << " latOffset=" << lateral_offset << "\n";
                 }
             }
-            const double usableWidth = (numStripes(lane) - 1) * stripeWidth;
-            for (std::set<const WalkingAreaPath*, walkingarea_path_sorter>::iterator it = paths.begin(); it != paths.end(); ++it) {
-                const WalkingAreaPath* path = *it;
-                Pedestrians toDelete;
-                Pedestrians transformedPeds;
-                transformedPeds.reserve(pedestrians.size());
-                for (Pedestrians::iterator it_p = pedestrians.begin(); it_p != pedestrians.end(); ++it_p) {
-                    PState* p = *it_p;
-                    if (p->myWalkingAreaPath == path) {
+        }
+        const double usableWidth = (numStripes(lane) - 1) * stripeWidth;
+        for (std::set<const WalkingAreaPath*, walkingarea_path_sorter>::iterator it = paths.begin(); it != paths.end(); ++it) {
+            const WalkingAreaPath* path = *it;
+            Pedestrians toDelete;
+            Pedestrians transformedPeds;
+            transformedPeds.reserve(pedestrians.size());
+            for (Pedestrians::iterator it_p = pedestrians.begin(); it_p != pedestrians.end(); ++it_p) {
+                PState* p = *it_p;
+                if (p->myWalkingAreaPath == path) {
+                    transformedPeds.push_back(p);
+                    if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (untransformed), vecCoord="
+                                                         << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
+                } else if (p->myWalkingAreaPath->from == path->to && p->myWalkingAreaPath->to == path->from) {
+                    if (p->myWalkingAreaPath->dir != path->dir) {
+                        // opposite direction is already in the correct coordinate system
                         transformedPeds.push_back(p);
                         if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (untransformed), vecCoord="
                                                              << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
-                    } else if (p->myWalkingAreaPath->from == path->to && p->myWalkingAreaPath->to == path->from) {
-                        if (p->myWalkingAreaPath->dir != path->dir) {
-                            // opposite direction is already in the correct coordinate system
-                            transformedPeds.push_back(p);
-                            if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (untransformed), vecCoord="
-                                                                 << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
-                        } else {
-                            // x position must be reversed
-                            PState* tp = new PState(*p);
-                            tp->myRelX = path->length - p->myRelX;
-                            tp->myRelY = usableWidth - p->myRelY;
-                            tp->myDir = !path->dir;
-                            tp->mySpeed = -p->mySpeed;
-                            tp->mySpeedLat = -p->mySpeedLat;
-                            toDelete.push_back(tp);
-                            transformedPeds.push_back(tp);
-                            if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (semi-transformed), vecCoord="
-                                                                 << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
+                    } else {
+                        // x position must be reversed
+                        PState* tp = new PState(*p);
+                        tp->myRelX = path->length - p->myRelX;
+                        tp->myRelY = usableWidth - p->myRelY;
+                        tp->myDir = !path->dir;
+                        tp->mySpeed = -p->mySpeed;
+                        tp->mySpeedLat = -p->mySpeedLat;
+                        toDelete.push_back(tp);
+                        transformedPeds.push_back(tp);
+                        if (path == debugPath) std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << p->myRelX << " relY=" << p->myRelY << " (semi-transformed), vecCoord="
+                                                             << path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1)) << "\n";
+                    }
+                } else {
+                    const Position relPos = path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1));
+                    const double newY = relPos.y() + lateral_offset;
+                    if (relPos != Position::INVALID && newY >= minY && newY <= maxY) {
+                        PState* tp = new PState(*p);
+                        tp->myRelX = relPos.x();
+                        tp->myRelY = newY;
+                        // only an obstacle, speed may be orthogonal to dir
+                        tp->myDir = !dir;
+                        tp->mySpeed = 0;
+                        tp->mySpeedLat = 0;
+                        toDelete.push_back(tp);
+                        transformedPeds.push_back(tp);
+                        if (path == debugPath) {
+                            std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (transformed), vecCoord=" << relPos << "\n";
                         }
                     } else {
-                        const Position relPos = path->shape.transformToVectorCoordinates(p->getPosition(*p->myStage, -1));
-                        const double newY = relPos.y() + lateral_offset;
-                        if (relPos != Position::INVALID && newY >= minY && newY <= maxY) {
-                            PState* tp = new PState(*p);
-                            tp->myRelX = relPos.x();
-                            tp->myRelY = newY;
-                            // only an obstacle, speed may be orthogonal to dir
-                            tp->myDir = !dir;
-                            tp->mySpeed = 0;
-                            tp->mySpeedLat = 0;
-                            toDelete.push_back(tp);
-                            transformedPeds.push_back(tp);
-                            if (path == debugPath) {
-                                std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (transformed), vecCoord=" << relPos << "\n";
-                            }
-                        } else {
-                            if (path == debugPath) {
-                                std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (invalid), vecCoord=" << relPos << "\n";
-                            }
+                        if (path == debugPath) {
+                            std::cout << "  ped=" << p->myPerson->getID() << "  relX=" << relPos.x() << " relY=" << newY << " (invalid), vecCoord=" << relPos << "\n";
                         }
                     }
                 }
-                auto itFoe = myWalkingAreaFoes.find(&lane->getEdge());
-                if (itFoe != myWalkingAreaFoes.end()) {
-                    // add vehicle foes on paths which cross this walkingarea
-                    // translate the vehicle into a number of dummy-pedestrians
-                    // that occupy the same space
-                    for (const MSLane* foeLane : itFoe->second) {
-                        for (auto itVeh = foeLane->anyVehiclesBegin(); itVeh != foeLane->anyVehiclesEnd(); ++itVeh) {
-                            const MSVehicle* veh = *itVeh;
-                            const double vehWidth = veh->getVehicleType().getWidth();
-                            Boundary relCorners;
-                            Position relFront = path->shape.transformToVectorCoordinates(veh->getPosition());
-                            Position relBack = path->shape.transformToVectorCoordinates(veh->getBackPosition());
-                            PositionVector relCenter;
-                            relCenter.push_back(relFront);
-                            relCenter.push_back(relBack);
-                            relCenter.move2side(vehWidth / 2);
-                            relCorners.add(relCenter[0]);
-                            relCorners.add(relCenter[1]);
-                            relCenter.move2side(-vehWidth);
-                            relCorners.add(relCenter[0]);
-                            relCorners.add(relCenter[1]);
-                            // persons should requier less gap than the vehicles to prevent getting stuck
-                            // when a vehicles moves towards them
-                            relCorners.growWidth(SAFETY_GAP / 2);
-                            const double xWidth = relCorners.getWidth();
-                            const double vehYmin = MAX2(minY - lateral_offset, relCorners.ymin());
-                            const double vehYmax = MIN2(maxY - lateral_offset, relCorners.ymax());
-                            const double xCenter = relCorners.getCenter().x();
-                            Position yMinPos(xCenter, vehYmin);
-                            Position yMaxPos(xCenter, vehYmax);
-                            const bool addFront = addVehicleFoe(veh, lane, yMinPos, dir * xWidth, 0, lateral_offset, minY, maxY, toDelete, transformedPeds);
-                            const bool addBack = addVehicleFoe(veh, lane, yMaxPos, dir * xWidth, 0, lateral_offset, minY, maxY, toDelete, transformedPeds);
-                            if (path == debugPath) {
-                                std::cout << "  veh=" << veh->getID()
-                                          << " corners=" << relCorners
-                                          << " xWidth=" << xWidth
-                                          << " ymin=" << relCorners.ymin()
-                                          << " ymax=" << relCorners.ymax()
-                                          << " vehYmin=" << vehYmin
-                                          << " vehYmax=" << vehYmax
-                                          << "\n";
-                            }
-                            if (addFront && addBack) {
-                                // add in-between positions
-                                const double yDist = vehYmax - vehYmin;
-                                for (double dist = stripeWidth; dist < yDist; dist += stripeWidth) {
-                                    const double relDist = dist / yDist;
-                                    Position between = (yMinPos * relDist) + (yMaxPos * (1 - relDist));
-                                    if (path == debugPath) {
-                                        std::cout << "  vehBetween=" << veh->getID() << " pos=" << between << "\n";
-                                    }
-                                    addVehicleFoe(veh, lane, between, dir * xWidth, stripeWidth, lateral_offset, minY, maxY, toDelete, transformedPeds);
+            }
+            auto itFoe = myWalkingAreaFoes.find(&lane->getEdge());
+            if (itFoe != myWalkingAreaFoes.end()) {
+                // add vehicle foes on paths which cross this walkingarea
+                // translate the vehicle into a number of dummy-pedestrians
+                // that occupy the same space
+                for (const MSLane* foeLane : itFoe->second) {
+                    for (auto itVeh = foeLane->anyVehiclesBegin(); itVeh != foeLane->anyVehiclesEnd(); ++itVeh) {
+                        const MSVehicle* veh = *itVeh;
+                        const double vehWidth = veh->getVehicleType().getWidth();
+                        Boundary relCorners;
+                        Position relFront = path->shape.transformToVectorCoordinates(veh->getPosition());
+                        Position relBack = path->shape.transformToVectorCoordinates(veh->getBackPosition());
+                        PositionVector relCenter;
+                        relCenter.push_back(relFront);
+                        relCenter.push_back(relBack);
+                        relCenter.move2side(vehWidth / 2);
+                        relCorners.add(relCenter[0]);
+                        relCorners.add(relCenter[1]);
+                        relCenter.move2side(-vehWidth);
+                        relCorners.add(relCenter[0]);
+                        relCorners.add(relCenter[1]);
+                        // persons should requier less gap than the vehicles to prevent getting stuck
+                        // when a vehicles moves towards them
+                        relCorners.growWidth(SAFETY_GAP / 2);
+                        const double xWidth = relCorners.getWidth();
+                        const double vehYmin = MAX2(minY - lateral_offset, relCorners.ymin());
+                        const double vehYmax = MIN2(maxY - lateral_offset, relCorners.ymax());
+                        const double xCenter = relCorners.getCenter().x();
+                        Position yMinPos(xCenter, vehYmin);
+                        Position yMaxPos(xCenter, vehYmax);
+                        const bool addFront = addVehicleFoe(veh, lane, yMinPos, dir * xWidth, 0, lateral_offset, minY, maxY, toDelete, transformedPeds);
+                        const bool addBack = addVehicleFoe(veh, lane, yMaxPos, dir * xWidth, 0, lateral_offset, minY, maxY, toDelete, transformedPeds);
+                        if (path == debugPath) {
+                            std::cout << "  veh=" << veh->getID()
+                                      << " corners=" << relCorners
+                                      << " xWidth=" << xWidth
+                                      << " ymin=" << relCorners.ymin()
+                                      << " ymax=" << relCorners.ymax()
+                                      << " vehYmin=" << vehYmin
+                                      << " vehYmax=" << vehYmax
+                                      << "\n";
+                        }
+                        if (addFront && addBack) {
+                            // add in-between positions
+                            const double yDist = vehYmax - vehYmin;
+                            for (double dist = stripeWidth; dist < yDist; dist += stripeWidth) {
+                                const double relDist = dist / yDist;
+                                Position between = (yMinPos * relDist) + (yMaxPos * (1 - relDist));
+                                if (path == debugPath) {
+                                    std::cout << "  vehBetween=" << veh->getID() << " pos=" << between << "\n";
                                 }
+                                addVehicleFoe(veh, lane, between, dir * xWidth, stripeWidth, lateral_offset, minY, maxY, toDelete, transformedPeds);
                             }
                         }
                     }
                 }
-                moveInDirectionOnLane(transformedPeds, lane, currentTime, changedLane, dir, path == debugPath);
+            }
+            moveInDirectionOnLane(transformedPeds, lane, currentTime, changedLane, dir, path == debugPath, result);
+            if (result != nullptr) {
+                collectDeparting(pedestrians, dir, result->departing);
+            } else {
                 arriveAndAdvance(pedestrians, currentTime, changedLane, dir);
-                // clean up
-                for (Pedestrians::iterator it_p = toDelete.begin(); it_p != toDelete.end(); ++it_p) {
-                    delete *it_p;
-                }
             }
+            // clean up
+            for (Pedestrians::iterator it_p = toDelete.begin(); it_p != toDelete.end(); ++it_p) {
+                delete *it_p;
+            }
+        }
+    } else {
+        moveInDirectionOnLane(pedestrians, lane, currentTime, changedLane, dir, false, result);
+        if (result != nullptr) {
+            collectDeparting(pedestrians, dir, result->departing);
         } else {
-            moveInDirectionOnLane(pedestrians, lane, currentTime, changedLane, dir, false);
             arriveAndAdvance(pedestrians, currentTime, changedLane, dir);
         }
     }
@@ -1135,7 +1204,101 @@ MSPModel_Striping::arriveAndAdvance(Pedestrians& pedestrians, SUMOTime currentTi
 
 
 void
-MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir, bool debug) {
+MSPModel_Striping::collectDeparting(Pedestrians& pedestrians, int dir, Pedestrians& departing) {
+    sort(pedestrians.begin(), pedestrians.end(), by_xpos_sorter(dir));
+    // advancing may trigger re-insertion (for consecutive walks)
+    // so the pedestrians must be removed first
+    Pedestrians::iterator keep = pedestrians.begin();
+    for (PState* const p : pedestrians) {
+        if (!p->isRemoteControlled() && p->myDir == dir && p->distToLaneEnd() < 0) {
+            departing.push_back(p);
+        } else {
+            *keep++ = p;
+        }
+    }
+    pedestrians.erase(keep, pedestrians.end());
+}
+
+
+void
+MSPModel_Striping::advance(const Pedestrians& departing, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir) {
+    // advance to the next lane / arrive at destination
+    for (PState* const p : departing) {
+        p->moveToNextLane(currentTime);
+        if (p->myLane != nullptr) {
+            changedLane.insert(p->myPerson);
+            myActiveLanes[p->myLane].push_back(p);
+        } else {
+            // end walking stage and destroy PState
+            p->myStage->moveToNextEdge(p->myPerson, currentTime, dir);
+            myNumActivePedestrians--;
+        }
+    }
+}
+
+
+void
+MSPModel_Striping::processLaneResults(const std::vector<LaneResult>& results, SUMOTime currentTime) {
+    for (const LaneResult& result : results) {
+        for (const PState* const p : result.jammed) {
+            registerJammed(*p, currentTime);
+        }
+        for (const std::string& warning : result.collisions) {
+            WRITE_WARNING(warning);
+        }
+        for (PState* const p : result.reroute) {
+            // @todo actually another path would be needed starting at the current position
+            p->myNLI = getNextLane(*p, p->myLane, p->myWalkingAreaPath->from);
+        }
+    }
+}
+
+
+void
+MSPModel_Striping::registerJammed(const PState& p, SUMOTime currentTime) {
+    MSNet::getInstance()->getPersonControl().registerJammed();
+    WRITE_WARNINGF(TL("Person '%' is jammed on edge '%', time=%."),
+                   p.myPerson->getID(), p.myStage->getEdge()->getID(), time2string(currentTime));
+}
+
+
+void
+MSPModel_Striping::updateNextLaneSnapshot(int dir) {
+    std::set<const MSLane*, lane_by_numid_sorter> nextLanes;
+    for (const auto& item : myActiveLanes) {
+        for (const PState* const p : item.second) {
+            if (p->myDir == dir && p->myNLI.lane != nullptr && p->distToLaneEnd() <= LOOKAHEAD_ONCOMING) {
+                nextLanes.insert(p->myNLI.lane);
+            }
+        }
+    }
+    for (const MSLane* const lane : nextLanes) {
+        const auto it = myActiveLanes.find(lane);
+        if (it != myActiveLanes.end()) {
+            Pedestrians& copies = myNextLaneSnapshot[lane];
+            for (const PState* const p : it->second) {
+                if (!p->myWaitingToEnter && !p->myAmJammed) {
+                    copies.push_back(new PState(*p));
+                }
+            }
+        }
+    }
+}
+
+
+void
+MSPModel_Striping::clearNextLaneSnapshot() {
+    for (auto& item : myNextLaneSnapshot) {
+        for (PState* const p : item.second) {
+            delete p;
+        }
+    }
+    myNextLaneSnapshot.clear();
+}
+
+
+void
+MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, const std::set<MSPerson*>& changedLane, int dir, bool debug, LaneResult* result) {
     const int stripes = numStripes(lane);
     //std::cout << " laneWidth=" << lane->getWidth() << " stripeWidth=" << stripeWidth << " stripes=" << stripes << "\n";
     Obstacles obs(stripes, Obstacle(dir)); // continously updated
@@ -1226,10 +1389,14 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
                 std::cout << SIMTIME << " ped=" << p.myPerson->getID() << "  obsWithTLS=";
                 DEBUG_PRINT(currentObs);
             }
-            // consider rerouting over another crossing
+            // consider rerouting over another crossing (after all lanes were moved when moving in parallel)
             if (p.myWalkingAreaPath != nullptr) {
-                // @todo actually another path would be needed starting at the current position
-                p.myNLI = getNextLane(p, p.myLane, p.myWalkingAreaPath->from);
+                if (result != nullptr) {
+                    result->reroute.push_back(&p);
+                } else {
+                    // @todo actually another path would be needed starting at the current position
+                    p.myNLI = getNextLane(p, p.myLane, p.myWalkingAreaPath->from);
+                }
             }
         }
         if DEBUGCOND(p) {
@@ -1264,7 +1431,14 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
         }
 
         // walk, taking into account all obstacles
-        p.walk(currentObs, currentTime);
+        // when moving in parallel each lane dawdles with its own random number generator
+        if (p.walk(currentObs, currentTime, result != nullptr ? lane->getRNG() : nullptr)) {
+            if (result != nullptr) {
+                result->jammed.push_back(&p);
+            } else {
+                registerJammed(p, currentTime);
+            }
+        }
         gDebugFlag1 = false;
         if (!p.myWaitingToEnter && !p.myAmJammed) {
             Obstacle o(p);
@@ -1282,8 +1456,13 @@ MSPModel_Striping::moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane*
                             Obstacle cObs(c);
                             // we check only for real collisions, no min gap violations
                             if (p.distanceTo(cObs, false) == DIST_OVERLAP) {
-                                WRITE_WARNING("Collision of person '" + p.myPerson->getID() + "' and person '" + c.myPerson->getID()
-                                              + "', lane='" + lane->getID() + "', time=" + time2string(currentTime) + ".");
+                                const std::string warning = "Collision of person '" + p.myPerson->getID() + "' and person '" + c.myPerson->getID()
+                                                            + "', lane='" + lane->getID() + "', time=" + time2string(currentTime) + ".";
+                                if (result != nullptr) {
+                                    result->collisions.push_back(warning);
+                                } else {
+                                    WRITE_WARNING(warning);
+                                }
                             }
                         }
                     }
@@ -1982,8 +2161,9 @@ MSPModel_Striping::getReserved(int stripes, double factor) {
                (int)floor(RESERVE_FOR_ONCOMING_MAX / stripeWidth));
 }
 
-void
-MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime) {
+bool
+MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime, SumoRNG* rng) {
+    bool startedJam = false;
     const int stripes = (int)obs.size();
     const int sMax =  stripes - 1;
     assert(stripes == numStripes(myLane));
@@ -2123,9 +2303,8 @@ MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime) {
                 || myAmJammed) {
             // squeeze slowly through the crowd ignoring others
             if (!myAmJammed) {
-                MSNet::getInstance()->getPersonControl().registerJammed();
-                WRITE_WARNINGF(TL("Person '%' is jammed on edge '%', time=%."),
-                               myPerson->getID(), myStage->getEdge()->getID(), time2string(SIMSTEP));
+                // registered (and reported) by the model
+                startedJam = true;
                 myAmJammed = true;
             }
             xSpeed = vMax / 4;
@@ -2134,7 +2313,7 @@ MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime) {
         myAmJammed = false;
     }
     // dawdling
-    const double dawdle = MIN2(xSpeed, RandHelper::rand() * vMax * dawdling);
+    const double dawdle = MIN2(xSpeed, RandHelper::rand(rng) * vMax * dawdling);
     xSpeed -= dawdle;
 
     // XXX ensure that diagonal speed <= vMax
@@ -2231,6 +2410,7 @@ MSPModel_Striping::PState::walk(const Obstacles& obs, SUMOTime currentTime) {
         myWaitingTime += DELTA_T;
     }
     myAngle = std::numeric_limits<double>::max(); // set on first access or via remote control
+    return startedJam;
 }
 
 
@@ -2659,12 +2839,19 @@ MSPModel_Striping::PStateVehicle::getMaxX(const bool /*includeMinGap*/) const {
 
 SUMOTime
 MSPModel_Striping::MovePedestrians::execute(SUMOTime currentTime) {
+    myModel->moveAll(currentTime);
+    return DELTA_T;
+}
+
+
+void
+MSPModel_Striping::moveAll(SUMOTime currentTime) {
     std::set<MSPerson*> changedLane;
-    myModel->moveInDirection(currentTime, changedLane, FORWARD);
-    myModel->moveInDirection(currentTime, changedLane, BACKWARD);
+    moveInDirection(currentTime, changedLane, FORWARD);
+    moveInDirection(currentTime, changedLane, BACKWARD);
     // DEBUG
 #ifdef LOG_ALL
-    for (ActiveLanes::const_iterator it_lane = myModel->getActiveLanes().begin(); it_lane != myModel->getActiveLanes().end(); ++it_lane) {
+    for (ActiveLanes::const_iterator it_lane = myActiveLanes.begin(); it_lane != myActiveLanes.end(); ++it_lane) {
         const MSLane* lane = it_lane->first;
         Pedestrians pedestrians = it_lane->second;
         if (pedestrians.size() == 0) {
@@ -2679,6 +2866,15 @@ MSPModel_Striping::MovePedestrians::execute(SUMOTime currentTime) {
         std::cout << "\n";
     }
 #endif
-    return DELTA_T;
 }
 
+
+
+#ifdef HAVE_FOX
+void
+MSPModel_Striping::MoveInDirectionTask::run(MFXWorkerThread* /*context*/) {
+    for (const int index : myIndices) {
+        myModel.moveLaneInDirection(myLanes[index].first, *myLanes[index].second, myTime, myChangedLane, myDir, &myResults[index]);
+    }
+}
+#endif
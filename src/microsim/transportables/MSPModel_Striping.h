@@ -26,6 +26,9 @@
 #include <utils/common/SUMOTime.h>
 #include <utils/common/Command.h>
 #include <utils/options/OptionsCont.h>
+#ifdef HAVE_FOX
+#include <utils/foxtools/MFXWorkerThread.h>
+#endif
 #include <microsim/MSLane.h>
 #include "MSPerson.h"
 #include "MSPModel.h"
@@ -351,8 +354,11 @@ protected:
         /// @brief return whether this pedestrian has passed the end of the current lane and update myRelX if so
         bool moveToNextLane(SUMOTime currentTime);
 
-        /// @brief perform position update
-        void walk(const Obstacles& obs, SUMOTime currentTime);
+        /** @brief perform position update
+         * @param[in] rng The random number generator for dawdling (nullptr for the global one)
+         * @return whether the pedestrian started squeezing through a jam
+         */
+        bool walk(const Obstacles& obs, SUMOTime currentTime, SumoRNG* rng);
 
         /// @brief returns the impatience
         double getImpatience(SUMOTime now) const;
@@ -455,15 +461,67 @@ protected:
     };
 
 
+    /// @brief move all pedestrians and advance them to their next lanes (called once per simulation step)
+    virtual void moveAll(SUMOTime currentTime);
+
+    /// @brief the results of moving the pedestrians of one lane which need serial processing
+    struct LaneResult {
+        /// @brief the pedestrians which started squeezing through a jam
+        std::vector<PState*> jammed;
+        /// @brief the pedestrians waiting at a closed link of a walkingarea which should look for another path
+        std::vector<PState*> reroute;
+        /// @brief the collision warnings
+        std::vector<std::string> collisions;
+        /// @brief the pedestrians which passed the end of the lane (in the order of their advancement)
+        Pedestrians departing;
+    };
+
     /// @brief move all pedestrians forward and advance to the next lane if applicable
     void moveInDirection(SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
 
-    /// @brief move pedestrians forward on one lane
-    void moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir, bool debug);
+#ifndef THREAD_POOL
+#ifdef HAVE_FOX
+    /** @brief move all pedestrians forward using multiple threads
+     *
+     * The lanes only see each other through the pedestrians on their next lanes which are copied
+     *  before moving, and each lane dawdles with its own random number generator. The warnings,
+     *  the rerouting and the advancement to the next lanes are done serially in the order of the
+     *  lanes afterwards. The result does not depend on the number of threads but differs from
+     *  moving the lanes serially, so it is only used if the option pedestrian.striping.parallel is set.
+     */
+    void moveInDirectionParallel(SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
+#endif
+#endif
+
+    /** @brief move pedestrians forward on one lane and advance them to their next lane
+     * @param[in] result The results to process after moving all lanes in parallel (nullptr if the lanes are moved serially)
+     */
+    void moveLaneInDirection(const MSLane* lane, Pedestrians& pedestrians, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir, LaneResult* result);
+
+    /// @brief move pedestrians forward on one lane (or a single walkingarea path)
+    void moveInDirectionOnLane(Pedestrians& pedestrians, const MSLane* lane, SUMOTime currentTime, const std::set<MSPerson*>& changedLane, int dir, bool debug, LaneResult* result);
 
     /// @brief handle arrivals and lane advancement
     void arriveAndAdvance(Pedestrians& pedestrians, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
 
+    /// @brief removes the pedestrians which passed the end of the lane in the given direction and appends them to departing
+    static void collectDeparting(Pedestrians& pedestrians, int dir, Pedestrians& departing);
+
+    /// @brief advances the departing pedestrians to their next lanes or lets them arrive
+    void advance(const Pedestrians& departing, SUMOTime currentTime, std::set<MSPerson*>& changedLane, int dir);
+
+    /// @brief emits the warnings and performs the rerouting collected while moving the lanes
+    static void processLaneResults(const std::vector<LaneResult>& results, SUMOTime currentTime);
+
+    /// @brief counts and reports a pedestrian which started squeezing through a jam
+    static void registerJammed(const PState& p, SUMOTime currentTime);
+
+    /// @brief copies the pedestrians on all lanes which may be looked at as next lanes in the given direction
+    void updateNextLaneSnapshot(int dir);
+
+    /// @brief deletes the copied pedestrians
+    void clearNextLaneSnapshot();
+
     const ActiveLanes& getActiveLanes() {
         return myActiveLanes;
     }
@@ -477,7 +535,7 @@ protected:
         myNumActivePedestrians++;
     }
 
-private:
+protected:
     static void DEBUG_PRINT(const Obstacles& obs);
 
     /// @brief returns the direction in which these lanes are connectioned or 0 if they are not
@@ -537,7 +595,7 @@ private:
     static int getReserved(int stripes, double factor);
 
 
-private:
+protected:
     /// @brief the total number of active pedestrians
     int myNumActivePedestrians;
 
@@ -555,6 +613,41 @@ private:
     /// @brief empty pedestrian vector
     static Pedestrians noPedestrians;
 
+    /// @brief copies of the pedestrians on the next lanes at the start of moving in one direction
+    ActiveLanes myNextLaneSnapshot;
+
+    /// @brief whether the lanes are currently moved in parallel (and the next lanes are read from the copies)
+    bool myMoveInParallel;
+
+    /// @brief whether the lanes may be moved in parallel (option pedestrian.striping.parallel)
+    const bool myAllowParallel;
+
+#ifdef HAVE_FOX
+    /// @brief moves the pedestrians of some lanes (all lanes using the same random number generator are moved by one task)
+    class MoveInDirectionTask : public MFXWorkerThread::Task {
+    public:
+        MoveInDirectionTask(MSPModel_Striping& model, std::vector<std::pair<const MSLane*, Pedestrians*> >& lanes,
+                            std::vector<LaneResult>& results, std::set<MSPerson*>& changedLane, SUMOTime currentTime, int dir) :
+            myModel(model), myLanes(lanes), myResults(results), myChangedLane(changedLane), myTime(currentTime), myDir(dir) {}
+        void run(MFXWorkerThread* context);
+        /// @brief adds the index of a lane to move
+        void add(int index) {
+            myIndices.push_back(index);
+        }
+    private:
+        MSPModel_Striping& myModel;
+        std::vector<std::pair<const MSLane*, Pedestrians*> >& myLanes;
+        std::vector<LaneResult>& myResults;
+        std::set<MSPerson*>& myChangedLane;
+        const SUMOTime myTime;
+        const int myDir;
+        std::vector<int> myIndices;
+    private:
+        /// @brief Invalidated assignment operator.
+        MoveInDirectionTask& operator=(const MoveInDirectionTask&) = delete;
+    };
+#endif
+
 };
 
 
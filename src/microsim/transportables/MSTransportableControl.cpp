@@ -31,6 +31,7 @@
 #include <microsim/transportables/MSStageDriving.h>
 #include <microsim/transportables/MSPModel_NonInteracting.h>
 #include <microsim/transportables/MSPModel_Striping.h>
+#include <microsim/transportables/MSPModel_Grid.h>
 #include <microsim/transportables/MSTransportableControl.h>
 #include <microsim/devices/MSDevice_Vehroutes.h>
 #include <microsim/MSNet.h>
@@ -63,6 +64,8 @@ MSTransportableControl::MSTransportableControl(const bool isPerson):
         myNonInteractingModel = new MSPModel_NonInteracting(oc, net);
         if (model == "striping") {
             myMovementModel = new MSPModel_Striping(oc, net);
+        } else if (model == "grid") {
+            myMovementModel = new MSPModel_Grid(oc, net);
         } else if (model == "nonInteracting") {
             myMovementModel = myNonInteractingModel;
         } else {
@@ -52,6 +52,7 @@
 #include <microsim/transportables/MSTransportable.h>
 #include <microsim/devices/MSDevice_Routing.h>
 #include <microsim/devices/MSRoutingEngine.h>
+#include <libsumo/TraCIConstants.h>
 #include "MSTriggeredRerouter.h"
 
 #include <mesosim/MELoop.h>
@@ -82,7 +83,8 @@ MSTriggeredRerouter::MSTriggeredRerouter(const std::string& id,
     myProbability(prob),
     myUserProbability(prob),
     myAmInUserMode(false),
-    myTimeThreshold(timeThreshold) {
+    myTimeThreshold(timeThreshold),
+    myParkingRouteTableState(nullptr, -1, -1) {
     myInstances[id] = this;
     // build actors
     for (MSEdgeVector::const_iterator j = edges.begin(); j != edges.end(); ++j) {
@@ -774,12 +776,14 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
 
         const double brakeGap = veh.getBrakeGap(true);
 
+        const bool useRouteTable = prepareParkingRouteTable(rerouteDef, veh);
+
         if (onTheWay != nullptr) {
             // compute new route
             if (newDestination) {
                 newRoute.push_back(veh.getEdge());
             } else {
-                bool valid = addParkValues(veh, brakeGap, newDestination, onTheWay, onTheWay->getLastStepOccupancy(), 1, router, parkAreas, newRoutes, parkApproaches, maxValues);
+                bool valid = addParkValues(veh, brakeGap, newDestination, onTheWay, onTheWay->getLastStepOccupancy(), 1, router, parkAreas, newRoutes, parkApproaches, maxValues, useRouteTable);
                 if (!valid) {
                     WRITE_WARNINGF(TL("Parkingarea '%' along the way cannot be used by vehicle '%' for unknown reason"), onTheWay->getID(), veh.getID());
                     return nullptr;
@@ -795,6 +799,9 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
         veh.rememberParkingAreaScore(destParkArea, "occupied");
         veh.rememberBlockedParkingArea(destParkArea, &destParkArea->getLane().getEdge() == veh.getEdge());
 
+        // all routes to the candidates start at the vehicle (the Dijkstra router continues the previous search)
+        router.setAutoBulkMode(true);
+
         const SUMOTime parkingMemory = TIME2STEPS(getWeight(veh, "parking.memory", 600));
         const double parkingFrustration = getWeight(veh, "parking.frustration", 100);
         const double parkingKnowledge = getWeight(veh, "parking.knowledge", 0);
@@ -822,7 +829,7 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
                 }
             }
             if (paOccupancy < pa->getCapacity()) {
-                if (addParkValues(veh, brakeGap, newDestination, pa, paOccupancy, probs[i], router, parkAreas, newRoutes, parkApproaches, maxValues)) {
+                if (addParkValues(veh, brakeGap, newDestination, pa, paOccupancy, probs[i], router, parkAreas, newRoutes, parkApproaches, maxValues, useRouteTable)) {
                     numAlternatives++;
                 }
             } else if (visible) {
@@ -855,7 +862,7 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
                 // all parking areas are occupied. We have no good basis for
                 // prefering one or the other based on estimated occupancy
                 double paOccupancy = RandHelper::rand((double)pa->getCapacity());
-                if (addParkValues(veh, brakeGap, newDestination, pa, paOccupancy, prob, router, parkAreas, newRoutes, parkApproaches, maxValues)) {
+                if (addParkValues(veh, brakeGap, newDestination, pa, paOccupancy, prob, router, parkAreas, newRoutes, parkApproaches, maxValues, useRouteTable)) {
 #ifdef DEBUG_PARKING
                     if (DEBUGCOND) {
                         std::cout << "    altPA=" << pa->getID() << " targeting occupied pa based on blockTime " << STEPS2TIME(std::get<0>(item)) << " among " << blockedTimes.size() << " alternatives\n";
@@ -887,7 +894,7 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
                          );
                 for (auto item : candidates) {
                     MSParkingArea* pa = item.second;
-                    if (addParkValues(veh, brakeGap, newDestination, pa, 0, 1, router, parkAreas, newRoutes, parkApproaches, maxValues)) {
+                    if (addParkValues(veh, brakeGap, newDestination, pa, 0, 1, router, parkAreas, newRoutes, parkApproaches, maxValues, useRouteTable)) {
 #ifdef DEBUG_PARKING
                         if (DEBUGCOND) {
                             std::cout << "    altPA=" << pa->getID() << " targeting occupied pa (based on pure randomness) among " << candidates.size() << " alternatives\n";
@@ -900,6 +907,7 @@ MSTriggeredRerouter::rerouteParkingArea(const MSTriggeredRerouter::RerouteInterv
             }
         }
 
+        router.setAutoBulkMode(false);
         MSNet::getInstance()->getRouterTT(veh.getRNGIndex()); // reset closed edges
 
 #ifdef DEBUG_PARKING
@@ -1016,7 +1024,7 @@ MSTriggeredRerouter::addParkValues(SUMOVehicle& veh, double brakeGap, bool newDe
                                    MSParkingAreaMap_t& parkAreas,
                                    std::map<MSParkingArea*, ConstMSEdgeVector>& newRoutes,
                                    std::map<MSParkingArea*, ConstMSEdgeVector>& parkApproaches,
-                                   ParkingParamMap_t& maxValues) const {
+                                   ParkingParamMap_t& maxValues, bool useRouteTable) const {
     // a map stores the parking values
     ParkingParamMap_t parkValues;
 
@@ -1057,7 +1065,22 @@ MSTriggeredRerouter::addParkValues(SUMOVehicle& veh, double brakeGap, bool newDe
                 nextPos = stopIndices[1].second;
 
             }
-            router.compute(parkEdge, parkPos, nextDestination, nextPos,  &veh, MSNet::getInstance()->getCurrentTimeStep(), edgesFromPark, true);
+            if (useRouteTable && parkEdge != nextDestination) {
+                // the positions only matter for routes looping back to the parking area edge
+                const ParkingRouteKey key(parkEdge, nextDestination, veh.getVClass(), veh.getMaxSpeed(), veh.getChosenSpeedFactor());
+                auto it = myParkingRouteTable.find(key);
+                if (it == myParkingRouteTable.end()) {
+                    if ((int)myParkingRouteTable.size() >= MAX_PARKING_ROUTES) {
+                        myParkingRouteTable.clear();
+                    }
+                    router.compute(parkEdge, parkPos, nextDestination, nextPos,  &veh, MSNet::getInstance()->getCurrentTimeStep(), edgesFromPark, true);
+                    myParkingRouteTable[key] = edgesFromPark;
+                } else {
+                    edgesFromPark = it->second;
+                }
+            } else {
+                router.compute(parkEdge, parkPos, nextDestination, nextPos,  &veh, MSNet::getInstance()->getCurrentTimeStep(), edgesFromPark, true);
+            }
         }
 #ifdef DEBUG_PARKING
         if (DEBUGCOND) {
@@ -1194,6 +1217,27 @@ MSTriggeredRerouter::addParkValues(SUMOVehicle& veh, double brakeGap, bool newDe
 }
 
 
+bool
+MSTriggeredRerouter::prepareParkingRouteTable(const RerouteInterval* rerouteDef, const SUMOVehicle& veh) const {
+    // the travel times of MSNet::getTravelTime must neither depend on the time nor on the individual vehicle
+    const MSVehicle* const microVeh = dynamic_cast<const MSVehicle*>(&veh);
+    if (MSNet::getInstance()->getWeightsStorage().hasTravelTimes()) {
+        return false;
+    }
+    if (microVeh != nullptr && (microVeh->getWeightsStorage().hasTravelTimes()
+                                || (microVeh->getBaseInfluencer() != nullptr
+                                    && microVeh->getBaseInfluencer()->getRoutingMode() == libsumo::ROUTING_MODE_AGGREGATED_CUSTOM))) {
+        return false;
+    }
+    const std::tuple<const RerouteInterval*, SUMOTime, int> state(rerouteDef, MSRoutingEngine::getLastAdaptation(), MSEdge::getChangeCounter());
+    if (state != myParkingRouteTableState) {
+        myParkingRouteTable.clear();
+        myParkingRouteTableState = state;
+    }
+    return true;
+}
+
+
 bool
 MSTriggeredRerouter::vehicleApplies(const SUMOVehicle& veh) const {
     if (myVehicleTypes.empty() || myVehicleTypes.count(veh.getVehicleType().getOriginalID()) > 0) {
@@ -23,10 +23,13 @@
 #pragma once
 #include <config.h>
 
+#include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <utils/common/Command.h>
 #include <utils/common/Named.h>
+#include <utils/common/SUMOVehicleClass.h>
 #include <microsim/MSMoveReminder.h>
 #include <utils/xml/SUMOSAXHandler.h>
 #include <utils/distribution/RandomDistributor.h>
@@ -223,7 +226,18 @@ protected:
                        MSParkingAreaMap_t& parkAreas,
                        std::map<MSParkingArea*, ConstMSEdgeVector>& newRoutes,
                        std::map<MSParkingArea*, ConstMSEdgeVector>& parkApproaches,
-                       ParkingParamMap_t& maxValues) const;
+                       ParkingParamMap_t& maxValues, bool useRouteTable) const;
+
+    /** @brief Checks whether the routes of the vehicle from the parking areas may be taken from the route table
+     *
+     * The table is only valid for the travel times used for vehicles without individual or time dependent
+     *  weights. It is cleared if the rerouting interval, the edge speeds or permissions change and
+     *  whenever the edge weights of the routing device are adapted.
+     */
+    bool prepareParkingRouteTable(const RerouteInterval* rerouteDef, const SUMOVehicle& veh) const;
+
+    /// @brief parking area edge, destination edge, vehicle class, maximum speed and speed factor of a route from a parking area
+    typedef std::tuple<const MSEdge*, const MSEdge*, SUMOVehicleClass, double, double> ParkingRouteKey;
 
 protected:
     /// @brief edges where vehicles are notified
@@ -270,6 +284,15 @@ protected:
 
     static std::map<std::string, MSTriggeredRerouter*> myInstances;
 
+    /// @brief the routes from the parking areas to the destinations of the rerouted vehicles
+    mutable std::map<ParkingRouteKey, ConstMSEdgeVector> myParkingRouteTable;
+
+    /// @brief the rerouting interval, the last weight adaptation and the edge change counter the route table is valid for
+    mutable std::tuple<const RerouteInterval*, SUMOTime, int> myParkingRouteTableState;
+
+    /// @brief the maximum number of routes in the table (it is cleared when exceeded)
+    static const int MAX_PARKING_ROUTES = 100000;
+
 private:
     /// @brief Invalidated copy constructor.
     MSTriggeredRerouter(const MSTriggeredRerouter&);
@@ -464,7 +464,7 @@ NLBuilder::buildDefaultMeanData(const std::string& optionName, const std::string
         try {
             myDetectorBuilder.createEdgeLaneMeanData(id, -1, 0, -1, "traffic", useLanes, false, false,
                     false, false, false, 100000, 0, SUMO_const_haltingSpeed, "", "", std::vector<MSEdge*>(), false,
-                    OptionsCont::getOptions().getString(optionName));
+                    std::vector<SUMOTime>(), OptionsCont::getOptions().getString(optionName));
         } catch (InvalidArgument& e) {
             WRITE_ERROR(e.what());
         } catch (IOError& e) {
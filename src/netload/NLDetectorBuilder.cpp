@@ -506,6 +506,7 @@ NLDetectorBuilder::createEdgeLaneMeanData(const std::string& id, SUMOTime freque
         const std::string& writeAttributes,
         std::vector<MSEdge*> edges,
         bool aggregate,
+        const std::vector<SUMOTime>& coarsePeriods,
         const std::string& device) {
     if (begin < 0) {
         throw InvalidArgument("Negative begin time for meandata dump '" + id + "'.");
@@ -542,6 +543,19 @@ NLDetectorBuilder::createEdgeLaneMeanData(const std::string& id, SUMOTime freque
         } else {
             checkStepLengthMultiple(frequency, " for meandata dump '" + id + "'");
         }
+        if (!coarsePeriods.empty()) {
+            if (MSGlobals::gUseMesoSim || trackVehicles || aggregate) {
+                delete det;
+                throw InvalidArgument("Coarse periods for meandata dump '" + id + "' are not supported with trackVehicles, aggregate or the mesoscopic model.");
+            }
+            for (const SUMOTime period : coarsePeriods) {
+                if (period <= frequency || period % frequency != 0) {
+                    delete det;
+                    throw InvalidArgument("Coarse period " + time2string(period) + " for meandata dump '" + id + "' is not a multiple of the period.");
+                }
+            }
+            det->setCoarsePeriods(coarsePeriods);
+        }
         MSNet::getInstance()->getDetectorControl().add(det, device, frequency, begin);
     }
 }
@@ -351,6 +351,7 @@ public:
      * @param[in] minSamples the minimum number of sample seconds before the values are valid
      * @param[in] haltSpeed the maximum speed to consider a vehicle waiting
      * @param[in] vTypes the set of vehicle types to consider
+     * @param[in] coarsePeriods additional aggregation periods (multiples of frequency) written from the same data
      * @exception InvalidArgument If one of the values is invalid
      */
     void createEdgeLaneMeanData(const std::string& id, SUMOTime frequency,
@@ -362,6 +363,7 @@ public:
                                 const std::string& writeAttributes,
                                 std::vector<MSEdge*> edges,
                                 bool aggregate,
+                                const std::vector<SUMOTime>& coarsePeriods,
                                 const std::string& device);
     /// @}
 
@@ -1330,9 +1330,19 @@ NLHandler::addEdgeLaneMeanData(const SUMOSAXAttributes& attrs, int objecttype) {
     std::vector<std::string> edgeIDs = attrs.getOpt<std::vector<std::string> >(SUMO_ATTR_EDGES, id.c_str(), ok);
     const std::string edgesFile = attrs.getOpt<std::string>(SUMO_ATTR_EDGESFILE, id.c_str(), ok, "");
     const bool aggregate = attrs.getOpt<bool>(SUMO_ATTR_AGGREGATE, id.c_str(), ok, false);
+    const std::vector<std::string> coarsePeriodStrings = attrs.getOpt<std::vector<std::string> >(SUMO_ATTR_COARSE_PERIODS, id.c_str(), ok);
     if (!ok) {
         return;
     }
+    std::vector<SUMOTime> coarsePeriods;
+    for (const std::string& periodString : coarsePeriodStrings) {
+        try {
+            coarsePeriods.push_back(string2time(periodString));
+        } catch (ProcessError&) {
+            WRITE_ERRORF(TL("Invalid coarse period '%' in edgeData definition '%'"), periodString, id);
+            return;
+        }
+    }
     int detectPersons = 0;
     for (std::string mode : StringTokenizer(detectPersonsString).getVector()) {
         if (SUMOXMLDefinitions::PersonModeValues.hasString(mode)) {
@@ -1378,7 +1388,7 @@ NLHandler::addEdgeLaneMeanData(const SUMOSAXAttributes& attrs, int objecttype) {
                 // equivalent to TplConvert::_2bool used in SUMOSAXAttributes::getBool
                 excludeEmpty[0] != 't' && excludeEmpty[0] != 'T' && excludeEmpty[0] != '1' && excludeEmpty[0] != 'x',
                 excludeEmpty == "defaults", withInternal, trackVehicles, detectPersons,
-                maxTravelTime, minSamples, haltingSpeedThreshold, vtypes, writeAttributes, edges, aggregate,
+                maxTravelTime, minSamples, haltingSpeedThreshold, vtypes, writeAttributes, edges, aggregate, coarsePeriods,
                 FileHelpers::checkForRelativity(file, getFileName()));
     } catch (InvalidArgument& e) {
         WRITE_ERROR(e.what());
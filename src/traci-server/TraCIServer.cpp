@@ -988,7 +988,11 @@ TraCIServer::postProcessSimulationStep() {
 #ifdef DEBUG_SUBSCRIPTIONS
     std::cout << "   Size after writing an int is " << mySubscriptionCache.size() << std::endl;
 #endif
-    for (std::vector<libsumo::Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
+    libsumo::Helper::TrafficObjectIndexScope indexScope(libsumo::Helper::countTrafficObjectQueries(mySubscriptions, t));
+    std::vector<libsumo::Helper::ContextObjects> contexts;
+    libsumo::Helper::evaluateContextObjects(mySubscriptions, t, contexts);
+    int index = 0;
+    for (std::vector<libsumo::Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end(); index++) {
         const libsumo::Subscription& s = *i;
         if (s.beginTime > t) {
             ++i;
@@ -996,7 +1000,7 @@ TraCIServer::postProcessSimulationStep() {
         }
         tcpip::Storage into;
         std::string errors;
-        bool ok = processSingleSubscription(s, into, errors);
+        bool ok = processSingleSubscription(s, into, errors, contexts.empty() ? nullptr : &contexts[index]);
 #ifdef DEBUG_SUBSCRIPTIONS
         std::cout << "   Size of into-store for subscription " << s.id
                   << ": " << into.size() << std::endl;
@@ -1132,18 +1136,13 @@ TraCIServer::removeSubscription(int commandId, const std::string& id, int domain
 
 bool
 TraCIServer::processSingleSubscription(const libsumo::Subscription& s, tcpip::Storage& writeInto,
-                                       std::string& errors) {
+                                       std::string& errors, libsumo::Helper::ContextObjects* precomputed) {
     bool ok = true;
     tcpip::Storage outputStorage;
     const int getCommandId = s.contextDomain > 0 ? s.contextDomain : s.commandId - 0x30;
     std::set<std::string> objIDs;
     if (s.contextDomain > 0) {
-        if ((s.activeFilters & libsumo::SUBS_FILTER_NO_RTREE) == 0) {
-            PositionVector shape;
-            libsumo::Helper::findObjectShape(s.commandId, s.id, shape);
-            libsumo::Helper::collectObjectIDsInRange(s.contextDomain, shape, s.range, objIDs);
-        }
-        libsumo::Helper::applySubscriptionFilters(s, objIDs);
+        libsumo::Helper::collectContextObjectIDs(s, precomputed, objIDs);
     } else {
         objIDs.insert(s.id);
     }
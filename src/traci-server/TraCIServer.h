@@ -45,6 +45,7 @@
 #include <microsim/MSNet.h>
 #include <microsim/traffic_lights/MSTrafficLightLogic.h>
 #include <libsumo/TraCIConstants.h>
+#include <libsumo/Helper.h>
 #include <libsumo/Subscription.h>
 #include <libsumo/TraCIDefs.h>
 #include "TraCIServerAPI_Lane.h"
@@ -422,7 +423,7 @@ private:
     void initialiseSubscription(libsumo::Subscription& s);
     void removeSubscription(int commandId, const std::string& identity, int domain);
     bool processSingleSubscription(const libsumo::Subscription& s, tcpip::Storage& writeInto,
-                                   std::string& errors);
+                                   std::string& errors, libsumo::Helper::ContextObjects* precomputed = nullptr);
 
 
     bool addSubscriptionFilter();
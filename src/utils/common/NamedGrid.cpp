@@ -0,0 +1,148 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    NamedGrid.cpp
+/// @author  agent
+/// @date    2026-10-17
+///
+// A uniform grid for storing moving Named objects
+/****************************************************************************/
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include "StdDefs.h"
+#include "NamedGrid.h"
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+NamedGrid::NamedGrid(const double cellSize) :
+    myCellSize(MAX2(cellSize, 1.)) {
+}
+
+
+int
+NamedGrid::cellIndex(const float pos) const {
+    return (int)std::floor(pos / myCellSize);
+}
+
+
+void
+NamedGrid::update(const float a_min[2], const float a_max[2], const Named* const a_data) {
+    const int cellMin[2] = {cellIndex(a_min[0]), cellIndex(a_min[1])};
+    const int cellMax[2] = {cellIndex(a_max[0]), cellIndex(a_max[1])};
+    auto it = myEntries.find(a_data);
+    if (it == myEntries.end()) {
+        it = myEntries.insert(std::make_pair(a_data, Entry())).first;
+        addToCells(a_data, cellMin, cellMax);
+    } else {
+        Entry& e = it->second;
+        if (e.cellMin[0] != cellMin[0] || e.cellMin[1] != cellMin[1] || e.cellMax[0] != cellMax[0] || e.cellMax[1] != cellMax[1]) {
+            removeFromCells(a_data, e.cellMin, e.cellMax);
+            addToCells(a_data, cellMin, cellMax);
+        }
+    }
+    Entry& e = it->second;
+    for (int i = 0; i < 2; i++) {
+        e.min[i] = a_min[i];
+        e.max[i] = a_max[i];
+        e.cellMin[i] = cellMin[i];
+        e.cellMax[i] = cellMax[i];
+    }
+}
+
+
+void
+NamedGrid::remove(const Named* const a_data) {
+    auto it = myEntries.find(a_data);
+    if (it != myEntries.end()) {
+        removeFromCells(a_data, it->second.cellMin, it->second.cellMax);
+        myEntries.erase(it);
+    }
+}
+
+
+void
+NamedGrid::clear() {
+    myCells.clear();
+    myEntries.clear();
+}
+
+
+void
+NamedGrid::addToCells(const Named* const a_data, const int cellMin[2], const int cellMax[2]) {
+    for (int x = cellMin[0]; x <= cellMax[0]; x++) {
+        for (int y = cellMin[1]; y <= cellMax[1]; y++) {
+            myCells[cellKey(x, y)].push_back(a_data);
+        }
+    }
+}
+
+
+void
+NamedGrid::removeFromCells(const Named* const a_data, const int cellMin[2], const int cellMax[2]) {
+    for (int x = cellMin[0]; x <= cellMax[0]; x++) {
+        for (int y = cellMin[1]; y <= cellMax[1]; y++) {
+            auto cell = myCells.find(cellKey(x, y));
+            std::vector<const Named*>& objects = cell->second;
+            auto it = std::find(objects.begin(), objects.end(), a_data);
+            *it = objects.back();
+            objects.pop_back();
+            if (objects.empty()) {
+                myCells.erase(cell);
+            }
+        }
+    }
+}
+
+
+void
+NamedGrid::search(const float a_min[2], const float a_max[2], std::vector<const Named*>& into) const {
+    const int cellMin[2] = {cellIndex(a_min[0]), cellIndex(a_min[1])};
+    const int cellMax[2] = {cellIndex(a_max[0]), cellIndex(a_max[1])};
+    for (int x = cellMin[0]; x <= cellMax[0]; x++) {
+        for (int y = cellMin[1]; y <= cellMax[1]; y++) {
+            auto cell = myCells.find(cellKey(x, y));
+            if (cell == myCells.end()) {
+                continue;
+            }
+            for (const Named* const o : cell->second) {
+                const Entry& e = myEntries.find(o)->second;
+                // report objects spanning multiple cells only in the first cell shared with the search rectangle
+                if (x != MAX2(cellMin[0], e.cellMin[0]) || y != MAX2(cellMin[1], e.cellMin[1])) {
+                    continue;
+                }
+                if (e.min[0] > a_max[0] || a_min[0] > e.max[0] || e.min[1] > a_max[1] || a_min[1] > e.max[1]) {
+                    continue;
+                }
+                into.push_back(o);
+            }
+        }
+    }
+}
+
+
+int
+NamedGrid::Search(const float a_min[2], const float a_max[2], const Named::StoringVisitor& c) const {
+    std::vector<const Named*> found;
+    search(a_min, a_max, found);
+    for (const Named* const o : found) {
+        c.add(o);
+    }
+    return (int)found.size();
+}
+
+
+/****************************************************************************/
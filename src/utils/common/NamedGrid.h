@@ -0,0 +1,134 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    NamedGrid.h
+/// @author  agent
+/// @date    2026-10-17
+///
+// A uniform grid for storing moving Named objects
+/****************************************************************************/
+#pragma once
+#include <config.h>
+#include <unordered_map>
+#include <vector>
+#include <utils/common/Named.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/** @class NamedGrid
+ * @brief A uniform grid for efficient storing of SUMO's Named objects which move
+ *
+ * In contrast to the NamedRTree which is meant for static data, objects can be
+ *  moved cheaply by calling update with their new bounding rectangle. Only
+ *  the cells which are left or newly entered are touched. Only the occupied
+ *  cells are stored, so the extent of the grid does not need to be known.
+ *
+ * The search semantics are the same as for NamedRTree, an object is found
+ *  if its bounding rectangle overlaps the search rectangle (including the border).
+ *  Each object is reported once per search.
+ */
+class NamedGrid {
+public:
+    /** @brief Constructor
+     * @param[in] cellSize The edge length of a (square) cell, should be in the order of the typical search range
+     */
+    NamedGrid(const double cellSize);
+
+
+    /// @brief Destructor
+    ~NamedGrid() {}
+
+
+    /** @brief Inserts an entry or moves an existing one
+     * @param a_min Min of bounding rect
+     * @param a_max Max of bounding rect
+     * @param a_data The instance of a Named-object to add or move
+     */
+    void update(const float a_min[2], const float a_max[2], const Named* const a_data);
+
+
+    /** @brief Remove entry
+     * @param a_data The instance of a Named-object to remove
+     */
+    void remove(const Named* const a_data);
+
+
+    /** @brief Remove all entries
+     */
+    void clear();
+
+
+    /** @brief Find all within search rectangle
+     * @param a_min Min of search bounding rect
+     * @param a_max Max of search bounding rect
+     * @param c The visitor which gets all found objects
+     * @return Returns the number of entries found
+     */
+    int Search(const float a_min[2], const float a_max[2], const Named::StoringVisitor& c) const;
+
+
+    /** @brief Find all within search rectangle
+     * @param a_min Min of search bounding rect
+     * @param a_max Max of search bounding rect
+     * @param[filled] into The container to append the found objects to (in arbitrary order)
+     */
+    void search(const float a_min[2], const float a_max[2], std::vector<const Named*>& into) const;
+
+
+    /// @brief Returns the number of stored objects
+    int size() const {
+        return (int)myEntries.size();
+    }
+
+
+private:
+    /// @brief The stored rectangle and the covered cell range of an object
+    struct Entry {
+        float min[2];
+        float max[2];
+        int cellMin[2];
+        int cellMax[2];
+    };
+
+    /// @brief Returns the cell coordinate of the given position
+    int cellIndex(const float pos) const;
+
+    /// @brief Returns the key into the cell map for the given cell coordinates
+    static long long int cellKey(const int x, const int y) {
+        return (long long int)(((unsigned long long int)(unsigned int)x << 32) | (unsigned int)y);
+    }
+
+    /// @brief Adds the object to all cells of the given range
+    void addToCells(const Named* const a_data, const int cellMin[2], const int cellMax[2]);
+
+    /// @brief Removes the object from all cells of the given range
+    void removeFromCells(const Named* const a_data, const int cellMin[2], const int cellMax[2]);
+
+    /// @brief The edge length of the cells
+    const double myCellSize;
+
+    /// @brief The objects in each occupied cell
+    std::unordered_map<long long int, std::vector<const Named*> > myCells;
+
+    /// @brief The stored objects
+    std::unordered_map<const Named*, Entry> myEntries;
+
+private:
+    /// @brief Invalidated copy constructor.
+    NamedGrid(const NamedGrid&) = delete;
+
+    /// @brief Invalidated assignment operator.
+    NamedGrid& operator=(const NamedGrid&) = delete;
+};
@@ -114,6 +114,40 @@ public:
     }
 
 
+    /** @brief Computes the emitted amounts of all pollutants using the given speed and acceleration
+     *
+     * The checks shared by all pollutants are done once and the parameters of all pollutants
+     *  of the class are evaluated in a single pass over the (contiguous) parameter rows.
+     *  The results are identical to calling compute for each pollutant.
+     *
+     * @param[in] c emission class for the function parameters to use
+     * @param[in] v The vehicle's current velocity
+     * @param[in] a The vehicle's current acceleration
+     * @param[in] slope The road's slope at vehicle's position [deg]
+     * @return The amounts emitted by the given emission class when moving with the given velocity and acceleration [mg/s or ml/s]
+     */
+    PollutantsInterface::Emissions computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) const {
+        if (param != nullptr && param->isEngineOff()) {
+            return PollutantsInterface::Emissions();
+        }
+        if (v > ZERO_SPEED_ACCURACY && a < getCoastingDecel(c, v, a, slope, param)) {
+            return PollutantsInterface::Emissions();
+        }
+        const int index = (c & ~PollutantsInterface::HEAVY_BIT) - HBEFA3_BASE;
+        double scale[6] = {3.6, 3.6, 3.6, 3.6, 3.6, 3.6};
+        if (myVolumetricFuel) {
+            scale[PollutantsInterface::FUEL] *= getFuel(c) == "Diesel" ? 836. : 742.;
+        }
+        double result[6];
+        for (int e = 0; e < 6; e++) {
+            const double* f = myFunctionParameter[index][e];
+            result[e] = MAX2((f[0] + f[1] * a * v + f[2] * a * a * v + f[3] * v + f[4] * v * v + f[5] * v * v * v) / scale[e], 0.);
+        }
+        return PollutantsInterface::Emissions(result[PollutantsInterface::CO2], result[PollutantsInterface::CO], result[PollutantsInterface::HC],
+                                              result[PollutantsInterface::FUEL], result[PollutantsInterface::NO_X], result[PollutantsInterface::PM_X]);
+    }
+
+
 private:
     /// @brief The function parameter
     static double myFunctionParameter[45][6][6];
@@ -68,6 +68,17 @@ public:
      */
     double compute(const SUMOEmissionClass c, const PollutantsInterface::EmissionType e, const double v, const double a, const double slope, const EnergyParams* param) const;
 
+    /** @brief Returns the amount of all emitted pollutants given the vehicle type and state (in mg/s or in ml/s for fuel)
+     *
+     * The power and the emission curves which are used by multiple pollutants are only evaluated once.
+     * @param[in] c The vehicle emission class
+     * @param[in] v The vehicle's current velocity
+     * @param[in] a The vehicle's current acceleration
+     * @param[in] slope The road's slope at vehicle's position [deg]
+     * @return The amounts emitted by the given emission class when moving with the given velocity and acceleration [mg/s or ml/s]
+     */
+    PollutantsInterface::Emissions computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) const;
+
     /** @brief Returns the adapted acceleration value, useful for comparing with external PHEMlight references.
      * @param[in] c the emission class
      * @param[in] v the speed value
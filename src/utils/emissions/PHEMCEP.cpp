@@ -179,6 +179,8 @@ PHEMCEP::PHEMCEP(bool heavyVehicle, SUMOEmissionClass emissionClass, const std::
 
     _idlingFC = idlingFC * _ratedPower;
 
+    _powerPatternFCIndex.build(_powerPatternFC);
+    _powerPatternPollutantsIndex.build(_powerPatternPollutants);
 } // end of Cep
 
 
@@ -194,8 +196,10 @@ PHEMCEP::~PHEMCEP() {
 
 double
 PHEMCEP::GetEmission(const std::string& pollutant, double power, double speed, bool normalized) const {
-    std::vector<double> emissionCurve;
-    std::vector<double> powerPattern;
+    std::vector<double> pollutantCurve;
+    const std::vector<double>* emissionCurve = &pollutantCurve;
+    const std::vector<double>* powerPattern = nullptr;
+    const PHEMPatternIndex* patternIndex = nullptr;
 
     if (!normalized && fabs(speed) <= ZERO_SPEED_ACCURACY) {
         if (pollutant == "FC") {
@@ -207,11 +211,12 @@ PHEMCEP::GetEmission(const std::string& pollutant, double power, double speed, b
 
     if (pollutant == "FC") {
         if (normalized) {
-            emissionCurve = _normedCepCurveFC;
-            powerPattern = _normalizedPowerPatternFC;
+            emissionCurve = &_normedCepCurveFC;
+            powerPattern = &_normalizedPowerPatternFC;
         } else {
-            emissionCurve = _cepCurveFC;
-            powerPattern = _powerPatternFC;
+            emissionCurve = &_cepCurveFC;
+            powerPattern = &_powerPatternFC;
+            patternIndex = &_powerPatternFCIndex;
         }
     } else {
         if (!_cepCurvePollutants.hasString(pollutant)) {
@@ -219,28 +224,29 @@ PHEMCEP::GetEmission(const std::string& pollutant, double power, double speed, b
         }
 
         if (normalized) {
-            emissionCurve = _normalizedCepCurvePollutants.get(pollutant);
-            powerPattern = _normailzedPowerPatternPollutants;
+            pollutantCurve = _normalizedCepCurvePollutants.get(pollutant);
+            powerPattern = &_normailzedPowerPatternPollutants;
         } else {
-            emissionCurve = _cepCurvePollutants.get(pollutant);
-            powerPattern = _powerPatternPollutants;
+            pollutantCurve = _cepCurvePollutants.get(pollutant);
+            powerPattern = &_powerPatternPollutants;
+            patternIndex = &_powerPatternPollutantsIndex;
         }
 
     } // end if
 
 
 
-    if (emissionCurve.size() == 0) {
+    if (emissionCurve->size() == 0) {
         throw InvalidArgument("Empty emission curve for " + pollutant + " found!");
     }
 
-    if (emissionCurve.size() == 1) {
-        return emissionCurve[0];
+    if (emissionCurve->size() == 1) {
+        return (*emissionCurve)[0];
     }
 
     // in case that the demanded power is smaller than the first entry (smallest) in the power pattern the first two entries are extrapolated
-    if (power <= powerPattern.front()) {
-        double calcEmission =  PHEMCEP::Interpolate(power, powerPattern[0], powerPattern[1], emissionCurve[0], emissionCurve[1]);
+    if (power <= powerPattern->front()) {
+        double calcEmission =  PHEMCEP::Interpolate(power, (*powerPattern)[0], (*powerPattern)[1], (*emissionCurve)[0], (*emissionCurve)[1]);
 
         if (calcEmission < 0) {
             return 0;
@@ -251,17 +257,25 @@ PHEMCEP::GetEmission(const std::string& pollutant, double power, double speed, b
     } // end if
 
     // if power bigger than all entries in power pattern the last two values are linearly extrapolated
-    if (power >= powerPattern.back()) {
-        return PHEMCEP::Interpolate(power, powerPattern[powerPattern.size() - 2], powerPattern.back(), emissionCurve[emissionCurve.size() - 2], emissionCurve.back());
+    if (power >= powerPattern->back()) {
+        return PHEMCEP::Interpolate(power, (*powerPattern)[powerPattern->size() - 2], powerPattern->back(), (*emissionCurve)[emissionCurve->size() - 2], emissionCurve->back());
     } // end if
 
-    // bisection search to find correct position in power pattern
     int upperIndex;
     int lowerIndex;
 
-    PHEMCEP::FindLowerUpperInPattern(lowerIndex, upperIndex, powerPattern, power);
+    if (patternIndex != nullptr && patternIndex->isValid()) {
+        lowerIndex = patternIndex->findSegment(*powerPattern, power);
+        // exact hits are left to the bisection which decides between equal pattern entries
+        if ((*powerPattern)[lowerIndex] != power) {
+            return PHEMCEP::Interpolate(power, (*powerPattern)[lowerIndex], (*powerPattern)[lowerIndex + 1], (*emissionCurve)[lowerIndex], (*emissionCurve)[lowerIndex + 1]);
+        }
+    }
+
+    // bisection search to find correct position in power pattern
+    PHEMCEP::FindLowerUpperInPattern(lowerIndex, upperIndex, *powerPattern, power);
 
-    return PHEMCEP::Interpolate(power, powerPattern[lowerIndex], powerPattern[upperIndex], emissionCurve[lowerIndex], emissionCurve[upperIndex]);
+    return PHEMCEP::Interpolate(power, (*powerPattern)[lowerIndex], (*powerPattern)[upperIndex], (*emissionCurve)[lowerIndex], (*emissionCurve)[upperIndex]);
 
 } // end of GetEmission
 
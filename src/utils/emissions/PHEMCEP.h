@@ -27,6 +27,7 @@
 #include <utils/common/SUMOVehicleClass.h>
 #include <utils/common/StringBijection.h>
 #include "PHEMConstants.h"
+#include "PHEMPatternIndex.h"
 
 
 
@@ -117,6 +118,11 @@ public:
      * @return emission in [g/h]
      */
     double GetEmission(const std::string& pollutantIdentifier, double power, double speed, bool normalized = false) const;
+
+    /// @brief Returns the memory used by the power pattern grids in bytes
+    int getPatternIndexMemory() const {
+        return _powerPatternFCIndex.getMemory() + _powerPatternPollutantsIndex.getMemory();
+    }
     double GetDecelCoast(double speed, double acc, double gradient, double vehicleLoading) const;
 
 
@@ -316,5 +322,8 @@ private:
     StringBijection< std::vector<double> > _cepCurvePollutants;
     StringBijection<std::vector<double> > _normalizedCepCurvePollutants;
     StringBijection<double> _idlingValuesPollutants;
+    /// @brief grids for finding the segments of the (not normalized) power patterns in constant time
+    PHEMPatternIndex _powerPatternFCIndex;
+    PHEMPatternIndex _powerPatternPollutantsIndex;
 
 };
@@ -30,6 +30,8 @@
 #include "PHEMCEPHandler.h"
 #include "PHEMConstants.h"
 #include <utils/options/OptionsCont.h>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/ToString.h>
 #include <utils/common/UtilExceptions.h>
 
 // ===========================================================================
@@ -164,6 +166,8 @@ PHEMCEPHandler::Load(SUMOEmissionClass emissionClass, const std::string& emissio
                                        matrixSpeedInertiaTable,
                                        normedDragTable,
                                        idlingValues);
+    WRITE_DEBUG("Loaded PHEMlight emission class '" + emissionClassIdentifier + "', the interpolation grids use "
+                + toString(_ceps[emissionClass]->getPatternIndexMemory()) + " bytes.");
 
     return true;
 } // end of Load()
@@ -0,0 +1,124 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    PHEMPatternIndex.h
+/// @author  agent
+/// @date    2026-10-17
+///
+// A uniform grid over a sorted power pattern for constant time interpolation
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class PHEMPatternIndex
+ * @brief A uniform grid over the (sorted) power pattern of a CEP
+ *
+ * Each cell of the grid stores the index of the pattern segment containing the
+ *  lower border of the cell. The cells are at most as wide as the smallest
+ *  distance between two pattern entries (limited to MAX_CELLS_PER_SEGMENT cells
+ *  per segment on average), so finding the segment of a value needs only a few
+ *  steps instead of a bisection. The emission curves are not resampled, the
+ *  interpolation still uses the original pattern entries and gives identical results.
+ *  The index is used by PHEMCEP and by the CEP of the bundled PHEMlight5 sources.
+ */
+class PHEMPatternIndex {
+public:
+    /// @brief Constructor (builds an empty index which is never used)
+    PHEMPatternIndex() : myMin(0.), myInvCellSize(0.) {}
+
+    /** @brief Builds the index for the given pattern
+     * @param[in] pattern The power pattern which must be sorted ascending
+     */
+    void build(const std::vector<double>& pattern) {
+        myCellStart.clear();
+        const int size = (int)pattern.size();
+        if (size < 2 || !(pattern.back() > pattern.front())) {
+            return;
+        }
+        double minSpacing = pattern.back() - pattern.front();
+        for (int i = 1; i < size; i++) {
+            if (pattern[i] < pattern[i - 1]) {
+                // not sorted, keep the bisection
+                return;
+            }
+            if (pattern[i] > pattern[i - 1]) {
+                minSpacing = std::min(minSpacing, pattern[i] - pattern[i - 1]);
+            }
+        }
+        const double range = pattern.back() - pattern.front();
+        const double maxCells = (double)MAX_CELLS_PER_SEGMENT * (size - 1);
+        const int numCells = (int)std::max(1., std::min(maxCells, std::ceil(range / minSpacing)));
+        myMin = pattern.front();
+        myInvCellSize = numCells / range;
+        myCellStart.reserve(numCells);
+        int segment = 0;
+        for (int cell = 0; cell < numCells; cell++) {
+            const double lower = myMin + cell / myInvCellSize;
+            while (segment < size - 2 && pattern[segment + 1] <= lower) {
+                segment++;
+            }
+            myCellStart.push_back(segment);
+        }
+    }
+
+    /// @brief Returns whether the index was built successfully
+    bool isValid() const {
+        return !myCellStart.empty();
+    }
+
+    /** @brief Returns the segment containing the value
+     * @param[in] pattern The pattern the index was built for
+     * @param[in] value The value to search which must be strictly between the first and the last pattern entry
+     * @return The index i with pattern[i] <= value < pattern[i + 1]
+     */
+    int findSegment(const std::vector<double>& pattern, const double value) const {
+        const int numCells = (int)myCellStart.size();
+        const int cell = std::max(0, std::min(numCells - 1, (int)((value - myMin) * myInvCellSize)));
+        int segment = myCellStart[cell];
+        // guard against rounding in the cell computation
+        while (segment > 0 && pattern[segment] > value) {
+            segment--;
+        }
+        while (segment < (int)pattern.size() - 2 && pattern[segment + 1] <= value) {
+            segment++;
+        }
+        return segment;
+    }
+
+    /// @brief Returns the memory used by the index in bytes
+    int getMemory() const {
+        return (int)(sizeof(PHEMPatternIndex) + myCellStart.capacity() * sizeof(int));
+    }
+
+private:
+    /// @brief the maximum average number of cells per pattern segment
+    static const int MAX_CELLS_PER_SEGMENT = 16;
+
+    /// @brief the first pattern entry
+    double myMin;
+
+    /// @brief the number of cells per power unit
+    double myInvCellSize;
+
+    /// @brief the segment containing the lower border of each cell
+    std::vector<int> myCellStart;
+};
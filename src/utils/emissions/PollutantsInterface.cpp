@@ -182,6 +182,14 @@ PollutantsInterface::Helper::compute(const SUMOEmissionClass c, const EmissionTy
 }
 
 
+PollutantsInterface::Emissions
+PollutantsInterface::Helper::computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) const {
+    return Emissions(compute(c, CO2, v, a, slope, param), compute(c, CO, v, a, slope, param), compute(c, HC, v, a, slope, param),
+                     compute(c, FUEL, v, a, slope, param), compute(c, NO_X, v, a, slope, param), compute(c, PM_X, v, a, slope, param),
+                     compute(c, ELEC, v, a, slope, param));
+}
+
+
 double
 PollutantsInterface::Helper::getModifiedAccel(const SUMOEmissionClass c, const double v, const double a, const double slope) const {
     UNUSED_PARAMETER(c);
@@ -357,10 +365,7 @@ PollutantsInterface::compute(const SUMOEmissionClass c, const EmissionType e, co
 
 PollutantsInterface::Emissions
 PollutantsInterface::computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) {
-    const Helper* const h = myHelpers[c >> 16];
-    return Emissions(h->compute(c, CO2, v, a, slope, param), h->compute(c, CO, v, a, slope, param), h->compute(c, HC, v, a, slope, param),
-                     h->compute(c, FUEL, v, a, slope, param), h->compute(c, NO_X, v, a, slope, param), h->compute(c, PM_X, v, a, slope, param),
-                     h->compute(c, ELEC, v, a, slope, param));
+    return myHelpers[c >> 16]->computeAll(c, v, a, slope, param);
 }
 
 
@@ -371,6 +376,17 @@ PollutantsInterface::computeDefault(const SUMOEmissionClass c, const EmissionTyp
 }
 
 
+PollutantsInterface::Emissions
+PollutantsInterface::computeAllDefault(const SUMOEmissionClass c, const double v, const double a, const double slope, const double tt, const EnergyParams* param) {
+    const Helper* const h = myHelpers[c >> 16];
+    Emissions sum = h->computeAll(c, v, 0, slope, param);
+    sum.addScaled(h->computeAll(c, v - a, a, slope, param));
+    Emissions result;
+    result.addScaled(sum, tt / 2.);
+    return result;
+}
+
+
 double
 PollutantsInterface::getModifiedAccel(const SUMOEmissionClass c, const double v, const double a, const double slope) {
     return myHelpers[c >> 16]->getModifiedAccel(c, v, a, slope);
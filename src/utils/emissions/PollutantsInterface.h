@@ -189,6 +189,20 @@ public:
          */
         virtual double compute(const SUMOEmissionClass c, const EmissionType e, const double v, const double a, const double slope, const EnergyParams* param) const;
 
+        /** @brief Returns the amount of all emitted pollutants given the vehicle type and state (in mg/s or ml/s for fuel)
+         *
+         * The default implementation calls compute for every pollutant. Models which share intermediate
+         *  results (like the coasting check or the engine power) between the pollutants override this
+         *  to evaluate them only once. The results must be identical to calling compute.
+         * @param[in] c The vehicle emission class
+         * @param[in] v The vehicle's current velocity
+         * @param[in] a The vehicle's current acceleration
+         * @param[in] slope The road's slope at vehicle's position [deg]
+         * @param[in] param parameter of the emission model affecting the computation
+         * @return The amounts emitted by the given emission class when moving with the given velocity and acceleration [mg/s or ml/s]
+         */
+        virtual Emissions computeAll(const SUMOEmissionClass c, const double v, const double a, const double slope, const EnergyParams* param) const;
+
         /** @brief Returns the adapted acceleration value, useful for comparing with external PHEMlight references.
          * Default implementation returns always the input accel.
          * @param[in] c the emission class
@@ -346,6 +360,17 @@ public:
      */
     static double computeDefault(const SUMOEmissionClass c, const EmissionType e, const double v, const double a, const double slope, const double tt, const EnergyParams* param);
 
+    /** @brief Returns the amount of all emitted pollutants given the vehicle type and default values for the state (in mg)
+     * @param[in] c The vehicle emission class
+     * @param[in] v The vehicle's average velocity
+     * @param[in] a The vehicle's average acceleration
+     * @param[in] slope The road's slope at vehicle's position [deg]
+     * @param{in] tt the time the vehicle travels
+     * @param[in] param parameter of the emission model affecting the computation
+     * @return The amounts emitted by the given vehicle class [mg]
+     */
+    static Emissions computeAllDefault(const SUMOEmissionClass c, const double v, const double a, const double slope, const double tt, const EnergyParams* param);
+
     /** @brief Returns the adapted acceleration value, useful for comparing with external PHEMlight references.
      * @param[in] c the emission class
      * @param[in] v the speed value
@@ -379,14 +379,14 @@ public:
     /// @brief set GL2PS
     static void setGL2PS(bool active = true);
 
+    /// @brief whether the road makes a right turn (or goes straight)
+    static bool rightTurn(double angle1, double angle2);
+
     /// @brief draw
     static void drawSpaceOccupancies(const double exaggeration, const Position& pos, const double rotation,
                                      const double width, const double length, const bool vehicle);
 
 private:
-    /// @brief whether the road makes a right turn (or goes straight)
-    static bool rightTurn(double angle1, double angle2);
-
     /// @brief init myFont
     static bool initFont();
 
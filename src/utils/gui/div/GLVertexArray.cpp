@@ -0,0 +1,181 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    GLVertexArray.cpp
+/// @author  agent
+/// @date    2026-10-17
+///
+// Cached vertices of static geometry which are drawn with a single call
+/****************************************************************************/
+#include <config.h>
+
+#include <cmath>
+#include <utility>
+#include <utils/common/StdDefs.h>
+#include <utils/geom/GeomHelper.h>
+#include <utils/gui/globjects/GLIncludes.h>
+#include "GLHelper.h"
+#include "GLVertexArray.h"
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+GLVertexArray::GLVertexArray() :
+    myParameters{0, 0, 0, 0, 0},
+    myAmBuilt(false) {
+}
+
+
+bool
+GLVertexArray::needsRebuild(double p1, double p2, double p3, double p4, double p5) {
+    if (myAmBuilt && myParameters[0] == p1 && myParameters[1] == p2 && myParameters[2] == p3
+            && myParameters[3] == p4 && myParameters[4] == p5) {
+        return false;
+    }
+    myParameters[0] = p1;
+    myParameters[1] = p2;
+    myParameters[2] = p3;
+    myParameters[3] = p4;
+    myParameters[4] = p5;
+    myAmBuilt = true;
+    myQuads.clear();
+    myTriangles.clear();
+    return true;
+}
+
+
+int
+GLVertexArray::roundDetail(int detail) {
+    if (detail <= 0) {
+        return 0;
+    }
+    int result = 1;
+    while (result <= detail / 2) {
+        result *= 2;
+    }
+    return result;
+}
+
+
+void
+GLVertexArray::addBoxLines(const PositionVector& geom, const std::vector<double>& rots, const std::vector<double>& lengths,
+                           double width, int cornerDetail, double offset) {
+    const int e = (int) geom.size() - 1;
+    for (int i = 0; i < e; i++) {
+        const double rot = DEG2RAD(rots[i]);
+        addQuad(geom[i], sin(rot), cos(rot), 0,
+                -width - offset, 0, -width - offset, -lengths[i], width - offset, -lengths[i], width - offset, 0);
+    }
+    if (cornerDetail > 0) {
+        // same angles as in GLHelper::drawBoxLines
+        for (int i = 1; i < e; i++) {
+            double angleBeg = -rots[i - 1];
+            double angleEnd = 180 - rots[i];
+            if (GLHelper::rightTurn(rots[i - 1], rots[i])) {
+                std::swap(angleBeg, angleEnd);
+            }
+            angleBeg -= 90;
+            angleEnd += 90;
+            if (angleEnd - angleBeg > 360) {
+                angleBeg += 360;
+            }
+            if (angleEnd - angleBeg < -360) {
+                angleEnd += 360;
+            }
+            if (angleEnd > angleBeg) {
+                angleEnd -= 360;
+            }
+            addFilledCircle(geom[i], 0.1, width + offset, cornerDetail, angleBeg, angleEnd);
+        }
+    }
+}
+
+
+void
+GLVertexArray::addInverseMarkings(const PositionVector& geom, const std::vector<double>& rots, const std::vector<double>& lengths,
+                                  double maxLength, double spacing, double halfWidth, bool cl, bool cr, bool lefthand, double scale) {
+    double mw = (halfWidth + SUMO_const_laneMarkWidth * (cl ? 0.6 : 0.2)) * scale;
+    double mw2 = (halfWidth - SUMO_const_laneMarkWidth * (cr ? 0.6 : 0.2)) * scale;
+    if (cl || cr) {
+        if (lefthand) {
+            mw *= -1;
+            mw2 *= -1;
+        }
+        const int e = (int) geom.size() - 1;
+        double offset = 0;
+        for (int i = 0; i < e; ++i) {
+            const double rot = DEG2RAD(rots[i]);
+            const double sinRot = sin(rot);
+            const double cosRot = cos(rot);
+            double t;
+            for (t = offset; t < lengths[i]; t += spacing) {
+                const double length = MIN2(maxLength, lengths[i] - t);
+                addQuad(geom[i], sinRot, cosRot, 2.1, -mw, -t, -mw, -t - length, -mw2, -t - length, -mw2, -t);
+                if (!cl || !cr) {
+                    // inverse marking between asymmetrical lane markings
+                    const double length2 = MIN2(6., lengths[i] - t);
+                    addQuad(geom[i], sinRot, cosRot, 2.1,
+                            -halfWidth + 0.02, -t - length2, -halfWidth + 0.02, -t - length,
+                            -halfWidth - 0.02, -t - length, -halfWidth - 0.02, -t - length2);
+                }
+            }
+            offset = t - lengths[i] - spacing;
+        }
+    }
+}
+
+
+void
+GLVertexArray::draw() const {
+    glEnableClientState(GL_VERTEX_ARRAY);
+    if (!myQuads.empty()) {
+        glVertexPointer(3, GL_DOUBLE, 0, myQuads.data());
+        glDrawArrays(GL_QUADS, 0, (GLsizei)(myQuads.size() / 3));
+    }
+    if (!myTriangles.empty()) {
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        glVertexPointer(3, GL_DOUBLE, 0, myTriangles.data());
+        glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(myTriangles.size() / 3));
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+
+void
+GLVertexArray::addQuad(const Position& pos, double sinRot, double cosRot, double z,
+                       double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4) {
+    const double coords[] = {x1, y1, x2, y2, x3, y3, x4, y4};
+    for (int i = 0; i < 8; i += 2) {
+        myQuads.push_back(pos.x() + coords[i] * cosRot - coords[i + 1] * sinRot);
+        myQuads.push_back(pos.y() + coords[i] * sinRot + coords[i + 1] * cosRot);
+        myQuads.push_back(z);
+    }
+}
+
+
+void
+GLVertexArray::addFilledCircle(const Position& center, double z, double width, int steps, double beg, double end) {
+    const double inc = (end - beg) / (double)steps;
+    std::pair<double, double> p1 = GLHelper::getCircleCoords().at(GLHelper::angleLookup(beg));
+    for (int i = 0; i <= steps; ++i) {
+        const std::pair<double, double>& p2 = GLHelper::getCircleCoords().at(GLHelper::angleLookup(beg + i * inc));
+        const double coords[] = {p1.first * width, p1.second * width, p2.first * width, p2.second * width, 0, 0};
+        for (int j = 0; j < 6; j += 2) {
+            myTriangles.push_back(center.x() + coords[j]);
+            myTriangles.push_back(center.y() + coords[j + 1]);
+            myTriangles.push_back(z);
+        }
+        p1 = p2;
+    }
+}
@@ -0,0 +1,92 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    GLVertexArray.h
+/// @author  agent
+/// @date    2026-10-17
+///
+// Cached vertices of static geometry which are drawn with a single call
+/****************************************************************************/
+#pragma once
+#include <config.h>
+
+#include <vector>
+#include <utils/geom/PositionVector.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class GLVertexArray
+ * @brief Stores the tesselation of static geometry (quads and triangles) in network coordinates
+ *
+ * The vertices are computed once using the same construction as the corresponding GLHelper
+ *  methods and are drawn afterwards with one glDrawArrays call per primitive type. The array
+ *  is rebuilt whenever the drawing parameters (zoom dependent detail, exaggeration, ...) change.
+ */
+class GLVertexArray {
+public:
+    /// @brief Constructor
+    GLVertexArray();
+
+    /** @brief Returns whether the array has to be rebuilt for the given drawing parameters
+     *
+     * If the parameters differ from the ones of the last call, the array is cleared
+     *  and the new parameters are remembered.
+     */
+    bool needsRebuild(double p1, double p2 = 0, double p3 = 0, double p4 = 0, double p5 = 0);
+
+    /// @brief adds the geometry drawn by GLHelper::drawBoxLines
+    void addBoxLines(const PositionVector& geom, const std::vector<double>& rots, const std::vector<double>& lengths,
+                     double width, int cornerDetail = 0, double offset = 0);
+
+    /// @brief adds the geometry drawn by GLHelper::drawInverseMarkings
+    void addInverseMarkings(const PositionVector& geom, const std::vector<double>& rots, const std::vector<double>& lengths,
+                            double maxLength, double spacing, double halfWidth, bool cl, bool cr, bool lefthand, double scale);
+
+    /// @brief draws the stored geometry with the current color and transformation
+    void draw() const;
+
+    /// @brief Returns whether no geometry is stored
+    bool empty() const {
+        return myQuads.empty() && myTriangles.empty();
+    }
+
+    /** @brief Rounds a zoom dependent detail level down to a power of two
+     *
+     * Using the rounded detail as a drawing parameter rebuilds the array only when the zoom
+     *  doubles or halves instead of at every zoom step.
+     */
+    static int roundDetail(int detail);
+
+private:
+    /// @brief adds a quad given in the segment coordinates (translated by pos and rotated by rot degrees)
+    void addQuad(const Position& pos, double sinRot, double cosRot, double z,
+                 double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4);
+
+    /// @brief adds the triangles drawn by GLHelper::drawFilledCircle
+    void addFilledCircle(const Position& center, double z, double width, int steps, double beg, double end);
+
+    /// @brief the parameters the array was built for
+    double myParameters[5];
+
+    /// @brief whether the array was built at all
+    bool myAmBuilt;
+
+    /// @brief the coordinates (x, y, z) of the quads
+    std::vector<double> myQuads;
+
+    /// @brief the coordinates (x, y, z) of the triangles
+    std::vector<double> myTriangles;
+};
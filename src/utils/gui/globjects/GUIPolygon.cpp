@@ -169,14 +169,14 @@ TesselatedPolygon::drawTesselation(const PositionVector& shape) const {
         gluDeleteTess(tobj);
         delete[] points;
     }
-    for (GLPrimitive& pr : myTesselation) {
-        // XXX change to glDrawArrays
-        glBegin(pr.type);
-        for (const Position& p : pr.vert) {
-            glVertex3d(p.x(), p.y(), p.z());
-        }
-        glEnd();
+    // the positions are stored as consecutive (x, y, z) triples and can be passed directly
+    static_assert(sizeof(Position) == 3 * sizeof(double), "Position is expected to consist of three doubles");
+    glEnableClientState(GL_VERTEX_ARRAY);
+    for (const GLPrimitive& pr : myTesselation) {
+        glVertexPointer(3, GL_DOUBLE, 0, pr.vert.data());
+        glDrawArrays(pr.type, 0, (GLsizei)pr.vert.size());
     }
+    glDisableClientState(GL_VERTEX_ARRAY);
 }
 
 
@@ -345,6 +345,10 @@ public:
     }
 
     virtual void prohibit(const std::vector<E*>& toProhibit) {
+        if (toProhibit != this->myProhibited) {
+            // the results of the last query cannot be reused in (auto) bulk mode
+            init(-1, 0);
+        }
         for (E* const edge : this->myProhibited) {
             myEdgeInfos[edge->getNumericalID()].prohibited = false;
         }
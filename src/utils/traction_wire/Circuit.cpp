@@ -30,6 +30,7 @@
 #include <iostream>
 #include <ctime>
 #include <mutex>
+#include <numeric>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/ToString.h>
 #include <microsim/MSGlobals.h>
@@ -195,15 +196,28 @@ void Circuit::unlock() {
 }
 
 #ifdef HAVE_EIGEN
-void Circuit::removeColumn(Eigen::MatrixXd& matrix, int colToRemove) {
-    const int numRows = (int)matrix.rows();
-    const int numCols = (int)matrix.cols() - 1;
-
-    if (colToRemove < numCols) {
-        matrix.block(0, colToRemove, numRows, numCols - colToRemove) = matrix.rightCols(numCols - colToRemove);
+void Circuit::solveSparse(const Eigen::SparseMatrix<double>& matrix, const Eigen::VectorXd& rhs, Eigen::VectorXd& result) {
+    if (matrix.rows() == matrix.cols()) {
+        // the symbolic factorization only depends on the positions of the nonzeros
+        const int numOuter = (int)matrix.outerSize() + 1;
+        const int numInner = (int)matrix.nonZeros();
+        if (solverOuterIndices.size() != (size_t)numOuter || solverInnerIndices.size() != (size_t)numInner
+                || !std::equal(solverOuterIndices.begin(), solverOuterIndices.end(), matrix.outerIndexPtr())
+                || !std::equal(solverInnerIndices.begin(), solverInnerIndices.end(), matrix.innerIndexPtr())) {
+            sparseSolver.analyzePattern(matrix);
+            solverOuterIndices.assign(matrix.outerIndexPtr(), matrix.outerIndexPtr() + numOuter);
+            solverInnerIndices.assign(matrix.innerIndexPtr(), matrix.innerIndexPtr() + numInner);
+        }
+        sparseSolver.factorize(matrix);
+        if (sparseSolver.info() == Eigen::Success) {
+            result = sparseSolver.solve(rhs);
+            if (sparseSolver.info() == Eigen::Success) {
+                return;
+            }
+        }
     }
-
-    matrix.conservativeResize(numRows, numCols);
+    // the matrix is singular, use the least squares solution
+    result = Eigen::MatrixXd(matrix).colPivHouseholderQr().solve(rhs);
 }
 
 bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>* removable_ids) {
@@ -211,15 +225,12 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
     int numofcolumn = (int)voltageSources->size() + (int)nodes->size() - 1;
     int numofeqs = numofcolumn - (int)removable_ids->size();
 
-    // map equations into matrix A
-    Eigen::MatrixXd A = Eigen::Map < Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> >(eqn, numofeqs, numofcolumn);
-
-    int id;
     // remove removable columns of matrix A, i.e. remove equations corresponding to nodes with two resistors connected in series
-    // RICE_TODO auto for ?
+    std::vector<int> columns(numofcolumn);
+    std::iota(columns.begin(), columns.end(), 0);
     for (std::vector<int>::reverse_iterator it = removable_ids->rbegin(); it != removable_ids->rend(); ++it) {
-        id = (*it >= 0 ? *it : -(*it));
-        removeColumn(A, id);
+        const int id = (*it >= 0 ? *it : -(*it));
+        columns.erase(columns.begin() + id);
     }
 
     // detect number of column for each node
@@ -257,12 +268,45 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
         WRITE_ERROR(TL("Structural error in reduced circuit matrix."));
     }
 
+    // map equations into the sparse matrix A, the Jacobian matrix J differs from A only in the columns of the nodes
+    // of current sources (in the rows of their nodes), these entries are added as zeros so that A and J (in all
+    // iterations) share the same pattern and the symbolic factorization can be reused
+    std::vector<Eigen::Triplet<double> > entries;
+    for (int row = 0; row < numofeqs; row++) {
+        for (int col = 0; col < (int)columns.size(); col++) {
+            const double value = eqn[row * numofcolumn + columns[col]];
+            if (value != 0) {
+                entries.push_back(Eigen::Triplet<double>(row, col, value));
+            }
+        }
+    }
+    int row = 0;
+    for (Node* const node : *nodes) {
+        if (node->isGround() || node->isRemovable() || node->getNumMatrixRow() == -2) {
+            continue;
+        }
+        for (Element* const element : *node->getElements()) {
+            if (element->getType() == Element::ElementType::CURRENT_SOURCE_traction_wire && element->isEnabled()) {
+                if (element->getPosNode()->getNumMatrixCol() != -1) {
+                    entries.push_back(Eigen::Triplet<double>(row, element->getPosNode()->getNumMatrixCol(), 0.));
+                }
+                if (element->getNegNode()->getNumMatrixCol() != -1) {
+                    entries.push_back(Eigen::Triplet<double>(row, element->getNegNode()->getNumMatrixCol(), 0.));
+                }
+            }
+        }
+        row++;
+    }
+    Eigen::SparseMatrix<double> A(numofeqs, (int)columns.size());
+    A.setFromTriplets(entries.begin(), entries.end());
+
     // map 'vals' into vector b and initialize solution x
     Eigen::Map<Eigen::VectorXd> b(vals, numofeqs);
-    Eigen::VectorXd x = A.colPivHouseholderQr().solve(b);
+    Eigen::VectorXd x;
+    solveSparse(A, b, x);
 
     // initialize Jacobian matrix J and vector dx
-    Eigen::MatrixXd J = A;
+    Eigen::SparseMatrix<double> J = A;
     Eigen::VectorXd dx;
     // initialize progressively increasing maximal number of Newton-Rhapson iterations
     int max_iter_of_NR = 10;
@@ -338,11 +382,11 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
                                 (*it_element)->setCurrent(-alpha * (*it_element)->getPowerWanted() / diff_voltage);
                                 if (PosNode_NumACol != -1) {
                                     // -1* d_b/d_phiPos = -1* d(-alpha*P/(phiPos-phiNeg) )/d_phiPos = -1* (--alpha*P/(phiPos-phiNeg)^2 )
-                                    J(i, PosNode_NumACol) -= alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
+                                    J.coeffRef(i, PosNode_NumACol) -= alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
                                 }
                                 if (NegNode_NumACol != -1) {
                                     // -1* d_b/d_phiNeg = -1* d(-alpha*P/(phiPos-phiNeg) )/d_phiNeg = -1* (---alpha*P/(phiPos-phiNeg)^2 )
-                                    J(i, NegNode_NumACol) += alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
+                                    J.coeffRef(i, NegNode_NumACol) += alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
                                 }
                             } else {
                                 // the positive current (the element is consuming energy if powerWanted > 0) is flowing to the negative node (sign plus)
@@ -354,11 +398,11 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
                                 WRITE_WARNING(TL("The negative node of current source is not the groud."))
                                 if (PosNode_NumACol != -1) {
                                     // -1* d_b/d_phiPos = -1* d(alpha*P/(phiPos-phiNeg) )/d_phiPos = -1* (-alpha*P/(phiPos-phiNeg)^2 )
-                                    J(i, PosNode_NumACol) += alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
+                                    J.coeffRef(i, PosNode_NumACol) += alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
                                 }
                                 if (NegNode_NumACol != -1) {
                                     // -1* d_b/d_phiNeg = -1* d(alpha*P/(phiPos-phiNeg) )/d_phiNeg = -1* (--alpha*P/(phiPos-phiNeg)^2 )
-                                    J(i, NegNode_NumACol) -= alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
+                                    J.coeffRef(i, NegNode_NumACol) -= alpha * (*it_element)->getPowerWanted() / diff_voltage / diff_voltage;
                                 }
                             }
                         }
@@ -412,8 +456,8 @@ bool Circuit::solveEquationsNRmethod(double* eqn, double* vals, std::vector<int>
             }
 
             // Newton=Rhapson iteration
-            dx = -J.colPivHouseholderQr().solve(A * x - b);
-            x = x + dx;
+            solveSparse(J, A * x - b, dx);
+            x = x - dx;
             ++iterNR;
         }
 
@@ -613,8 +657,8 @@ bool Circuit::_solveNRmethod() {
     // vals are now the solution x of the circuit
     deployResults(vals, &removable_ids);
 
-    delete eqn;
-    delete vals;
+    delete[] eqn;
+    delete[] vals;
     return true;
 }
 
@@ -106,6 +106,15 @@ public:
 private:
     alphaFlag alphaReason;
 
+#ifdef HAVE_EIGEN
+    /// @brief The sparse LU solver of the circuit equations (keeps the symbolic factorization between the solves)
+    Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > sparseSolver;
+
+    /// @brief The pattern (column starts and row indices) of the matrix analyzed by the sparse solver
+    std::vector<int> solverOuterIndices;
+    std::vector<int> solverInnerIndices;
+#endif
+
 public:
     Node* getNode(std::string name);
     Element* getElement(std::string name);
@@ -177,9 +186,10 @@ private:
     bool createEquation(Element* vsource, double* eqn, double& val);
 
     /*
-     *    removes the "colToRemove"-th column from matrix "matrix"
+     *    solves the linear system "matrix" * "result" = "rhs" reusing the symbolic factorization of the previous call
+     *    if the pattern of "matrix" did not change (falls back to a dense least squares solution for singular matrices)
      */
-    void removeColumn(Eigen::MatrixXd& matrix, const int colToRemove);
+    void solveSparse(const Eigen::SparseMatrix<double>& matrix, const Eigen::VectorXd& rhs, Eigen::VectorXd& result);
 
     /*
      * solves the system of nonlinear equations Ax = B(1/x)
@@ -866,7 +866,8 @@ SUMOVehicleParserHelper::beginVTypeParsing(const SUMOSAXAttributes& attrs, const
                 vType->parametersSet |= VTYPEPARS_WIDTH_SET;
                 if (vClass == SVC_PEDESTRIAN
                         && OptionsCont::getOptions().exists("pedestrian.striping.stripe-width")
-                        && OptionsCont::getOptions().getString("pedestrian.model") == "striping"
+                        && (OptionsCont::getOptions().getString("pedestrian.model") == "striping"
+                            || OptionsCont::getOptions().getString("pedestrian.model") == "grid")
                         && OptionsCont::getOptions().getFloat("pedestrian.striping.stripe-width") < vType->width) {
                     WRITE_WARNINGF(TL("Pedestrian vType '%' width % is larger than pedestrian.striping.stripe-width and this may cause collisions with vehicles."), id, vType->width);
                 }
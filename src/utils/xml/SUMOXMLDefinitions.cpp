@@ -832,6 +832,7 @@ StringBijection<int>::Entry SUMOXMLDefinitions::attrs[] = {
     { "edgesFile",              SUMO_ATTR_EDGESFILE },
     { "aggregate",              SUMO_ATTR_AGGREGATE },
     { "numEdges",               SUMO_ATTR_NUMEDGES },
+    { "coarsePeriods",          SUMO_ATTR_COARSE_PERIODS },
 
     { "lon",                    SUMO_ATTR_LON },
     { "lat",                    SUMO_ATTR_LAT },
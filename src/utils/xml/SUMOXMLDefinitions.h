@@ -1198,6 +1198,7 @@ enum SumoXMLAttr {
     SUMO_ATTR_EDGESFILE,
     SUMO_ATTR_AGGREGATE,
     SUMO_ATTR_NUMEDGES,
+    SUMO_ATTR_COARSE_PERIODS,
 
     SUMO_ATTR_LON,
     SUMO_ATTR_LAT,
@@ -0,0 +1,161 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSDispatch_MatchingTest.cpp
+/// @author  agent
+/// @date    2026-10-18
+///
+// Tests the assignment of taxis to reservations by bipartite matching
+/****************************************************************************/
+#include <config.h>
+
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include <microsim/devices/MSDispatch_Greedy.h>
+
+
+class MSDispatch_MatchingTest : public testing::Test {
+protected :
+    typedef MSDispatch_Matching::CandidateTimes CandidateTimes;
+
+    static std::vector<int> computeMatching(const CandidateTimes& costs, const int numTaxis) {
+        return MSDispatch_Matching::computeMatching(costs, numTaxis);
+    }
+
+    /// @brief returns the cost of the assignment or -1 if it uses a pair which is no candidate
+    static SUMOTime totalCost(const CandidateTimes& costs, const std::vector<int>& assignment) {
+        SUMOTime result = 0;
+        for (int res = 0; res < (int)assignment.size(); res++) {
+            if (assignment[res] >= 0) {
+                auto it = std::find_if(costs[res].begin(), costs[res].end(), [&](const std::pair<int, SUMOTime>& item) {
+                    return item.first == assignment[res];
+                });
+                if (it == costs[res].end()) {
+                    return -1;
+                }
+                result += it->second;
+            }
+        }
+        return result;
+    }
+
+    /// @brief finds the largest number of assigned reservations and its minimum cost by trying all assignments
+    static void bruteForce(const CandidateTimes& costs, std::vector<int>& assignment, std::vector<bool>& usedTaxis,
+                           int res, int& bestCount, SUMOTime& bestCost) {
+        if (res == (int)costs.size()) {
+            const int count = (int)std::count_if(assignment.begin(), assignment.end(), [](int taxi) {
+                return taxi >= 0;
+            });
+            const SUMOTime cost = totalCost(costs, assignment);
+            if (count > bestCount || (count == bestCount && cost < bestCost)) {
+                bestCount = count;
+                bestCost = cost;
+            }
+            return;
+        }
+        assignment[res] = -1;
+        bruteForce(costs, assignment, usedTaxis, res + 1, bestCount, bestCost);
+        for (const auto& item : costs[res]) {
+            if (!usedTaxis[item.first]) {
+                usedTaxis[item.first] = true;
+                assignment[res] = item.first;
+                bruteForce(costs, assignment, usedTaxis, res + 1, bestCount, bestCost);
+                usedTaxis[item.first] = false;
+            }
+        }
+        assignment[res] = -1;
+    }
+
+    static void checkValid(const std::vector<int>& assignment, const int numTaxis) {
+        std::vector<bool> used(numTaxis, false);
+        for (const int taxi : assignment) {
+            if (taxi >= 0) {
+                EXPECT_FALSE(used[taxi]);
+                used[taxi] = true;
+            }
+        }
+    }
+};
+
+
+/* Test that the total cost is minimized where the greedy choice in reservation order is worse */
+TEST_F(MSDispatch_MatchingTest, test_optimal_assignment) {
+    CandidateTimes costs(2);
+    costs[0] = {{0, 1000}, {1, 2000}};
+    costs[1] = {{0, 1000}, {1, 10000}};
+    const std::vector<int> assignment = computeMatching(costs, 2);
+    EXPECT_EQ(std::vector<int>({1, 0}), assignment);
+    EXPECT_EQ(3000, totalCost(costs, assignment));
+}
+
+
+/* Test that only the cheapest reservations are served if there are fewer taxis and vice versa */
+TEST_F(MSDispatch_MatchingTest, test_unequal_sizes) {
+    CandidateTimes costs(3);
+    costs[0] = {{0, 10000}, {1, 9000}};
+    costs[1] = {{0, 1000}, {1, 3000}};
+    costs[2] = {{0, 2000}, {1, 1000}};
+    const std::vector<int> assignment = computeMatching(costs, 2);
+    EXPECT_EQ(std::vector<int>({-1, 0, 1}), assignment);
+
+    CandidateTimes single(1);
+    single[0] = {{0, 5000}, {1, 3000}, {2, 4000}};
+    EXPECT_EQ(std::vector<int>({1}), computeMatching(single, 3));
+}
+
+
+/* Test that pairs which are no candidates are never assigned and the number of assignments is maximal */
+TEST_F(MSDispatch_MatchingTest, test_infeasible_pairs) {
+    CandidateTimes costs(3);
+    // the first reservation is cheaper with taxi 0 but only then the second one can be served too
+    costs[0] = {{0, 1000}, {1, 5000}};
+    costs[1] = {{0, 9000}};
+    // no taxi can serve the last reservation
+    costs[2] = {};
+    const std::vector<int> assignment = computeMatching(costs, 2);
+    EXPECT_EQ(std::vector<int>({1, 0, -1}), assignment);
+
+    CandidateTimes none(2);
+    EXPECT_EQ(std::vector<int>({-1, -1}), computeMatching(none, 3));
+}
+
+
+/* Test random sparse instances against all possible assignments */
+TEST_F(MSDispatch_MatchingTest, test_random_against_brute_force) {
+    std::mt19937 rng(42);
+    for (int instance = 0; instance < 200; instance++) {
+        const int numRes = 1 + (int)(rng() % 5);
+        const int numTaxis = 1 + (int)(rng() % 5);
+        CandidateTimes costs(numRes);
+        for (int res = 0; res < numRes; res++) {
+            for (int taxi = 0; taxi < numTaxis; taxi++) {
+                if (rng() % 3 != 0) {
+                    costs[res].push_back(std::make_pair(taxi, (SUMOTime)(1 + rng() % 20) * 1000));
+                }
+            }
+        }
+        const std::vector<int> assignment = computeMatching(costs, numTaxis);
+        checkValid(assignment, numTaxis);
+        std::vector<int> tmp(numRes, -1);
+        std::vector<bool> used(numTaxis, false);
+        int bestCount = -1;
+        SUMOTime bestCost = 0;
+        bruteForce(costs, tmp, used, 0, bestCount, bestCost);
+        const int count = (int)std::count_if(assignment.begin(), assignment.end(), [](int taxi) {
+            return taxi >= 0;
+        });
+        EXPECT_EQ(bestCount, count);
+        EXPECT_EQ(bestCost, totalCost(costs, assignment));
+    }
+}
@@ -0,0 +1,145 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSDispatch_PoolingTest.cpp
+/// @author  agent
+/// @date    2026-10-18
+///
+// Tests the insertion of reservations into taxi schedules for ride pooling
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <microsim/devices/MSDispatch_Pooling.h>
+
+
+class MSDispatch_PoolingTest : public testing::Test {
+protected :
+    typedef MSDispatch_Pooling::Insertion Insertion;
+    typedef MSDispatch_Pooling::InsertionTimes InsertionTimes;
+    typedef MSDispatch_Pooling::StopTimes StopTimes;
+
+    static Insertion cheapestInsertion(const InsertionTimes& times, const double maxDetour) {
+        return MSDispatch_Pooling::cheapestInsertion(times, maxDetour);
+    }
+
+    /** @brief a taxi carrying one customer who is dropped off after 50s and a new reservation
+     *
+     * The pickup is 100s away from the taxi and 80s away from the dropoff of the customer on board,
+     *  the direct ride takes 100s. The possible insertions (pickup index, dropoff index) are
+     *  (0, 0) ending at 280s, (0, 1) with a ride of 110s ending at 210s and (1, 1) ending at 230s.
+     */
+    static InsertionTimes onboardCustomer() {
+        InsertionTimes times;
+        times.capacity = 4;
+        times.initialLoad = 1;
+        times.persons = 1;
+        times.directTime = 100.;
+        StopTimes dropoff;
+        dropoff.persons = 1;
+        times.stops.push_back(dropoff);
+        times.base = {0., 50.};
+        times.toPickup = {100., 80.};
+        times.fromPickup = {0., 20.};
+        times.toDropoff = {0., 90.};
+        times.fromDropoff = {0., 80.};
+        return times;
+    }
+};
+
+
+/* Test that an empty taxi drives to the pickup and directly to the dropoff */
+TEST_F(MSDispatch_PoolingTest, test_empty_taxi) {
+    InsertionTimes times;
+    times.capacity = 4;
+    times.persons = 2;
+    times.directTime = 100.;
+    times.base = {0.};
+    times.toPickup = {30.};
+    times.fromPickup = {0.};
+    times.toDropoff = {0.};
+    times.fromDropoff = {0.};
+    const Insertion insertion = cheapestInsertion(times, 0.);
+    EXPECT_EQ(0, insertion.pickupIndex);
+    EXPECT_EQ(0, insertion.dropoffIndex);
+    EXPECT_DOUBLE_EQ(130., insertion.cost);
+    EXPECT_DOUBLE_EQ(30., insertion.pickupTime);
+}
+
+
+/* Test that the cheapest insertion is rejected if the ride of the new customer takes too long */
+TEST_F(MSDispatch_PoolingTest, test_detour_limit) {
+    const InsertionTimes times = onboardCustomer();
+    Insertion insertion = cheapestInsertion(times, 0.5);
+    EXPECT_EQ(0, insertion.pickupIndex);
+    EXPECT_EQ(1, insertion.dropoffIndex);
+    EXPECT_DOUBLE_EQ(160., insertion.cost);
+    // a ride of 110s exceeds a detour of 5%
+    insertion = cheapestInsertion(times, 0.05);
+    EXPECT_EQ(1, insertion.pickupIndex);
+    EXPECT_EQ(1, insertion.dropoffIndex);
+    EXPECT_DOUBLE_EQ(180., insertion.cost);
+}
+
+
+/* Test that the customers already assigned to the taxi keep their deadlines */
+TEST_F(MSDispatch_PoolingTest, test_stop_deadline) {
+    InsertionTimes times = onboardCustomer();
+    // the customer on board would be dropped off at 120s when picking up first
+    times.stops[0].deadline = 100.;
+    const Insertion insertion = cheapestInsertion(times, 0.5);
+    EXPECT_EQ(1, insertion.pickupIndex);
+    EXPECT_EQ(1, insertion.dropoffIndex);
+}
+
+
+/* Test that the capacity is never exceeded and insertions are rejected if the customers do not fit at all */
+TEST_F(MSDispatch_PoolingTest, test_capacity) {
+    InsertionTimes times = onboardCustomer();
+    times.persons = 2;
+    times.capacity = 3;
+    Insertion insertion = cheapestInsertion(times, 0.5);
+    EXPECT_EQ(0, insertion.pickupIndex);
+    EXPECT_EQ(1, insertion.dropoffIndex);
+    // the new customers only fit after the customer on board left
+    times.capacity = 2;
+    insertion = cheapestInsertion(times, 0.5);
+    EXPECT_EQ(1, insertion.pickupIndex);
+    EXPECT_EQ(1, insertion.dropoffIndex);
+    // the new customers never fit
+    times.capacity = 1;
+    insertion = cheapestInsertion(times, 0.5);
+    EXPECT_EQ(-1, insertion.pickupIndex);
+    EXPECT_EQ(std::numeric_limits<double>::max(), insertion.cost);
+}
+
+
+/* Test that the taxi neither arrives too early nor too late at the pickup */
+TEST_F(MSDispatch_PoolingTest, test_pickup_window) {
+    InsertionTimes times = onboardCustomer();
+    // picking up after the dropoff at 130s is too late, the detour forbids the shared ride
+    times.latestPickup = 120.;
+    Insertion insertion = cheapestInsertion(times, 0.05);
+    EXPECT_EQ(0, insertion.pickupIndex);
+    EXPECT_EQ(0, insertion.dropoffIndex);
+    EXPECT_DOUBLE_EQ(230., insertion.cost);
+    times.latestPickup = 90.;
+    insertion = cheapestInsertion(times, 0.5);
+    EXPECT_EQ(-1, insertion.pickupIndex);
+    // picking up first is too early
+    times.latestPickup = std::numeric_limits<double>::max();
+    times.earliestPickup = 110.;
+    insertion = cheapestInsertion(times, 0.5);
+    EXPECT_EQ(1, insertion.pickupIndex);
+    EXPECT_DOUBLE_EQ(130., insertion.pickupTime);
+}
@@ -0,0 +1,122 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    MSPModel_GridTest.cpp
+/// @author  agent
+/// @date    2026-10-18
+///
+// Tests the movement on the cells of the grid pedestrian model
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <microsim/transportables/MSPModel_Grid.h>
+
+
+class MSPModel_GridTest : public testing::Test {
+protected :
+    typedef MSPModel_Grid::Occupancy Occupancy;
+    typedef MSPModel_Grid::PState PState;
+
+    /// @brief a pedestrian on a sidewalk which is not connected to a person
+    class TestState : public MSPModel_Grid::PState {
+    public:
+        TestState(double relX, int stripe, int dir) {
+            myRelX = relX;
+            myRelY = stripe * MSPModel_Striping::stripeWidth;
+            myDir = dir;
+        }
+    };
+
+    virtual void SetUp() {
+        MSPModel_Striping::stripeWidth = 0.65;
+    }
+
+    static long long int cellKey(const PState& p, double relX, double relY) {
+        return MSPModel_Grid::cellKey(p, relX, relY);
+    }
+
+    static void occupy(Occupancy& occupancy, const PState& p) {
+        occupancy[cellKey(p, p.myRelX, p.myRelY)] = &p;
+    }
+
+    static double freeDistance(const PState& p, const Occupancy& occupancy, int stripe, double maxDist, const PState*& blocker) {
+        return MSPModel_Grid::freeDistance(p, occupancy, stripe, maxDist, blocker);
+    }
+};
+
+
+/* Test that positions share a cell exactly if they are within the same stripe width square */
+TEST_F(MSPModel_GridTest, test_cellKey) {
+    TestState p(1., 1, 1);
+    const double w = MSPModel_Striping::stripeWidth;
+    EXPECT_EQ(cellKey(p, 0.1, w), cellKey(p, w - 0.1, w));
+    EXPECT_NE(cellKey(p, w - 0.1, w), cellKey(p, w + 0.1, w));
+    EXPECT_NE(cellKey(p, 0.1, 0.), cellKey(p, 0.1, w));
+}
+
+
+/* Test that a pedestrian advances until the cell in front of another pedestrian */
+TEST_F(MSPModel_GridTest, test_freeDistance_blocked) {
+    const double w = MSPModel_Striping::stripeWidth;
+    TestState ego(1., 0, 1);
+    TestState other(1. + 4 * w, 0, -1);
+    Occupancy occupancy;
+    occupy(occupancy, ego);
+    occupy(occupancy, other);
+    const PState* blocker = nullptr;
+    const double free = freeDistance(ego, occupancy, 0, 10., blocker);
+    EXPECT_EQ(&other, blocker);
+    EXPECT_LT(free, 4 * w);
+    EXPECT_GE(free, 2 * w);
+    EXPECT_NE(cellKey(ego, ego.myRelX + free, 0.), cellKey(other, other.myRelX, other.myRelY));
+    // the neighboring stripe is free
+    blocker = nullptr;
+    EXPECT_DOUBLE_EQ(10., freeDistance(ego, occupancy, 1, 10., blocker));
+    EXPECT_EQ(nullptr, blocker);
+}
+
+
+/* Test that a pedestrian walking backward is not blocked by pedestrians behind it */
+TEST_F(MSPModel_GridTest, test_freeDistance_backward) {
+    const double w = MSPModel_Striping::stripeWidth;
+    TestState ego(5., 0, -1);
+    TestState behind(5. + 2 * w, 0, -1);
+    TestState ahead(5. - 3 * w, 0, 1);
+    Occupancy occupancy;
+    occupy(occupancy, ego);
+    occupy(occupancy, behind);
+    const PState* blocker = nullptr;
+    EXPECT_DOUBLE_EQ(1., freeDistance(ego, occupancy, 0, 1., blocker));
+    EXPECT_EQ(nullptr, blocker);
+    occupy(occupancy, ahead);
+    EXPECT_LT(freeDistance(ego, occupancy, 0, 3., blocker), 3 * w);
+    EXPECT_EQ(&ahead, blocker);
+}
+
+
+/* Test that cells blocked by vehicles stop the pedestrian without reporting a pedestrian blocker */
+TEST_F(MSPModel_GridTest, test_freeDistance_vehicle) {
+    const double w = MSPModel_Striping::stripeWidth;
+    TestState ego(0.1, 2, 1);
+    Occupancy occupancy;
+    occupy(occupancy, ego);
+    occupancy[cellKey(ego, 0.1 + 3 * w, 2 * w)] = nullptr;
+    const PState* blocker = &ego;
+    const double free = freeDistance(ego, occupancy, 2, 10., blocker);
+    EXPECT_EQ(nullptr, blocker);
+    EXPECT_LT(free, 3 * w);
+    // the pedestrian may not leave the current cell if the next one is blocked
+    occupancy[cellKey(ego, 0.1 + w, 2 * w)] = nullptr;
+    EXPECT_LT(freeDistance(ego, occupancy, 2, 10., blocker), w);
+}
@@ -0,0 +1,68 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    NamedGridTest.cpp
+/// @author  agent
+/// @date    2026-10-17
+///
+// Tests the class NamedGrid
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <utils/common/NamedGrid.h>
+
+
+/* Test that each object is found exactly once, also when spanning multiple cells */
+TEST(NamedGrid, test_method_search) {
+    NamedGrid grid(10.);
+    Named a("a");
+    Named b("b");
+    const float aMin[2] = {1.f, 1.f};
+    const float aMax[2] = {2.f, 2.f};
+    const float bMin[2] = {-15.f, 5.f};
+    const float bMax[2] = {25.f, 6.f};
+    grid.update(aMin, aMax, &a);
+    grid.update(bMin, bMax, &b);
+    std::vector<const Named*> found;
+    const float qMin[2] = {-100.f, -100.f};
+    const float qMax[2] = {100.f, 100.f};
+    grid.search(qMin, qMax, found);
+    EXPECT_EQ(2, (int)found.size());
+    found.clear();
+    const float q2Min[2] = {2.f, 2.f};
+    const float q2Max[2] = {4.f, 4.f};
+    grid.search(q2Min, q2Max, found);
+    ASSERT_EQ(1, (int)found.size());
+    EXPECT_EQ(&a, found.front());
+}
+
+/* Test moving and removing objects */
+TEST(NamedGrid, test_method_update) {
+    NamedGrid grid(10.);
+    Named a("a");
+    const float aMin[2] = {1.f, 1.f};
+    const float aMax[2] = {2.f, 2.f};
+    grid.update(aMin, aMax, &a);
+    const float movedMin[2] = {51.f, -31.f};
+    const float movedMax[2] = {52.f, -30.f};
+    grid.update(movedMin, movedMax, &a);
+    EXPECT_EQ(1, grid.size());
+    std::set<const Named*> found;
+    Named::StoringVisitor sv(found);
+    EXPECT_EQ(0, grid.Search(aMin, aMax, sv));
+    EXPECT_EQ(1, grid.Search(movedMin, movedMax, sv));
+    grid.remove(&a);
+    EXPECT_EQ(0, grid.size());
+    EXPECT_EQ(0, grid.Search(movedMin, movedMax, sv));
+}
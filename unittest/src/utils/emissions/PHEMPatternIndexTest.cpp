@@ -0,0 +1,81 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    PHEMPatternIndexTest.cpp
+/// @author  agent
+/// @date    2026-10-17
+///
+// Tests the class PHEMPatternIndex
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <utils/common/StdDefs.h>
+#include <utils/emissions/PHEMCEP.h>
+#include <utils/emissions/PHEMPatternIndex.h>
+
+
+// ===========================================================================
+// helper functions
+// ===========================================================================
+/// @brief builds a heavy duty CEP with an irregular power pattern
+static PHEMCEP*
+buildCEP(const std::vector<double>& pattern, const double ratedPower) {
+    std::vector<std::vector<double> > matrixFC;
+    std::vector<std::vector<double> > matrixPollutants;
+    for (const double p : pattern) {
+        matrixFC.push_back({p, p * p * 0.01 + 0.3 * p + 2.});
+        matrixPollutants.push_back({p, 0.5 * p + 1., fabs(p) * 0.02 + 0.1});
+    }
+    const std::vector<std::vector<double> > matrixSpeedRotational = {{0., 1.1, 1.}, {200., 1.1, 1.}};
+    const std::vector<std::vector<double> > normedDragTable = {{0., 0.}, {1., 0.1}};
+    return new PHEMCEP(true, 0, "test", 10000., 1000., 300., 8., 0.6, 0.007, 0., 0., 0., 0., ratedPower,
+                       0., 0., 0., 0., 4., 600., 2000., 1., 0.1, "D", matrixFC, {"NOx", "PM"},
+                       matrixPollutants, matrixSpeedRotational, normedDragTable, {0.1, 0.01});
+}
+
+
+/* Test that the indexed (absolute) emissions of a CEP match the bisection used for the normalized emissions */
+TEST(PHEMPatternIndex, test_accuracy_irregular) {
+    const std::vector<double> pattern = {-0.125, -0.03, -0.002, 0., 0.0005, 0.013, 0.079, 0.08, 0.31, 1.2};
+    const double ratedPower = 250.;
+    PHEMCEP* cep = buildCEP(pattern, ratedPower);
+    for (double p = pattern.front() + 0.0001; p < pattern.back(); p += 0.000137) {
+        for (const std::string pollutant : {"FC", "NOx", "PM"}) {
+            const double expected = ratedPower * cep->GetEmission(pollutant, p, 10., true);
+            EXPECT_NEAR(expected, cep->GetEmission(pollutant, p * ratedPower, 10.), 1e-9 * MAX2(1., fabs(expected)));
+        }
+    }
+    delete cep;
+}
+
+
+/* Test that pattern entries are found */
+TEST(PHEMPatternIndex, test_pattern_entries) {
+    std::vector<double> pattern = {0., 0.1, 0.2, 0.3, 0.5, 0.8, 1.3, 2.1};
+    PHEMPatternIndex index;
+    index.build(pattern);
+    for (int i = 1; i < (int)pattern.size() - 1; i++) {
+        EXPECT_EQ(i, index.findSegment(pattern, pattern[i]));
+    }
+}
+
+
+/* Test that an unsorted pattern is not indexed */
+TEST(PHEMPatternIndex, test_unsorted) {
+    std::vector<double> pattern = {0., 2., 1., 3.};
+    PHEMPatternIndex index;
+    index.build(pattern);
+    EXPECT_FALSE(index.isValid());
+    EXPECT_GT(index.getMemory(), 0);
+}
@@ -0,0 +1,59 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    PollutantsInterfaceTest.cpp
+/// @author  agent
+/// @date    2026-10-17
+///
+// Tests the class PollutantsInterface
+/****************************************************************************/
+#include <config.h>
+
+#include <gtest/gtest.h>
+#include <utils/common/StringUtils.h>
+#include <utils/emissions/PollutantsInterface.h>
+
+
+/* Test that computing all pollutants at once gives the same results as computing them separately */
+TEST(PollutantsInterface, test_method_computeAll) {
+    for (const SUMOEmissionClass c : PollutantsInterface::getAllClasses()) {
+        // the PHEMlight models need their data files
+        if (!StringUtils::startsWith(PollutantsInterface::getName(c), "HBEFA")) {
+            continue;
+        }
+        for (double v = 0.; v < 40.; v += 2.5) {
+            for (double a = -4.; a < 4.; a += 0.5) {
+                for (double slope = -3.; slope <= 3.; slope += 3.) {
+                    const PollutantsInterface::Emissions all = PollutantsInterface::computeAll(c, v, a, slope, nullptr);
+                    EXPECT_EQ(all.CO2, PollutantsInterface::compute(c, PollutantsInterface::CO2, v, a, slope, nullptr));
+                    EXPECT_EQ(all.CO, PollutantsInterface::compute(c, PollutantsInterface::CO, v, a, slope, nullptr));
+                    EXPECT_EQ(all.HC, PollutantsInterface::compute(c, PollutantsInterface::HC, v, a, slope, nullptr));
+                    EXPECT_EQ(all.fuel, PollutantsInterface::compute(c, PollutantsInterface::FUEL, v, a, slope, nullptr));
+                    EXPECT_EQ(all.NOx, PollutantsInterface::compute(c, PollutantsInterface::NO_X, v, a, slope, nullptr));
+                    EXPECT_EQ(all.PMx, PollutantsInterface::compute(c, PollutantsInterface::PM_X, v, a, slope, nullptr));
+                    EXPECT_EQ(all.electricity, PollutantsInterface::compute(c, PollutantsInterface::ELEC, v, a, slope, nullptr));
+                }
+            }
+        }
+    }
+}
+
+
+/* Test that computing all default pollutants at once gives the same results as computing them separately */
+TEST(PollutantsInterface, test_method_computeAllDefault) {
+    const SUMOEmissionClass c = PollutantsInterface::getClassByName("HBEFA3/PC_G_EU4");
+    const PollutantsInterface::Emissions all = PollutantsInterface::computeAllDefault(c, 13.9, 2.6, 0., 36., nullptr);
+    EXPECT_EQ(all.CO2, PollutantsInterface::computeDefault(c, PollutantsInterface::CO2, 13.9, 2.6, 0., 36., nullptr));
+    EXPECT_EQ(all.NOx, PollutantsInterface::computeDefault(c, PollutantsInterface::NO_X, 13.9, 2.6, 0., 36., nullptr));
+    EXPECT_EQ(all.fuel, PollutantsInterface::computeDefault(c, PollutantsInterface::FUEL, 13.9, 2.6, 0., 36., nullptr));
+}
@@ -0,0 +1,107 @@
+/****************************************************************************/
+// Eclipse SUMO, Simulation of Urban MObility; see https://eclipse.org/sumo
+// Copyright (C) 2026-2026 German Aerospace Center (DLR) and others.
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// https://www.eclipse.org/legal/epl-2.0/
+// This Source Code may also be made available under the following Secondary
+// Licenses when the conditions for such availability set forth in the Eclipse
+// Public License 2.0 are satisfied: GNU General Public License, version 2
+// or later which is available at
+// https://www.gnu.org/licenses/old-licenses/gpl-2.0-standalone.html
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+/****************************************************************************/
+/// @file    CircuitTest.cpp
+/// @author  agent
+/// @date    2026-10-17
+///
+// Tests the class Circuit
+/****************************************************************************/
+#include <config.h>
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <utils/common/ToString.h>
+#include <utils/traction_wire/Circuit.h>
+#include <utils/traction_wire/Element.h>
+#include <utils/traction_wire/Node.h>
+
+
+// ===========================================================================
+// helper functions
+// ===========================================================================
+/** @brief builds a trolleybus line fed by a substation at its begin and connected to the substation at every 50th node
+ * @return the current sources representing the trolleybuses (at every 10th node)
+ */
+static std::vector<Element*>
+buildLine(Circuit& circuit, int numNodes) {
+    Node* const ground = circuit.addNode("ground");
+    Node* const substation = circuit.addNode("substation");
+    circuit.addElement("source", 600, substation, ground, Element::ElementType::VOLTAGE_SOURCE_traction_wire);
+    std::vector<Element*> buses;
+    Node* prev = substation;
+    for (int i = 0; i < numNodes; i++) {
+        Node* const node = circuit.addNode("node" + toString(i));
+        circuit.addElement("wire" + toString(i), 0.01, prev, node, Element::ElementType::RESISTOR_traction_wire);
+        if (i % 10 == 5) {
+            buses.push_back(circuit.addElement("bus" + toString(i), NAN, node, ground, Element::ElementType::CURRENT_SOURCE_traction_wire));
+        }
+        if (i % 50 == 49) {
+            circuit.addElement("feeder" + toString(i), 0.02, node, substation, Element::ElementType::RESISTOR_traction_wire);
+        }
+        prev = node;
+    }
+    return buses;
+}
+
+
+// ===========================================================================
+// tests
+// ===========================================================================
+/* Test a single consumer behind a resistor against the analytic solution. */
+TEST(Circuit, test_single_consumer) {
+    Circuit circuit;
+    Node* const ground = circuit.addNode("ground");
+    Node* const substation = circuit.addNode("substation");
+    Node* const node = circuit.addNode("node");
+    circuit.addElement("source", 600, substation, ground, Element::ElementType::VOLTAGE_SOURCE_traction_wire);
+    circuit.addElement("wire", 0.1, substation, node, Element::ElementType::RESISTOR_traction_wire);
+    Element* const bus = circuit.addElement("bus", NAN, node, ground, Element::ElementType::CURRENT_SOURCE_traction_wire);
+    bus->setPowerWanted(100000);
+    EXPECT_TRUE(circuit.solve());
+    // U * (600 - U) / R = P
+    const double expected = (600 + sqrt(600 * 600 - 4 * 0.1 * 100000)) / 2;
+    EXPECT_NEAR(expected, circuit.getVoltage("node"), 1e-6);
+    EXPECT_DOUBLE_EQ(1, circuit.getAlphaBest());
+}
+
+
+/* Test repeated solving of a line with changing power demands (reusing the factorization). */
+TEST(Circuit, test_line_repeated_solve) {
+    Circuit circuit;
+    const std::vector<Element*> buses = buildLine(circuit, 500);
+    for (int step = 0; step < 3; step++) {
+        for (Element* const bus : buses) {
+            bus->setPowerWanted(40000 + 5000 * step);
+        }
+        EXPECT_TRUE(circuit.solve());
+        EXPECT_DOUBLE_EQ(1, circuit.getAlphaBest());
+        // the substation delivers the power of all buses and the losses
+        double busPower = 0;
+        for (Element* const bus : buses) {
+            EXPECT_LT(circuit.getVoltage(bus->getName()), 600);
+            busPower += bus->getPowerWanted();
+        }
+        // (the power of the source is negative since it is delivered)
+        EXPECT_GT(-circuit.getTotalPowerOfCircuitSources(), busPower);
+        EXPECT_LT(-circuit.getTotalPowerOfCircuitSources(), 1.1 * busPower);
+        // a fresh circuit gives the same solution
+        Circuit fresh;
+        const std::vector<Element*> freshBuses = buildLine(fresh, 500);
+        for (Element* const bus : freshBuses) {
+            bus->setPowerWanted(40000 + 5000 * step);
+        }
+        EXPECT_TRUE(fresh.solve());
+        EXPECT_NEAR(fresh.getVoltage("node499"), circuit.getVoltage("node499"), 1e-6);
+    }
+}